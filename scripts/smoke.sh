@@ -62,6 +62,11 @@ curl -sS -i -H "X-API-Key: $API_KEY" \
   "$BASE_URL/audit/encounters?from=$AUDIT_FROM_DATE_UTC&to=$AUDIT_TO_DATE_UTC" | sed -n '1,80p'
 echo
 
+echo "== Audit rollups (expect per-day counts) =="
+curl -sS -i -H "X-API-Key: $API_KEY" \
+  "$BASE_URL/audit/encounters/rollups?from=$AUDIT_FROM_DATE_UTC&to=$AUDIT_TO_DATE_UTC" | sed -n '1,40p'
+echo
+
 echo "== Validation error: bad date (expect 400) =="
 curl -sS -i \
   -H "Content-Type: application/json" \
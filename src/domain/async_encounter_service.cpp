@@ -0,0 +1,118 @@
+#include "src/domain/async_encounter_service.h"
+
+#include <utility>
+
+#include "src/domain/service_records.h"
+
+namespace encounter_service::domain {
+
+DefaultAsyncEncounterService::DefaultAsyncEncounterService(storage::AsyncEncounterRepository& encounterRepository,
+                                                           storage::AsyncAuditRepository& auditRepository,
+                                                           util::Clock& clock,
+                                                           util::IdGenerator& idGenerator,
+                                                           util::Executor& executor)
+    : encounterRepository_(encounterRepository),
+      auditRepository_(auditRepository),
+      clock_(clock),
+      idGenerator_(idGenerator),
+      executor_(executor) {}
+
+util::Task<ServiceResult<Encounter>> DefaultAsyncEncounterService::CreateEncounterAsync(CreateEncounterInput input,
+                                                                                      std::string actor) {
+    co_await util::Schedule(executor_);
+    if (auto unauthorized = CheckActor(actor)) {
+        co_return *std::move(unauthorized);
+    }
+
+    // Use a single timestamp so metadata and audit entries for the same creation stay consistent.
+    const auto now = clock_.Now();
+
+    auto encounter = NewEncounter(std::move(input), idGenerator_.NextId(), now, actor);
+    auto persisted = co_await encounterRepository_.CreateAsync(std::move(encounter));
+
+    // Audit entries are named locals rather than temporaries in the co_await expression: GCC 12
+    // destroys aggregate temporaries passed to an awaited coroutine twice.
+    auto audit = MakeAuditEntry(now, std::move(actor), AuditAction::CREATE_ENCOUNTER, persisted.encounterId);
+    co_await auditRepository_.AppendAsync(std::move(audit));
+
+    co_return std::move(persisted);
+}
+
+util::Task<ServiceResult<Encounter>> DefaultAsyncEncounterService::GetEncounterAsync(std::string id, std::string actor) {
+    co_await util::Schedule(executor_);
+    if (auto unauthorized = CheckActor(actor)) {
+        co_return *std::move(unauthorized);
+    }
+
+    auto found = co_await encounterRepository_.GetByIdAsync(std::move(id));
+    if (!found) {
+        co_return MakeError(DomainErrorCode::NotFound, "Encounter not found");
+    }
+
+    auto audit = MakeAuditEntry(clock_.Now(), std::move(actor), AuditAction::READ_ENCOUNTER, found->encounterId);
+    co_await auditRepository_.AppendAsync(std::move(audit));
+
+    co_return std::move(*found);
+}
+
+util::Task<ServiceResult<std::vector<std::optional<Encounter>>>> DefaultAsyncEncounterService::BatchGetEncountersAsync(
+    std::vector<std::string> ids,
+    std::string actor) {
+    co_await util::Schedule(executor_);
+    if (auto unauthorized = CheckActor(actor)) {
+        co_return *std::move(unauthorized);
+    }
+
+    auto found = co_await encounterRepository_.GetByIdsAsync(std::move(ids));
+
+    auto audit = BatchReadAudit(clock_.Now(), std::move(actor), found);
+    if (!audit.encounterIds.empty()) {
+        co_await auditRepository_.AppendBulkAsync(std::move(audit));
+    }
+
+    co_return std::move(found);
+}
+
+util::Task<ServiceResult<std::vector<Encounter>>> DefaultAsyncEncounterService::QueryEncountersAsync(
+    storage::EncounterQueryFilters filters,
+    std::string actor,
+    util::RequestContext context) {
+    co_await util::Schedule(executor_);
+    if (auto unauthorized = CheckActor(actor)) {
+        co_return *std::move(unauthorized);
+    }
+
+    // co_await is not allowed inside a handler, so the cancellation is captured and mapped after it.
+    std::vector<Encounter> encounters;
+    std::optional<util::RequestCancelled> cancelled;
+    try {
+        encounters = co_await encounterRepository_.QueryAsync(std::move(filters), std::move(context));
+    } catch (const util::RequestCancelled& error) {
+        cancelled = error;
+    }
+    if (cancelled) {
+        co_return CancelledError(*cancelled);
+    }
+    if (encounters.empty()) {
+        co_return std::move(encounters);
+    }
+
+    auto audit = ListAudit(clock_.Now(), std::move(actor), encounters);
+    co_await auditRepository_.AppendBulkAsync(std::move(audit));
+
+    co_return std::move(encounters);
+}
+
+util::Task<ServiceResult<std::vector<AuditEntry>>> DefaultAsyncEncounterService::QueryAuditAsync(
+    storage::AuditDateRange range) {
+    co_await util::Schedule(executor_);
+    co_return co_await auditRepository_.QueryAsync(std::move(range));
+}
+
+util::Task<ServiceResult<std::vector<AuditRollup>>> DefaultAsyncEncounterService::QueryAuditRollupsAsync(
+    storage::AuditDateRange range) {
+    co_await util::Schedule(executor_);
+    co_return co_await auditRepository_.QueryRollupsAsync(std::move(range));
+}
+
+}  // namespace encounter_service::domain
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "src/domain/audit_models.h"
+#include "src/domain/encounter_models.h"
+#include "src/domain/encounter_service.h"
+#include "src/storage/async_audit_repo.h"
+#include "src/storage/async_encounter_repo.h"
+#include "src/util/clock.h"
+#include "src/util/executor.h"
+#include "src/util/id_generator.h"
+#include "src/util/request_context.h"
+#include "src/util/task.h"
+
+namespace encounter_service::domain {
+
+// Coroutine-based counterpart of EncounterService. Operations suspend while storage or audit I/O
+// is outstanding instead of blocking the calling thread. Semantics (authorization, auditing,
+// errors) match EncounterService. Arguments are taken by value so they live in the coroutine frame.
+class AsyncEncounterService {
+public:
+    virtual ~AsyncEncounterService() = default;
+
+    virtual util::Task<ServiceResult<Encounter>> CreateEncounterAsync(CreateEncounterInput input, std::string actor) = 0;
+    virtual util::Task<ServiceResult<Encounter>> GetEncounterAsync(std::string id, std::string actor) = 0;
+    virtual util::Task<ServiceResult<std::vector<std::optional<Encounter>>>> BatchGetEncountersAsync(
+        std::vector<std::string> ids,
+        std::string actor) = 0;
+    virtual util::Task<ServiceResult<std::vector<Encounter>>> QueryEncountersAsync(storage::EncounterQueryFilters filters,
+                                                                                  std::string actor,
+                                                                                  util::RequestContext context) = 0;
+    virtual util::Task<ServiceResult<std::vector<AuditEntry>>> QueryAuditAsync(storage::AuditDateRange range) = 0;
+    virtual util::Task<ServiceResult<std::vector<AuditRollup>>> QueryAuditRollupsAsync(storage::AuditDateRange range) = 0;
+};
+
+class DefaultAsyncEncounterService final : public AsyncEncounterService {
+public:
+    // Borrows all dependencies for its lifetime. Each operation first resumes on `executor`, so
+    // callers choose where service work runs (InlineExecutor keeps it on the calling thread).
+    DefaultAsyncEncounterService(storage::AsyncEncounterRepository& encounterRepository,
+                                 storage::AsyncAuditRepository& auditRepository,
+                                 util::Clock& clock,
+                                 util::IdGenerator& idGenerator,
+                                 util::Executor& executor);
+
+    util::Task<ServiceResult<Encounter>> CreateEncounterAsync(CreateEncounterInput input, std::string actor) override;
+    util::Task<ServiceResult<Encounter>> GetEncounterAsync(std::string id, std::string actor) override;
+    util::Task<ServiceResult<std::vector<std::optional<Encounter>>>> BatchGetEncountersAsync(
+        std::vector<std::string> ids,
+        std::string actor) override;
+    util::Task<ServiceResult<std::vector<Encounter>>> QueryEncountersAsync(storage::EncounterQueryFilters filters,
+                                                                          std::string actor,
+                                                                          util::RequestContext context) override;
+    util::Task<ServiceResult<std::vector<AuditEntry>>> QueryAuditAsync(storage::AuditDateRange range) override;
+    util::Task<ServiceResult<std::vector<AuditRollup>>> QueryAuditRollupsAsync(storage::AuditDateRange range) override;
+
+private:
+    storage::AsyncEncounterRepository& encounterRepository_;
+    storage::AsyncAuditRepository& auditRepository_;
+    util::Clock& clock_;
+    util::IdGenerator& idGenerator_;
+    util::Executor& executor_;
+};
+
+}  // namespace encounter_service::domain
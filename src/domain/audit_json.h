@@ -0,0 +1,30 @@
+#pragma once
+
+#include <array>
+#include <string>
+
+#include "src/domain/audit_models.h"
+#include "src/util/json_writer.h"
+
+namespace encounter_service::domain {
+
+// Wire shape of one audit entry, `{"action":...,"actor":...,"encounterId":...,"timestamp":...}`,
+// shared by the HTTP writer and the mapped audit segments so the two cannot drift. `Entry` has
+// AuditEntry's `action`, `actor`, `encounterId` and `timestamp` members; the string members may be
+// util::EscapedJsonString when they were escaped ahead of time.
+template <typename Entry>
+inline constexpr std::array<util::JsonField<Entry>, 4> kAuditEntryJsonFields{{
+    {"\"action\":",
+     [](std::string& out, const Entry& e) { util::AppendJsonString(out, AuditActionName(e.action)); }},
+    {"\"actor\":", [](std::string& out, const Entry& e) { util::AppendJsonString(out, e.actor); }},
+    {"\"encounterId\":", [](std::string& out, const Entry& e) { util::AppendJsonString(out, e.encounterId); }},
+    {"\"timestamp\":", [](std::string& out, const Entry& e) { util::AppendJsonTimestamp(out, e.timestamp); }},
+}};
+static_assert(util::JsonKeysSorted(kAuditEntryJsonFields<AuditEntry>));
+
+template <typename Entry>
+void AppendAuditEntryJsonObject(std::string& out, const Entry& entry) {
+    util::AppendJsonObject(out, entry, kAuditEntryJsonFields<Entry>);
+}
+
+}  // namespace encounter_service::domain
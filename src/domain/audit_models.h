@@ -1,15 +1,32 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace encounter_service::domain {
 
 enum class AuditAction {
     READ_ENCOUNTER,
-    CREATE_ENCOUNTER
+    CREATE_ENCOUNTER,
+    // One list access covering every encounter returned by the query.
+    LIST_ENCOUNTERS
 };
 
+// Returns the wire name of `action` (for example `READ_ENCOUNTER`).
+inline const char* AuditActionName(AuditAction action) {
+    switch (action) {
+        case AuditAction::READ_ENCOUNTER:
+            return "READ_ENCOUNTER";
+        case AuditAction::CREATE_ENCOUNTER:
+            return "CREATE_ENCOUNTER";
+        case AuditAction::LIST_ENCOUNTERS:
+            return "LIST_ENCOUNTERS";
+    }
+    return "UNKNOWN";
+}
+
 struct AuditEntry {
     std::chrono::system_clock::time_point timestamp{};
     std::string actor;
@@ -17,4 +34,22 @@ struct AuditEntry {
     std::string encounterId;
 };
 
+// One access event that covers many encounters (a list query page or a batch read).
+// Stored as a single compact record and expanded to one AuditEntry per encounter on query.
+struct BulkAuditEntry {
+    std::chrono::system_clock::time_point timestamp{};
+    std::string actor;
+    AuditAction action{AuditAction::LIST_ENCOUNTERS};
+    std::vector<std::string> encounterIds;
+};
+
+// Number of audit entries recorded for one (UTC day, actor, action) key.
+struct AuditRollup {
+    // Midnight UTC of the day the entries were recorded.
+    std::chrono::system_clock::time_point day{};
+    std::string actor;
+    AuditAction action{AuditAction::READ_ENCOUNTER};
+    std::uint64_t count{0};
+};
+
 }  // namespace encounter_service::domain
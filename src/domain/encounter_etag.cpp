@@ -0,0 +1,54 @@
+#include "src/domain/encounter_etag.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "src/util/fnv1a.h"
+#include "src/util/json_dump.h"
+
+namespace encounter_service::domain {
+
+namespace {
+
+// Length-prefixed so adjacent fields cannot trade bytes and still collide.
+void HashField(util::Fnv1a64& hash, std::string_view value) {
+    hash.Update(static_cast<std::uint64_t>(value.size()));
+    hash.Update(value);
+}
+
+void HashField(util::Fnv1a64& hash, std::chrono::system_clock::time_point value) {
+    hash.Update(static_cast<std::uint64_t>(value.time_since_epoch().count()));
+}
+
+// Hashes the serialized form as it is produced, without building the string.
+void HashJson(util::Fnv1a64& hash, const nlohmann::json& value) {
+    util::StreamJsonDump(value, [&hash](const char* data, std::size_t size) { hash.Update(data, size); });
+}
+
+}  // namespace
+
+std::string ComputeEncounterEtag(const Encounter& encounter) {
+    util::Fnv1a64 hash;
+    HashField(hash, encounter.encounterId);
+    HashField(hash, encounter.patientId);
+    HashField(hash, encounter.providerId);
+    HashField(hash, encounter.encounterDate);
+    HashField(hash, encounter.encounterType);
+    HashJson(hash, encounter.clinicalData);
+    HashField(hash, encounter.metadata.createdAt);
+    HashField(hash, encounter.metadata.updatedAt);
+    HashField(hash, encounter.metadata.createdBy);
+
+    static constexpr char kHex[] = "0123456789abcdef";
+    std::string etag(18, '"');
+    auto digest = hash.digest();
+    for (std::size_t i = 16; i > 0; --i) {
+        etag[i] = kHex[digest & 0x0f];
+        digest >>= 4;
+    }
+    return etag;
+}
+
+}  // namespace encounter_service::domain
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <string>
+
+#include "src/domain/encounter_models.h"
+
+namespace encounter_service::domain {
+
+// Returns a strong HTTP entity tag (`"` + 16 hex digits + `"`) for `encounter`: a 64-bit FNV-1a
+// hash over every field of its JSON representation. Encounters never change once created, so the
+// tag is computed once by CreateEncounter() and stored in `Encounter::etag`. clinicalData is hashed
+// as it is serialized, without materializing its text.
+[[nodiscard]] std::string ComputeEncounterEtag(const Encounter& encounter);
+
+}  // namespace encounter_service::domain
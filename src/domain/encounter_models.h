@@ -22,6 +22,9 @@ struct Encounter {
     // User-provided clinical payload; treat as potentially PHI-bearing.
     nlohmann::json clinicalData;
     EncounterMetadata metadata;
+    // Strong HTTP entity tag over the fields above, assigned once at creation (ComputeEncounterEtag).
+    // Not part of the JSON representation.
+    std::string etag;
 };
 
 }  // namespace encounter_service::domain
@@ -1,18 +1,10 @@
 #include "src/domain/encounter_service.h"
 
-namespace encounter_service::domain {
-
-namespace {
+#include <utility>
 
-DomainError MakeError(DomainErrorCode code, std::string message) {
-    return DomainError{
-        .code = code,
-        .message = std::move(message),
-        .details = std::nullopt
-    };
-}
+#include "src/domain/service_records.h"
 
-}  // namespace
+namespace encounter_service::domain {
 
 DefaultEncounterService::DefaultEncounterService(storage::EncounterRepository& encounterRepository,
                                                  storage::AuditRepository& auditRepository,
@@ -23,43 +15,24 @@ DefaultEncounterService::DefaultEncounterService(storage::EncounterRepository& e
       clock_(clock),
       idGenerator_(idGenerator) {}
 
-ServiceResult<Encounter> DefaultEncounterService::CreateEncounter(const CreateEncounterInput& input, const std::string& actor) {
-    if (actor.empty()) {
-        return MakeError(DomainErrorCode::Unauthorized, "Unauthorized");
+ServiceResult<Encounter> DefaultEncounterService::CreateEncounter(CreateEncounterInput input, const std::string& actor) {
+    if (auto unauthorized = CheckActor(actor)) {
+        return *std::move(unauthorized);
     }
 
     // Use a single timestamp so metadata and audit entries for the same creation stay consistent.
     const auto now = clock_.Now();
 
-    const Encounter encounter{
-        .encounterId = idGenerator_.NextId(),
-        .patientId = input.patientId,
-        .providerId = input.providerId,
-        .encounterDate = input.encounterDate,
-        .encounterType = input.encounterType,
-        .clinicalData = input.clinicalData,
-        .metadata = EncounterMetadata{
-            .createdAt = now,
-            .updatedAt = now,
-            .createdBy = actor
-        }
-    };
-
-    auto persisted = encounterRepository_.Create(encounter);
-
-    auditRepository_.Append(AuditEntry{
-        .timestamp = now,
-        .actor = actor,
-        .action = AuditAction::CREATE_ENCOUNTER,
-        .encounterId = persisted.encounterId
-    });
+    auto persisted = encounterRepository_.Create(NewEncounter(std::move(input), idGenerator_.NextId(), now, actor));
+
+    auditRepository_.Append(MakeAuditEntry(now, actor, AuditAction::CREATE_ENCOUNTER, persisted.encounterId));
 
     return persisted;
 }
 
 ServiceResult<Encounter> DefaultEncounterService::GetEncounter(const std::string& id, const std::string& actor) {
-    if (actor.empty()) {
-        return MakeError(DomainErrorCode::Unauthorized, "Unauthorized");
+    if (auto unauthorized = CheckActor(actor)) {
+        return *std::move(unauthorized);
     }
 
     auto found = encounterRepository_.GetById(id);
@@ -67,22 +40,62 @@ ServiceResult<Encounter> DefaultEncounterService::GetEncounter(const std::string
         return MakeError(DomainErrorCode::NotFound, "Encounter not found");
     }
 
-    auditRepository_.Append(AuditEntry{
-        .timestamp = clock_.Now(),
-        .actor = actor,
-        .action = AuditAction::READ_ENCOUNTER,
-        .encounterId = found->encounterId
-    });
+    auditRepository_.Append(MakeAuditEntry(clock_.Now(), actor, AuditAction::READ_ENCOUNTER, found->encounterId));
 
     return *found;
 }
 
-ServiceResult<std::vector<Encounter>> DefaultEncounterService::QueryEncounters(const storage::EncounterQueryFilters& filters) {
-    return encounterRepository_.Query(filters);
+ServiceResult<std::vector<std::optional<Encounter>>> DefaultEncounterService::BatchGetEncounters(
+    const std::vector<std::string>& ids,
+    const std::string& actor) {
+    if (auto unauthorized = CheckActor(actor)) {
+        return *std::move(unauthorized);
+    }
+
+    auto found = encounterRepository_.GetByIds(ids);
+
+    // Each encounter read in the batch is audited, but through one record for the whole request.
+    const auto audit = BatchReadAudit(clock_.Now(), actor, found);
+    if (!audit.encounterIds.empty()) {
+        auditRepository_.AppendBulk(audit);
+    }
+
+    return found;
+}
+
+ServiceResult<storage::SharedEncounters> DefaultEncounterService::QueryEncounters(
+    const storage::EncounterQueryFilters& filters,
+    const std::string& actor,
+    const util::RequestContext& context) {
+    if (auto unauthorized = CheckActor(actor)) {
+        return *std::move(unauthorized);
+    }
+
+    storage::SharedEncounters encounters;
+    try {
+        encounters = encounterRepository_.QueryShared(filters, context);
+    } catch (const util::RequestCancelled& cancelled) {
+        return CancelledError(cancelled);
+    }
+    if (encounters->empty()) {
+        return encounters;
+    }
+
+    auditRepository_.AppendBulk(ListAudit(clock_.Now(), actor, *encounters));
+
+    return encounters;
 }
 
 ServiceResult<std::vector<AuditEntry>> DefaultEncounterService::QueryAudit(const storage::AuditDateRange& range) {
     return auditRepository_.Query(range);
 }
 
+ServiceResult<std::vector<AuditRollup>> DefaultEncounterService::QueryAuditRollups(const storage::AuditDateRange& range) {
+    return auditRepository_.QueryRollups(range);
+}
+
+std::uint64_t DefaultEncounterService::EncounterWriteGeneration() const {
+    return encounterRepository_.WriteGeneration();
+}
+
 }  // namespace encounter_service::domain
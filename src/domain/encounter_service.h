@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+#include <optional>
 #include <string>
 #include <variant>
 #include <vector>
@@ -11,6 +13,7 @@
 #include "src/storage/encounter_repo.h"
 #include "src/util/clock.h"
 #include "src/util/id_generator.h"
+#include "src/util/request_context.h"
 
 namespace encounter_service::domain {
 
@@ -29,14 +32,29 @@ class EncounterService {
 public:
     virtual ~EncounterService() = default;
 
-    // Creates an encounter from validated input for `actor`.
-    virtual ServiceResult<Encounter> CreateEncounter(const CreateEncounterInput& input, const std::string& actor) = 0;
+    // Creates an encounter from validated input for `actor`. `input` is a sink: callers that no
+    // longer need it should move it in so `clinicalData` is transferred rather than copied.
+    virtual ServiceResult<Encounter> CreateEncounter(CreateEncounterInput input, const std::string& actor) = 0;
     // Returns the encounter identified by `id` and records actor read access on success.
     virtual ServiceResult<Encounter> GetEncounter(const std::string& id, const std::string& actor) = 0;
-    // Returns encounters matching `filters`.
-    virtual ServiceResult<std::vector<Encounter>> QueryEncounters(const storage::EncounterQueryFilters& filters) = 0;
+    // Returns one slot per ID in `ids`, in request order, with std::nullopt for unknown IDs.
+    // Records a single bulk read-access audit entry for `actor` covering every encounter found.
+    virtual ServiceResult<std::vector<std::optional<Encounter>>> BatchGetEncounters(const std::vector<std::string>& ids,
+                                                                                   const std::string& actor) = 0;
+    // Returns encounters matching `filters` and records one bulk list-access audit entry for `actor`
+    // covering every returned encounter. Returns DeadlineExceeded, without auditing, when `context`
+    // expires or is cancelled before the scan completes. The rows may be shared with a query cache
+    // and must not be modified.
+    virtual ServiceResult<storage::SharedEncounters> QueryEncounters(const storage::EncounterQueryFilters& filters,
+                                                                     const std::string& actor,
+                                                                     const util::RequestContext& context) = 0;
     // Returns audit entries matching `range`.
     virtual ServiceResult<std::vector<AuditEntry>> QueryAudit(const storage::AuditDateRange& range) = 0;
+    // Returns per-day (actor, action) audit counts for UTC days overlapping `range`.
+    virtual ServiceResult<std::vector<AuditRollup>> QueryAuditRollups(const storage::AuditDateRange& range) = 0;
+    // Returns the encounter repository's write generation. Read before QueryEncounters(), it
+    // identifies a version of the results (see storage::EncounterRepository::WriteGeneration()).
+    [[nodiscard]] virtual std::uint64_t EncounterWriteGeneration() const = 0;
 };
 
 class DefaultEncounterService final : public EncounterService {
@@ -47,10 +65,16 @@ public:
                             util::Clock& clock,
                             util::IdGenerator& idGenerator);
 
-    ServiceResult<Encounter> CreateEncounter(const CreateEncounterInput& input, const std::string& actor) override;
+    ServiceResult<Encounter> CreateEncounter(CreateEncounterInput input, const std::string& actor) override;
     ServiceResult<Encounter> GetEncounter(const std::string& id, const std::string& actor) override;
-    ServiceResult<std::vector<Encounter>> QueryEncounters(const storage::EncounterQueryFilters& filters) override;
+    ServiceResult<std::vector<std::optional<Encounter>>> BatchGetEncounters(const std::vector<std::string>& ids,
+                                                                           const std::string& actor) override;
+    ServiceResult<storage::SharedEncounters> QueryEncounters(const storage::EncounterQueryFilters& filters,
+                                                             const std::string& actor,
+                                                             const util::RequestContext& context) override;
     ServiceResult<std::vector<AuditEntry>> QueryAudit(const storage::AuditDateRange& range) override;
+    ServiceResult<std::vector<AuditRollup>> QueryAuditRollups(const storage::AuditDateRange& range) override;
+    std::uint64_t EncounterWriteGeneration() const override;
 
 private:
     storage::EncounterRepository& encounterRepository_;
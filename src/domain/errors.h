@@ -15,7 +15,15 @@ enum class DomainErrorCode {
     Validation,
     NotFound,
     Unauthorized,
-    Internal
+    Internal,
+    // The request was shed under load and may be retried later.
+    Unavailable,
+    // The caller exceeded its request budget and may retry later.
+    RateLimited,
+    // The request's deadline passed, or it was cancelled, before the work completed.
+    DeadlineExceeded,
+    // The request body exceeds the size accepted for the route.
+    PayloadTooLarge
 };
 
 struct DomainError {
@@ -0,0 +1,101 @@
+#include "src/domain/service_records.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "src/domain/encounter_etag.h"
+
+namespace encounter_service::domain {
+
+DomainError MakeError(DomainErrorCode code, std::string message) {
+    return DomainError{
+        .code = code,
+        .message = std::move(message),
+        .details = std::nullopt
+    };
+}
+
+DomainError CancelledError(const util::RequestCancelled& cancelled) {
+    return MakeError(DomainErrorCode::DeadlineExceeded,
+                     cancelled.reason() == util::RequestCancelled::Reason::DeadlineExceeded ? "Request deadline exceeded"
+                                                                                           : "Request cancelled");
+}
+
+std::optional<DomainError> CheckActor(const std::string& actor) {
+    if (actor.empty()) {
+        return MakeError(DomainErrorCode::Unauthorized, "Unauthorized");
+    }
+    return std::nullopt;
+}
+
+Encounter NewEncounter(CreateEncounterInput input,
+                       std::string encounterId,
+                       std::chrono::system_clock::time_point now,
+                       const std::string& actor) {
+    Encounter encounter{
+        .encounterId = std::move(encounterId),
+        .patientId = std::move(input.patientId),
+        .providerId = std::move(input.providerId),
+        .encounterDate = input.encounterDate,
+        .encounterType = std::move(input.encounterType),
+        .clinicalData = std::move(input.clinicalData),
+        .metadata = EncounterMetadata{
+            .createdAt = now,
+            .updatedAt = now,
+            .createdBy = actor
+        },
+        .etag = {}
+    };
+    encounter.etag = ComputeEncounterEtag(encounter);
+    return encounter;
+}
+
+AuditEntry MakeAuditEntry(std::chrono::system_clock::time_point now,
+                          std::string actor,
+                          AuditAction action,
+                          std::string encounterId) {
+    return AuditEntry{
+        .timestamp = now,
+        .actor = std::move(actor),
+        .action = action,
+        .encounterId = std::move(encounterId)
+    };
+}
+
+BulkAuditEntry BatchReadAudit(std::chrono::system_clock::time_point now,
+                              std::string actor,
+                              const std::vector<std::optional<Encounter>>& found) {
+    BulkAuditEntry audit{
+        .timestamp = now,
+        .actor = std::move(actor),
+        .action = AuditAction::READ_ENCOUNTER,
+        .encounterIds = {}
+    };
+    for (const auto& encounter : found) {
+        if (encounter) {
+            audit.encounterIds.push_back(encounter->encounterId);
+        }
+    }
+    std::sort(audit.encounterIds.begin(), audit.encounterIds.end());
+    audit.encounterIds.erase(std::unique(audit.encounterIds.begin(), audit.encounterIds.end()),
+                             audit.encounterIds.end());
+    return audit;
+}
+
+BulkAuditEntry ListAudit(std::chrono::system_clock::time_point now,
+                         std::string actor,
+                         const std::vector<Encounter>& encounters) {
+    BulkAuditEntry audit{
+        .timestamp = now,
+        .actor = std::move(actor),
+        .action = AuditAction::LIST_ENCOUNTERS,
+        .encounterIds = {}
+    };
+    audit.encounterIds.reserve(encounters.size());
+    for (const auto& encounter : encounters) {
+        audit.encounterIds.push_back(encounter.encounterId);
+    }
+    return audit;
+}
+
+}  // namespace encounter_service::domain
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "src/domain/audit_models.h"
+#include "src/domain/encounter_service.h"
+#include "src/domain/errors.h"
+#include "src/util/request_context.h"
+
+namespace encounter_service::domain {
+
+// Validation, errors and audit records shared by DefaultEncounterService and
+// DefaultAsyncEncounterService, so both services record exactly the same thing for a request.
+
+[[nodiscard]] DomainError MakeError(DomainErrorCode code, std::string message);
+// Maps a cancelled or timed-out request to DeadlineExceeded.
+[[nodiscard]] DomainError CancelledError(const util::RequestCancelled& cancelled);
+// Returns Unauthorized when no actor was authenticated.
+[[nodiscard]] std::optional<DomainError> CheckActor(const std::string& actor);
+
+// Builds a new encounter created by `actor` at `now`, with its entity tag computed.
+[[nodiscard]] Encounter NewEncounter(CreateEncounterInput input,
+                                     std::string encounterId,
+                                     std::chrono::system_clock::time_point now,
+                                     const std::string& actor);
+
+[[nodiscard]] AuditEntry MakeAuditEntry(std::chrono::system_clock::time_point now,
+                                        std::string actor,
+                                        AuditAction action,
+                                        std::string encounterId);
+// One READ_ENCOUNTER record for every distinct encounter found by a batch read; `encounterIds` is
+// empty when nothing was found and nothing should be recorded.
+[[nodiscard]] BulkAuditEntry BatchReadAudit(std::chrono::system_clock::time_point now,
+                                            std::string actor,
+                                            const std::vector<std::optional<Encounter>>& found);
+// One LIST_ENCOUNTERS record covering a whole page, so list auditing does not scale with page size.
+[[nodiscard]] BulkAuditEntry ListAudit(std::chrono::system_clock::time_point now,
+                                       std::string actor,
+                                       const std::vector<Encounter>& encounters);
+
+}  // namespace encounter_service::domain
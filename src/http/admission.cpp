@@ -0,0 +1,96 @@
+#include "src/http/admission.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace encounter_service::http {
+
+AdaptiveConcurrencyLimiter::AdaptiveConcurrencyLimiter(ConcurrencyLimitOptions options)
+    : options_(options),
+      limit_(std::clamp(options.initialLimit, options.minLimit, options.maxLimit)) {}
+
+bool AdaptiveConcurrencyLimiter::TryAcquire() {
+    std::unique_lock lock(mutex_);
+    const auto hasSlot = [&]() { return static_cast<double>(inFlight_) + 1.0 <= limit_; };
+
+    // Queued callers go first; a newcomer only skips the queue when nobody is waiting.
+    if (queued_ == 0 && hasSlot()) {
+        ++inFlight_;
+        ++admitted_;
+        return true;
+    }
+    if (queued_ >= options_.maxQueue) {
+        ++shed_;
+        return false;
+    }
+
+    ++queued_;
+    const bool granted = slotFreed_.wait_for(lock, options_.maxQueueWait, hasSlot);
+    --queued_;
+    if (!granted) {
+        ++shed_;
+        return false;
+    }
+    ++inFlight_;
+    ++admitted_;
+    return true;
+}
+
+void AdaptiveConcurrencyLimiter::Release(std::chrono::steady_clock::duration latency) {
+    {
+        std::lock_guard lock(mutex_);
+        --inFlight_;
+        if (latency > options_.targetLatency) {
+            limit_ = std::max(options_.minLimit, limit_ * options_.backoffRatio);
+        } else {
+            limit_ = std::min(options_.maxLimit, limit_ + 1.0 / limit_);
+        }
+    }
+    slotFreed_.notify_one();
+}
+
+ConcurrencyLimitStats AdaptiveConcurrencyLimiter::stats() const {
+    std::lock_guard lock(mutex_);
+    return ConcurrencyLimitStats{
+        .limit = limit_,
+        .inFlight = inFlight_,
+        .queued = queued_,
+        .admitted = admitted_,
+        .shed = shed_,
+    };
+}
+
+AdmissionTicket::AdmissionTicket(AdaptiveConcurrencyLimiter* limiter, std::chrono::steady_clock::time_point admittedAt)
+    : limiter_(limiter),
+      admittedAt_(admittedAt) {}
+
+AdmissionTicket::AdmissionTicket(AdmissionTicket&& other) noexcept
+    : limiter_(std::exchange(other.limiter_, nullptr)),
+      admittedAt_(other.admittedAt_) {}
+
+AdmissionTicket::~AdmissionTicket() {
+    if (limiter_ != nullptr) {
+        limiter_->Release(std::chrono::steady_clock::now() - admittedAt_);
+    }
+}
+
+AdmissionController::AdmissionController(AdmissionOptions options)
+    : retryAfter_(options.retryAfter) {
+    for (std::size_t i = 0; i < kRouteClassCount; ++i) {
+        limiters_[i].emplace(options.limits[i]);
+    }
+}
+
+std::optional<AdmissionTicket> AdmissionController::TryAdmit(RouteClass routeClass) {
+    auto& limiter = *limiters_[static_cast<std::size_t>(routeClass)];
+    if (!limiter.TryAcquire()) {
+        return std::nullopt;
+    }
+    return AdmissionTicket(&limiter, std::chrono::steady_clock::now());
+}
+
+ConcurrencyLimitStats AdmissionController::stats(RouteClass routeClass) const {
+    return limiters_[static_cast<std::size_t>(routeClass)]->stats();
+}
+
+}  // namespace encounter_service::http
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+#include "src/http/route_class.h"
+
+namespace encounter_service::http {
+
+struct ConcurrencyLimitOptions {
+    double initialLimit{32.0};
+    double minLimit{1.0};
+    double maxLimit{256.0};
+    // Requests allowed to wait for a slot once the limit is reached; further requests are shed.
+    std::size_t maxQueue{64};
+    // Longest a queued request waits for a slot before it is shed.
+    std::chrono::milliseconds maxQueueWait{50};
+    // Completions slower than this shrink the limit; faster ones grow it.
+    std::chrono::milliseconds targetLatency{100};
+    // Multiplicative decrease applied per slow completion.
+    double backoffRatio{0.9};
+};
+
+struct ConcurrencyLimitStats {
+    double limit{0};
+    std::size_t inFlight{0};
+    std::size_t queued{0};
+    std::uint64_t admitted{0};
+    std::uint64_t shed{0};
+};
+
+// AIMD concurrency limit: each completion within `targetLatency` adds 1/limit (about +1 per
+// limit's worth of completions), each slower completion multiplies the limit by `backoffRatio`.
+// Callers over the limit wait in a bounded queue until a slot frees up or their deadline passes.
+class AdaptiveConcurrencyLimiter {
+public:
+    explicit AdaptiveConcurrencyLimiter(ConcurrencyLimitOptions options = {});
+
+    AdaptiveConcurrencyLimiter(const AdaptiveConcurrencyLimiter&) = delete;
+    AdaptiveConcurrencyLimiter& operator=(const AdaptiveConcurrencyLimiter&) = delete;
+
+    // Returns true once a slot is held; false when the queue is full or the wait deadline passed.
+    [[nodiscard]] bool TryAcquire();
+    // Frees a slot taken by TryAcquire() and feeds the observed latency into the limit.
+    void Release(std::chrono::steady_clock::duration latency);
+
+    [[nodiscard]] ConcurrencyLimitStats stats() const;
+
+private:
+    ConcurrencyLimitOptions options_;
+    mutable std::mutex mutex_;
+    std::condition_variable slotFreed_;
+    double limit_{0};
+    std::size_t inFlight_{0};
+    std::size_t queued_{0};
+    std::uint64_t admitted_{0};
+    std::uint64_t shed_{0};
+};
+
+class AdmissionController;
+
+// Holds one admitted slot and releases it, with the measured latency, when destroyed.
+class AdmissionTicket {
+public:
+    // A ticket that holds no slot, for callers running without admission control.
+    AdmissionTicket() = default;
+    AdmissionTicket(AdmissionTicket&& other) noexcept;
+    AdmissionTicket& operator=(AdmissionTicket&&) = delete;
+    AdmissionTicket(const AdmissionTicket&) = delete;
+    AdmissionTicket& operator=(const AdmissionTicket&) = delete;
+    ~AdmissionTicket();
+
+private:
+    friend class AdmissionController;
+    AdmissionTicket(AdaptiveConcurrencyLimiter* limiter, std::chrono::steady_clock::time_point admittedAt);
+
+    AdaptiveConcurrencyLimiter* limiter_{nullptr};
+    std::chrono::steady_clock::time_point admittedAt_{};
+};
+
+struct AdmissionOptions {
+    // Indexed by RouteClass.
+    std::array<ConcurrencyLimitOptions, kRouteClassCount> limits{};
+    // Value of the `Retry-After` header (seconds) on shed responses.
+    std::chrono::seconds retryAfter{1};
+};
+
+// One adaptive limiter per RouteClass. Routes acquire a ticket before running their handler and
+// answer 503 with `Retry-After` when none is granted.
+class AdmissionController {
+public:
+    explicit AdmissionController(AdmissionOptions options = {});
+
+    // Returns a ticket when the request may proceed, or std::nullopt when it should be shed.
+    [[nodiscard]] std::optional<AdmissionTicket> TryAdmit(RouteClass routeClass);
+
+    [[nodiscard]] std::chrono::seconds retryAfter() const { return retryAfter_; }
+    [[nodiscard]] ConcurrencyLimitStats stats(RouteClass routeClass) const;
+
+private:
+    std::array<std::optional<AdaptiveConcurrencyLimiter>, kRouteClassCount> limiters_;
+    std::chrono::seconds retryAfter_;
+};
+
+}  // namespace encounter_service::http
@@ -1,5 +1,9 @@
 #include "src/http/auth.h"
 
+#include <cstdio>
+
+#include "src/util/fnv1a.h"
+
 namespace encounter_service::http {
 
 std::variant<std::string, domain::DomainError> Authenticate(const httplib::Request& request) {
@@ -24,4 +28,12 @@ std::variant<std::string, domain::DomainError> Authenticate(const httplib::Reque
     return std::string("api-key-actor");
 }
 
+std::string RateLimitKey(const httplib::Request& request) {
+    util::Fnv1a64 hash;
+    hash.Update(request.get_header_value("X-API-Key"));
+    char buffer[21];
+    std::snprintf(buffer, sizeof(buffer), "key-%016llx", static_cast<unsigned long long>(hash.digest()));
+    return buffer;
+}
+
 }  // namespace encounter_service::http
@@ -12,4 +12,11 @@ namespace encounter_service::http {
 // Returns an actor identifier on success or a safe Unauthorized DomainError on failure.
 std::variant<std::string, domain::DomainError> Authenticate(const httplib::Request& request);
 
+// Returns the identity rate limits are charged to: `key-` plus a 64-bit FNV-1a hash of the presented
+// `X-API-Key`. Authenticate() maps every key to the same demo actor, so keying buckets on that actor
+// would make all clients share one budget; hashing keeps raw keys out of the limiter's memory.
+// Since any non-empty key authenticates, a client that rotates keys gets a fresh bucket each time:
+// this only limits well-behaved clients. Switch to the authenticated actor once real key lookup exists.
+std::string RateLimitKey(const httplib::Request& request);
+
 }  // namespace encounter_service::http
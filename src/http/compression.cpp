@@ -0,0 +1,192 @@
+#include "src/http/compression.h"
+
+#include <algorithm>
+#include <cctype>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+#include <zlib.h>
+
+namespace encounter_service::http {
+
+namespace {
+
+// windowBits 15 plus 16 selects the gzip wrapper instead of zlib's.
+constexpr int kGzipWindowBits = 15 + 16;
+constexpr int kMemLevel = 8;
+// Output reserved per deflate() call while streaming.
+constexpr std::size_t kDeflateChunkBytes = 16 * 1024;
+
+std::string_view Trim(std::string_view value) {
+    while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) {
+        value.remove_prefix(1);
+    }
+    while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) {
+        value.remove_suffix(1);
+    }
+    return value;
+}
+
+bool EqualsIgnoreCase(std::string_view a, std::string_view b) {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+               return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+           });
+}
+
+// A q-value of zero (`0`, `0.`, `0.000`) means "not acceptable"; anything else, including a
+// malformed value, counts as acceptable.
+bool QualityIsZero(std::string_view params) {
+    while (!params.empty()) {
+        const auto semicolon = params.find(';');
+        const auto param = Trim(params.substr(0, semicolon));
+        params = semicolon == std::string_view::npos ? std::string_view{} : params.substr(semicolon + 1);
+        const auto equals = param.find('=');
+        if (equals == std::string_view::npos || !EqualsIgnoreCase(Trim(param.substr(0, equals)), "q")) {
+            continue;
+        }
+        const auto q = Trim(param.substr(equals + 1));
+        return !q.empty() && q.front() == '0' &&
+               q.find_first_not_of("0.", 1) == std::string_view::npos && std::count(q.begin(), q.end(), '.') <= 1;
+    }
+    return false;
+}
+
+}  // namespace
+
+bool AcceptsGzip(std::string_view acceptEncoding) {
+    std::optional<bool> gzip;
+    std::optional<bool> wildcard;
+    while (!acceptEncoding.empty()) {
+        const auto comma = acceptEncoding.find(',');
+        const auto item = acceptEncoding.substr(0, comma);
+        acceptEncoding = comma == std::string_view::npos ? std::string_view{} : acceptEncoding.substr(comma + 1);
+
+        const auto semicolon = item.find(';');
+        const auto coding = Trim(item.substr(0, semicolon));
+        const bool accepted =
+            semicolon == std::string_view::npos || !QualityIsZero(item.substr(semicolon + 1));
+        if (EqualsIgnoreCase(coding, "gzip") || EqualsIgnoreCase(coding, "x-gzip")) {
+            gzip = accepted;
+        } else if (coding == "*") {
+            wildcard = accepted;
+        }
+    }
+    return gzip.value_or(wildcard.value_or(false));
+}
+
+struct GzipEncoder::Stream {
+    z_stream z{};
+};
+
+GzipEncoder::GzipEncoder(int level)
+    : stream_(std::make_unique<Stream>()) {
+    if (deflateInit2(&stream_->z, level, Z_DEFLATED, kGzipWindowBits, kMemLevel, Z_DEFAULT_STRATEGY) != Z_OK) {
+        throw std::runtime_error("deflateInit2 failed");
+    }
+}
+
+GzipEncoder::~GzipEncoder() {
+    deflateEnd(&stream_->z);
+}
+
+void GzipEncoder::Write(std::string_view input, std::string& out) {
+    Deflate(input, false, out);
+}
+
+void GzipEncoder::Finish(std::string& out) {
+    Deflate({}, true, out);
+}
+
+void GzipEncoder::Deflate(std::string_view input, bool finish, std::string& out) {
+    auto& z = stream_->z;
+    // zlib never writes through next_in; the cast only satisfies its non-const API.
+    z.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    z.avail_in = static_cast<uInt>(input.size());
+    for (;;) {
+        const auto start = out.size();
+        out.resize(start + kDeflateChunkBytes);
+        z.next_out = reinterpret_cast<Bytef*>(out.data() + start);
+        z.avail_out = static_cast<uInt>(kDeflateChunkBytes);
+        const int ret = deflate(&z, finish ? Z_FINISH : Z_NO_FLUSH);
+        const bool full = z.avail_out == 0;
+        out.resize(start + kDeflateChunkBytes - z.avail_out);
+        if (ret == Z_STREAM_ERROR) {
+            throw std::runtime_error("deflate failed");
+        }
+        // A full output buffer may hide more pending output; otherwise all input was consumed.
+        if (finish ? ret == Z_STREAM_END : !full) {
+            return;
+        }
+    }
+}
+
+std::string GzipCompress(std::string_view input, int level) {
+    z_stream z{};
+    if (deflateInit2(&z, level, Z_DEFLATED, kGzipWindowBits, kMemLevel, Z_DEFAULT_STRATEGY) != Z_OK) {
+        throw std::runtime_error("deflateInit2 failed");
+    }
+    // deflateBound() covers the gzip wrapper, so one Z_FINISH call always completes.
+    std::string out(deflateBound(&z, static_cast<uLong>(input.size())), '\0');
+    z.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    z.avail_in = static_cast<uInt>(input.size());
+    z.next_out = reinterpret_cast<Bytef*>(out.data());
+    z.avail_out = static_cast<uInt>(out.size());
+    const int ret = deflate(&z, Z_FINISH);
+    out.resize(out.size() - z.avail_out);
+    deflateEnd(&z);
+    if (ret != Z_STREAM_END) {
+        throw std::runtime_error("deflate failed");
+    }
+    return out;
+}
+
+CompressedResponseCache::CompressedResponseCache(std::size_t maxBytes)
+    : maxBytes_(maxBytes) {}
+
+std::shared_ptr<const std::string> CompressedResponseCache::Find(const std::string& key) {
+    std::lock_guard lock(mutex_);
+    const auto it = index_.find(key);
+    if (it == index_.end()) {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return it->second->body;
+}
+
+void CompressedResponseCache::Insert(const std::string& key, std::shared_ptr<const std::string> body) {
+    if (!body || body->size() > maxBytes_) {
+        return;
+    }
+    std::lock_guard lock(mutex_);
+    if (const auto it = index_.find(key); it != index_.end()) {
+        bytes_ -= it->second->body->size();
+        lru_.erase(it->second);
+        index_.erase(it);
+    }
+    bytes_ += body->size();
+    lru_.push_front(Entry{.key = key, .body = std::move(body)});
+    index_.emplace(key, lru_.begin());
+    while (bytes_ > maxBytes_) {
+        auto& victim = lru_.back();
+        bytes_ -= victim.body->size();
+        index_.erase(victim.key);
+        lru_.pop_back();
+        evictions_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+CompressedResponseCacheStats CompressedResponseCache::stats() const {
+    std::lock_guard lock(mutex_);
+    return CompressedResponseCacheStats{
+        .hits = hits_.load(std::memory_order_relaxed),
+        .misses = misses_.load(std::memory_order_relaxed),
+        .evictions = evictions_.load(std::memory_order_relaxed),
+        .entries = lru_.size(),
+        .bytes = bytes_,
+    };
+}
+
+}  // namespace encounter_service::http
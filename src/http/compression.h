@@ -0,0 +1,94 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace encounter_service::http {
+
+struct CompressionOptions {
+    // zlib compression level, 1 (fastest) to 9 (smallest); 0 disables response compression.
+    int level{6};
+    // Bodies smaller than this are sent uncompressed; gzip framing and CPU do not pay off for them.
+    std::size_t minBytes{1024};
+};
+
+// Returns true when an `Accept-Encoding` header value admits gzip: `gzip` (or `x-gzip`) with a
+// non-zero q-value, or otherwise a `*` with a non-zero q-value. Tokens are case-insensitive.
+[[nodiscard]] bool AcceptsGzip(std::string_view acceptEncoding);
+
+// Incremental gzip encoder for streamed bodies. Write() appends whatever compressed output zlib
+// has ready; Finish() flushes the rest and the gzip trailer. Not thread-safe.
+class GzipEncoder {
+public:
+    // Throws std::runtime_error when zlib cannot be initialized at `level`.
+    explicit GzipEncoder(int level);
+    ~GzipEncoder();
+
+    GzipEncoder(const GzipEncoder&) = delete;
+    GzipEncoder& operator=(const GzipEncoder&) = delete;
+
+    void Write(std::string_view input, std::string& out);
+    void Finish(std::string& out);
+
+private:
+    struct Stream;
+    void Deflate(std::string_view input, bool finish, std::string& out);
+
+    std::unique_ptr<Stream> stream_;
+};
+
+// Gzip-encodes `input` in one pass into an output buffer sized by deflateBound().
+[[nodiscard]] std::string GzipCompress(std::string_view input, int level);
+
+struct CompressedResponseCacheStats {
+    std::uint64_t hits{0};
+    std::uint64_t misses{0};
+    std::uint64_t evictions{0};
+    std::size_t entries{0};
+    std::size_t bytes{0};
+};
+
+// Byte-bounded LRU of gzip-encoded bodies for responses that never change once created, such as
+// `GET /encounters/{id}` (encounters are immutable). Bodies are shared, so a hit copies nothing
+// under the lock. Thread-safe.
+class CompressedResponseCache {
+public:
+    explicit CompressedResponseCache(std::size_t maxBytes);
+
+    CompressedResponseCache(const CompressedResponseCache&) = delete;
+    CompressedResponseCache& operator=(const CompressedResponseCache&) = delete;
+
+    // Returns the cached body for `key` and marks it most recently used, or null on a miss.
+    [[nodiscard]] std::shared_ptr<const std::string> Find(const std::string& key);
+    // Caches `body` under `key`, evicting least recently used bodies to stay within the budget.
+    // Bodies larger than the whole budget are not cached.
+    void Insert(const std::string& key, std::shared_ptr<const std::string> body);
+
+    [[nodiscard]] CompressedResponseCacheStats stats() const;
+
+private:
+    struct Entry {
+        std::string key;
+        std::shared_ptr<const std::string> body;
+    };
+
+    std::size_t maxBytes_;
+    mutable std::mutex mutex_;
+    // Most recently used at the front.
+    std::list<Entry> lru_;
+    std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+    std::size_t bytes_{0};
+
+    std::atomic<std::uint64_t> hits_{0};
+    std::atomic<std::uint64_t> misses_{0};
+    std::atomic<std::uint64_t> evictions_{0};
+};
+
+}  // namespace encounter_service::http
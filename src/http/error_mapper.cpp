@@ -14,6 +14,14 @@ std::string CodeToString(domain::DomainErrorCode code) {
             return "unauthorized";
         case domain::DomainErrorCode::Internal:
             return "internal_error";
+        case domain::DomainErrorCode::Unavailable:
+            return "service_unavailable";
+        case domain::DomainErrorCode::RateLimited:
+            return "rate_limited";
+        case domain::DomainErrorCode::DeadlineExceeded:
+            return "deadline_exceeded";
+        case domain::DomainErrorCode::PayloadTooLarge:
+            return "payload_too_large";
     }
     return "internal_error";
 }
@@ -28,6 +36,14 @@ int StatusForCode(domain::DomainErrorCode code) {
             return 401;
         case domain::DomainErrorCode::Internal:
             return 500;
+        case domain::DomainErrorCode::Unavailable:
+            return 503;
+        case domain::DomainErrorCode::RateLimited:
+            return 429;
+        case domain::DomainErrorCode::DeadlineExceeded:
+            return 504;
+        case domain::DomainErrorCode::PayloadTooLarge:
+            return 413;
     }
     return 500;
 }
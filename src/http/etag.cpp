@@ -0,0 +1,78 @@
+#include "src/http/etag.h"
+
+#include <cstddef>
+
+namespace encounter_service::http {
+
+namespace {
+
+std::string_view OpaqueTag(std::string_view etag) {
+    if (etag.substr(0, 2) == "W/") {
+        etag.remove_prefix(2);
+    }
+    return etag;
+}
+
+void AppendHex(std::string& out, std::uint64_t value) {
+    static constexpr char kHex[] = "0123456789abcdef";
+    char digits[16];
+    std::size_t count = 0;
+    do {
+        digits[count++] = kHex[value & 0x0f];
+        value >>= 4;
+    } while (value != 0);
+    while (count > 0) {
+        out += digits[--count];
+    }
+}
+
+}  // namespace
+
+bool IfNoneMatchHits(std::string_view ifNoneMatch, std::string_view etag) {
+    const auto target = OpaqueTag(etag);
+    std::size_t pos = 0;
+    while (pos < ifNoneMatch.size()) {
+        const char ch = ifNoneMatch[pos];
+        if (ch == ' ' || ch == '\t' || ch == ',') {
+            ++pos;
+            continue;
+        }
+        if (ch == '*') {
+            return true;
+        }
+        if (ifNoneMatch.substr(pos, 2) == "W/") {
+            pos += 2;
+        }
+        if (pos >= ifNoneMatch.size() || ifNoneMatch[pos] != '"') {
+            return false;
+        }
+        const auto close = ifNoneMatch.find('"', pos + 1);
+        if (close == std::string_view::npos) {
+            return false;
+        }
+        if (ifNoneMatch.substr(pos, close + 1 - pos) == target) {
+            return true;
+        }
+        pos = close + 1;
+    }
+    return false;
+}
+
+std::string EncodedVariantEtag(std::string_view etag, std::string_view coding) {
+    std::string variant(etag.substr(0, etag.size() - 1));
+    variant += '-';
+    variant += coding;
+    variant += '"';
+    return variant;
+}
+
+std::string WeakGenerationEtag(std::uint64_t instance, std::uint64_t generation) {
+    std::string etag = "W/\"";
+    AppendHex(etag, instance);
+    etag += '-';
+    AppendHex(etag, generation);
+    etag += '"';
+    return etag;
+}
+
+}  // namespace encounter_service::http
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace encounter_service::http {
+
+// Returns true when `ifNoneMatch` (an `If-None-Match` header value) matches `etag` under the weak
+// comparison that header uses: `*` matches any current representation; otherwise any listed
+// entity-tag whose quoted part equals `etag`'s, ignoring `W/` prefixes. Malformed lists match nothing
+// past the first malformed entry.
+[[nodiscard]] bool IfNoneMatchHits(std::string_view ifNoneMatch, std::string_view etag);
+
+// Returns the strong tag for a content-coded variant of `etag`: `"abc"` with `gzip` is `"abc-gzip"`.
+// Strong validators must differ between encodings of the same resource.
+[[nodiscard]] std::string EncodedVariantEtag(std::string_view etag, std::string_view coding);
+
+// Returns the weak tag `W/"<instance>-<generation>"` for list results. `instance` distinguishes
+// server processes, whose in-memory generations restart from zero.
+[[nodiscard]] std::string WeakGenerationEtag(std::uint64_t instance, std::uint64_t generation);
+
+}  // namespace encounter_service::http
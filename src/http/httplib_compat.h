@@ -4,85 +4,572 @@
 #include "vendor/httplib.h"
 #else
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <forward_list>
 #include <functional>
 #include <cstring>
+#include <limits>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <regex>
 #include <map>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
-#if !defined(_WIN32)
+#if defined(__linux__)
 #include <arpa/inet.h>
 #include <netinet/in.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
 #include <sys/socket.h>
 #include <unistd.h>
 #endif
 
+// Worker threads running handlers for the fallback server; same knob and default as cpp-httplib.
+#ifndef CPPHTTPLIB_THREAD_POOL_COUNT
+#define CPPHTTPLIB_THREAD_POOL_COUNT \
+    ((std::max)(8u, std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() - 1 : 0))
+#endif
+
+// Persistent-connection limits for the fallback server; same knobs as cpp-httplib. The request
+// budget is higher than cpp-httplib's default so high-rate callers rarely reconnect.
+#ifndef CPPHTTPLIB_KEEPALIVE_TIMEOUT_SECOND
+#define CPPHTTPLIB_KEEPALIVE_TIMEOUT_SECOND 5
+#endif
+
+#ifndef CPPHTTPLIB_KEEPALIVE_MAX_COUNT
+#define CPPHTTPLIB_KEEPALIVE_MAX_COUNT 100
+#endif
+
+// Largest request body the fallback server accepts; same knob and default as cpp-httplib.
+#ifndef CPPHTTPLIB_PAYLOAD_MAX_LENGTH
+#define CPPHTTPLIB_PAYLOAD_MAX_LENGTH ((std::numeric_limits<std::size_t>::max)())
+#endif
+
 namespace httplib {
 
 namespace detail {
 
-inline std::string ascii_lower(std::string s) {
-    for (char& ch : s) {
-        ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+inline bool ascii_iequal(char a, char b) {
+    return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+}
+
+inline bool iequals(std::string_view a, std::string_view b) {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), ascii_iequal);
+}
+
+// Whether `haystack` contains `needle`, ignoring ASCII case.
+inline bool icontains(std::string_view haystack, std::string_view needle) {
+    return std::search(haystack.begin(), haystack.end(), needle.begin(), needle.end(), ascii_iequal) !=
+           haystack.end();
+}
+
+inline std::string_view trim(std::string_view value) {
+    while (!value.empty() && (value.front() == ' ' || value.front() == '\t' || value.front() == '\r')) {
+        value.remove_prefix(1);
     }
-    return s;
+    while (!value.empty() && (value.back() == ' ' || value.back() == '\t' || value.back() == '\r')) {
+        value.remove_suffix(1);
+    }
+    return value;
 }
 
+// Keeps the first N elements inline and moves to one contiguous heap block beyond that.
+template <typename T, std::size_t N>
+class SmallVector {
+public:
+    void push_back(const T& value) {
+        if (heap_.empty() && size_ < N) {
+            inline_[size_++] = value;
+            return;
+        }
+        if (heap_.empty()) {
+            heap_.reserve(N * 2);
+            heap_.assign(inline_.begin(), inline_.end());
+        }
+        heap_.push_back(value);
+        ++size_;
+    }
+
+    void clear() {
+        heap_.clear();
+        size_ = 0;
+    }
+
+    [[nodiscard]] std::size_t size() const { return size_; }
+    [[nodiscard]] bool empty() const { return size_ == 0; }
+    [[nodiscard]] const T* begin() const { return heap_.empty() ? inline_.data() : heap_.data(); }
+    [[nodiscard]] const T* end() const { return begin() + size_; }
+    [[nodiscard]] const T& operator[](std::size_t i) const { return begin()[i]; }
+
+private:
+    std::array<T, N> inline_{};
+    std::vector<T> heap_;
+    std::size_t size_{0};
+};
+
+// Name/value pairs held as views. The server's parser points them into its receive buffer;
+// emplace() copies into storage owned by the container for callers building requests by hand.
+class Fields {
+public:
+    using Field = std::pair<std::string_view, std::string_view>;
+
+    Fields() = default;
+    Fields(Fields&&) = default;
+    Fields& operator=(Fields&&) = default;
+    Fields(const Fields&) = delete;
+    Fields& operator=(const Fields&) = delete;
+
+    void emplace(std::string_view key, std::string_view value) {
+        const std::string_view owned_key = owned_.emplace_front(key);
+        emplace_view(owned_key, owned_.emplace_front(value));
+    }
+
+    // The referenced bytes must outlive the container.
+    void emplace_view(std::string_view key, std::string_view value) {
+        fields_.push_back(Field{key, value});
+    }
+
+    // First value stored under `key`, or nullptr.
+    [[nodiscard]] const std::string_view* find(std::string_view key, bool ignore_case) const {
+        for (const auto& field : fields_) {
+            if (ignore_case ? iequals(field.first, key) : field.first == key) {
+                return &field.second;
+            }
+        }
+        return nullptr;
+    }
+
+    [[nodiscard]] std::size_t size() const { return fields_.size(); }
+    [[nodiscard]] const Field* begin() const { return fields_.begin(); }
+    [[nodiscard]] const Field* end() const { return fields_.end(); }
+
+private:
+    SmallVector<Field, 16> fields_;
+    // Node-based so views into earlier entries survive later insertions and moves.
+    std::forward_list<std::string> owned_;
+};
+
 }  // namespace detail
 
 struct Request {
     struct Match {
-        std::string value;
+        std::string_view value;
 
         [[nodiscard]] std::string str() const {
-            return value;
+            return std::string(value);
         }
     };
 
-    std::map<std::string, std::string> headers;
-    std::string body;
-    std::string path;
-    std::map<std::string, std::string> params;
-    std::vector<Match> matches;
+    // Parsed requests view the server's receive buffer, which outlives the handler call.
+    std::string_view method;
+    std::string_view version;
+    std::string_view path;
+    std::string_view body;
+    // Names compare case-insensitively.
+    detail::Fields headers;
+    detail::Fields params;
+    detail::SmallVector<Match, 4> matches;
+    // Reports whether the client has hung up; mirrors newer cpp-httplib releases.
+    std::function<bool()> is_connection_closed = []() { return false; };
 
-    [[nodiscard]] bool has_header(const std::string& key) const {
-        return headers.find(detail::ascii_lower(key)) != headers.end();
+    [[nodiscard]] bool has_header(std::string_view key) const {
+        return headers.find(key, true) != nullptr;
     }
 
-    [[nodiscard]] std::string get_header_value(const std::string& key) const {
-        const auto it = headers.find(detail::ascii_lower(key));
-        return it == headers.end() ? std::string{} : it->second;
+    [[nodiscard]] std::string get_header_value(std::string_view key) const {
+        const auto* value = headers.find(key, true);
+        return value == nullptr ? std::string{} : std::string(*value);
     }
 
-    [[nodiscard]] bool has_param(const std::string& key) const {
-        return params.find(key) != params.end();
+    [[nodiscard]] bool has_param(std::string_view key) const {
+        return params.find(key, false) != nullptr;
     }
 
-    [[nodiscard]] std::string get_param_value(const std::string& key) const {
-        const auto it = params.find(key);
-        return it == params.end() ? std::string{} : it->second;
+    [[nodiscard]] std::string get_param_value(std::string_view key) const {
+        const auto* value = params.find(key, false);
+        return value == nullptr ? std::string{} : std::string(*value);
     }
 };
 
+namespace detail {
+
+inline void parse_query_string(std::string_view query, Fields& params) {
+    while (!query.empty()) {
+        const auto end = query.find('&');
+        const auto token = query.substr(0, end);
+        query.remove_prefix(end == std::string_view::npos ? query.size() : end + 1);
+        if (token.empty()) {
+            continue;
+        }
+        const auto eq = token.find('=');
+        if (eq == std::string_view::npos) {
+            params.emplace_view(token, {});
+        } else {
+            params.emplace_view(token.substr(0, eq), token.substr(eq + 1));
+        }
+    }
+}
+
+// Framing progress for the request at the front of a receive buffer, kept between reads so each
+// byte is searched for the end of the header block only once.
+struct RequestFrame {
+    // Bytes already searched for the blank line ending the header block.
+    std::size_t scanned{0};
+    // Set once the header block is complete: where it ends and where the body begins.
+    std::size_t header_end{0};
+    std::size_t body_start{0};
+    std::size_t content_length{0};
+    // Set instead of `content_length` when the request cannot be framed safely (see
+    // frame_body_length()): the status to answer before closing the connection.
+    int error_status{0};
+};
+
+// Reads the body length from the header block `head` into `frame`. Without a trustworthy length
+// the end of this request, and so the start of the next pipelined one, is unknown; such requests
+// set `frame.error_status` instead: 400 for a malformed `Content-Length` or duplicates that
+// disagree, 501 for any `Transfer-Encoding`, which this server does not decode.
+inline void frame_body_length(std::string_view head, RequestFrame& frame) {
+    std::optional<std::size_t> length;
+    while (!head.empty()) {
+        const auto eol = head.find('\n');
+        const auto line = head.substr(0, eol);
+        head.remove_prefix(eol == std::string_view::npos ? head.size() : eol + 1);
+        const auto colon = line.find(':');
+        if (colon == std::string_view::npos) {
+            continue;
+        }
+        const auto name = trim(line.substr(0, colon));
+        if (iequals(name, "Transfer-Encoding")) {
+            frame.error_status = 501;
+            return;
+        }
+        if (!iequals(name, "Content-Length")) {
+            continue;
+        }
+        const auto value = trim(line.substr(colon + 1));
+        std::size_t parsed = 0;
+        const auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), parsed);
+        if (value.empty() || ec != std::errc{} || end != value.data() + value.size() ||
+            (length && *length != parsed)) {
+            frame.error_status = 400;
+            return;
+        }
+        length = parsed;
+    }
+    frame.content_length = length.value_or(0);
+}
+
+// Advances `frame` over `raw`, which must extend the buffer previously passed with the same frame.
+// Returns the bytes the front request occupies once its headers and full body have arrived; anything
+// after that belongs to the next pipelined request. A request that cannot be framed is reported
+// complete at the end of its header block with `frame.error_status` set. Only bytes not yet scanned are searched for the
+// header terminator, and the body length is read once, so repeated calls while a large request
+// trickles in stay linear in its size.
+inline std::optional<std::size_t> frame_request(std::string_view raw, RequestFrame& frame) {
+    if (frame.body_start == 0) {
+        // The header block ends at the first "\r\n\r\n" or bare "\n\n", whichever comes first.
+        for (auto eol = raw.find('\n', frame.scanned); eol != std::string_view::npos; eol = raw.find('\n', eol + 1)) {
+            if (eol >= 1 && raw[eol - 1] == '\n') {
+                frame.header_end = eol - 1;
+            } else if (eol >= 3 && raw.substr(eol - 3, 4) == "\r\n\r\n") {
+                frame.header_end = eol - 3;
+            } else {
+                continue;
+            }
+            frame.body_start = eol + 1;
+            break;
+        }
+        if (frame.body_start == 0) {
+            frame.scanned = raw.size();
+            return std::nullopt;
+        }
+        frame_body_length(raw.substr(0, frame.header_end), frame);
+        if (frame.error_status != 0) {
+            return frame.body_start;
+        }
+    }
+    if (raw.size() - frame.body_start < frame.content_length) {
+        return std::nullopt;
+    }
+    return frame.body_start + frame.content_length;
+}
+
+// Parses the request framed by `frame` at the front of `raw` into `req` without copying: every
+// field of `req` views `raw`. frame_request() must have reported the request complete.
+inline void parse_framed_request(std::string_view raw, const RequestFrame& frame, Request& req) {
+    auto head = raw.substr(0, frame.header_end);
+    const auto next_line = [&head]() {
+        const auto eol = head.find('\n');
+        auto line = head.substr(0, eol);
+        head.remove_prefix(eol == std::string_view::npos ? head.size() : eol + 1);
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        return line;
+    };
+
+    auto request_line = next_line();
+    const auto next_token = [&request_line]() {
+        while (!request_line.empty() && request_line.front() == ' ') {
+            request_line.remove_prefix(1);
+        }
+        const auto space = request_line.find(' ');
+        const auto token = request_line.substr(0, space);
+        request_line.remove_prefix(token.size());
+        return token;
+    };
+    req.method = next_token();
+    const auto target = next_token();
+    req.version = next_token();
+
+    req.path = target;
+    if (const auto q = target.find('?'); q != std::string_view::npos) {
+        parse_query_string(target.substr(q + 1), req.params);
+        req.path = target.substr(0, q);
+    }
+
+    while (!head.empty()) {
+        const auto line = next_line();
+        const auto colon = line.find(':');
+        if (colon == std::string_view::npos) {
+            continue;
+        }
+        req.headers.emplace_view(trim(line.substr(0, colon)), trim(line.substr(colon + 1)));
+    }
+
+    req.body = raw.substr(frame.body_start, frame.content_length);
+}
+
+// Parses the request at the front of `raw` into `req` without copying: every field of `req` views
+// `raw`. Returns the bytes the request occupies, or std::nullopt until its headers and full body
+// have arrived or when it cannot be framed. Anything after the returned length belongs to the next
+// pipelined request.
+inline std::optional<std::size_t> parse_request(std::string_view raw, Request& req) {
+    RequestFrame frame;
+    const auto size = frame_request(raw, frame);
+    if (frame.error_status != 0) {
+        return std::nullopt;
+    }
+    if (size) {
+        parse_framed_request(raw, frame, req);
+    }
+    return size;
+}
+
+}  // namespace detail
+
+// Receives a chunked response body from a content provider; mirrors cpp-httplib's DataSink.
+class DataSink {
+public:
+    DataSink() = default;
+    DataSink(const DataSink&) = delete;
+    DataSink& operator=(const DataSink&) = delete;
+
+    std::function<bool(const char* data, std::size_t data_len)> write;
+    // False once the client has gone away, so a provider can stop producing the body.
+    std::function<bool()> is_writable;
+    std::function<void()> done;
+};
+
+// Writes the body from `offset`, at most `length` bytes per call; returning false aborts the response.
+using ContentProvider = std::function<bool(std::size_t offset, std::size_t length, DataSink& sink)>;
+// Called with the bytes written so far until it calls `sink.done()`; returning false aborts the response.
+using ContentProviderWithoutLength = std::function<bool(std::size_t offset, DataSink& sink)>;
+
 struct Response {
     int status{200};
     std::string body;
     std::string content_type;
+    // Extra response headers, emitted after Content-Type/Content-Length.
+    std::multimap<std::string, std::string> headers;
+
+    void set_header(const std::string& key, const std::string& value) {
+        headers.emplace(key, value);
+    }
+
+    [[nodiscard]] std::string get_header_value(const std::string& key) const {
+        for (const auto& [name, value] : headers) {
+            if (detail::iequals(name, key)) {
+                return value;
+            }
+        }
+        return {};
+    }
 
     void set_content(const std::string& content, const std::string& type) {
         body = content;
         content_type = type;
     }
+
+    void set_content(std::string&& content, const std::string& type) {
+        body = std::move(content);
+        content_type = type;
+    }
+
+    // The body is produced by `provider` when the response is serialized and sent with
+    // `Transfer-Encoding: chunked`.
+    void set_chunked_content_provider(const std::string& type, ContentProviderWithoutLength provider) {
+        body.clear();
+        content_type = type;
+        content_provider = std::move(provider);
+    }
+
+    // The `length`-byte body is produced by `provider` when the response is serialized and sent with
+    // `Content-Length`, so a shared buffer can be served without first being copied into `body`.
+    void set_content_provider(std::size_t length, const std::string& type, ContentProvider provider) {
+        body.clear();
+        content_type = type;
+        content_length = length;
+        sized_content_provider = std::move(provider);
+    }
+
+    ContentProviderWithoutLength content_provider;
+    std::size_t content_length{0};
+    ContentProvider sized_content_provider;
+};
+
+// Runs handler work off the reactor threads; mirrors cpp-httplib's TaskQueue extension point.
+class TaskQueue {
+public:
+    TaskQueue() = default;
+    virtual ~TaskQueue() = default;
+
+    TaskQueue(const TaskQueue&) = delete;
+    TaskQueue& operator=(const TaskQueue&) = delete;
+
+    // Returns false once the queue has been shut down.
+    virtual bool enqueue(std::function<void()> fn) = 0;
+    // Runs every task already queued, then stops the workers.
+    virtual void shutdown() = 0;
+};
+
+class ThreadPool final : public TaskQueue {
+public:
+    explicit ThreadPool(std::size_t thread_count) {
+        for (std::size_t i = 0; i < (thread_count == 0 ? 1 : thread_count); ++i) {
+            workers_.emplace_back([this]() { Work(); });
+        }
+    }
+
+    ~ThreadPool() override {
+        shutdown();
+    }
+
+    bool enqueue(std::function<void()> fn) override {
+        {
+            std::lock_guard lock(mutex_);
+            if (shutdown_) {
+                return false;
+            }
+            tasks_.push_back(std::move(fn));
+        }
+        ready_.notify_one();
+        return true;
+    }
+
+    void shutdown() override {
+        {
+            std::lock_guard lock(mutex_);
+            if (shutdown_) {
+                return;
+            }
+            shutdown_ = true;
+        }
+        ready_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+private:
+    void Work() {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock lock(mutex_);
+                ready_.wait(lock, [this]() { return shutdown_ || !tasks_.empty(); });
+                if (tasks_.empty()) {
+                    return;
+                }
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<std::function<void()>> tasks_;
+    bool shutdown_{false};
+    std::vector<std::thread> workers_;
 };
 
+// Event-driven fallback server: one edge-triggered epoll reactor per core owns the sockets and does
+// all non-blocking I/O, and complete requests are handed to a TaskQueue so a slow handler or a slow
+// client never holds up other connections. Connections are persistent (HTTP/1.1 keep-alive) and may
+// pipeline: requests on one connection run one at a time, so responses go out in request order.
 class Server {
 public:
     using Handler = std::function<void(const Request&, Response&)>;
 
+    enum class HandlerResponse {
+        Handled,
+        Unhandled,
+    };
+    using HandlerWithResponse = std::function<HandlerResponse(const Request&, Response&)>;
+
+    // Called once per listen(); the server owns the returned queue.
+    std::function<TaskQueue*()> new_task_queue = []() { return new ThreadPool(CPPHTTPLIB_THREAD_POOL_COUNT); };
+
+    Server() = default;
+    Server(const Server&) = delete;
+    Server& operator=(const Server&) = delete;
+
+    // Requests served on one connection before it is closed.
+    Server& set_keep_alive_max_count(std::size_t count) {
+        keep_alive_max_count_ = count == 0 ? 1 : count;
+        return *this;
+    }
+
+    // Idle time after which a connection, or a request that stopped arriving, is closed.
+    Server& set_keep_alive_timeout(std::time_t sec) {
+        keep_alive_timeout_ = std::chrono::seconds{sec};
+        return *this;
+    }
+
+    // Requests declaring a longer body are answered 413 before it is read, and the connection closed.
+    Server& set_payload_max_length(std::size_t length) {
+        payload_max_length_ = length;
+        return *this;
+    }
+
+    // Runs before route matching; returning Handled skips the registered routes.
+    Server& set_pre_routing_handler(HandlerWithResponse handler) {
+        pre_routing_handler_ = std::move(handler);
+        return *this;
+    }
+
     void Get(const std::string& pattern, Handler handler) {
         get_routes_.push_back(Route{
             .pattern = pattern,
@@ -102,21 +589,18 @@ public:
     }
 
     bool listen(const char* host, int port) {
-#if defined(_WIN32)
+#if !defined(__linux__)
         (void)host;
         (void)port;
         return false;
 #else
         // The lightweight compat server binds INADDR_ANY and currently ignores `host`.
         (void)host;
-        listen_port_ = port;
 
-        const int server_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        const int server_fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
         if (server_fd < 0) {
             return false;
         }
-        server_fd_ = server_fd;
-        running_.store(true);
 
         int opt = 1;
         ::setsockopt(server_fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
@@ -126,82 +610,459 @@ public:
         addr.sin_port = htons(static_cast<uint16_t>(port));
         addr.sin_addr.s_addr = htonl(INADDR_ANY);
 
-        if (::bind(server_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
-            running_.store(false);
-            server_fd_ = -1;
+        if (::bind(server_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+            ::listen(server_fd, SOMAXCONN) < 0) {
             ::close(server_fd);
             return false;
         }
 
-        if (::listen(server_fd, 16) < 0) {
-            running_.store(false);
-            server_fd_ = -1;
-            ::close(server_fd);
-            return false;
+        const unsigned cores = std::thread::hardware_concurrency();
+        {
+            std::lock_guard lock(lifecycle_mutex_);
+            for (unsigned i = 0; i < (cores == 0 ? 1 : cores); ++i) {
+                auto reactor = std::make_unique<Reactor>();
+                reactor->epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+                reactor->wake_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+                // Every reactor accepts; EPOLLEXCLUSIVE wakes only one of them per new connection.
+                epoll_event listen_event{.events = EPOLLIN | EPOLLEXCLUSIVE, .data = {.fd = server_fd}};
+                epoll_event wake_event{.events = EPOLLIN, .data = {.fd = reactor->wake_fd}};
+                ::epoll_ctl(reactor->epoll_fd, EPOLL_CTL_ADD, server_fd, &listen_event);
+                ::epoll_ctl(reactor->epoll_fd, EPOLL_CTL_ADD, reactor->wake_fd, &wake_event);
+                reactors_.push_back(std::move(reactor));
+            }
+            task_queue_.reset(new_task_queue());
+            running_.store(true);
         }
 
-        for (; running_.load();) {
-            const int client_fd = ::accept(server_fd, nullptr, nullptr);
-            if (client_fd < 0) {
-                if (!running_.load()) {
-                    break;
+        std::vector<std::thread> threads;
+        for (std::size_t i = 1; i < reactors_.size(); ++i) {
+            threads.emplace_back([this, i, server_fd]() { RunReactor(*reactors_[i], server_fd); });
+        }
+        RunReactor(*reactors_[0], server_fd);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        // Workers may still post completions to the reactors, so they are torn down last. Streaming
+        // workers would otherwise wait for reactors that no longer send.
+        for (auto& reactor : reactors_) {
+            for (const auto& [fd, connection] : reactor->connections) {
+                if (connection->window) {
+                    CloseWindow(*connection->window);
                 }
-                continue;
             }
-            HandleClient(client_fd);
-            ::close(client_fd);
         }
-        running_.store(false);
-        server_fd_ = -1;
+        task_queue_->shutdown();
+        std::lock_guard lock(lifecycle_mutex_);
+        for (auto& reactor : reactors_) {
+            for (const auto& [fd, connection] : reactor->connections) {
+                ::close(fd);
+            }
+            ::close(reactor->wake_fd);
+            ::close(reactor->epoll_fd);
+        }
+        reactors_.clear();
+        task_queue_.reset();
         ::close(server_fd);
         return true;
 #endif
     }
 
     void stop() {
-#if !defined(_WIN32)
+#if defined(__linux__)
+        std::lock_guard lock(lifecycle_mutex_);
         running_.store(false);
-        if (listen_port_ > 0) {
-            // Wake the blocking accept() call so listen() can observe running_=false and exit.
-            const int wake_fd = ::socket(AF_INET, SOCK_STREAM, 0);
-            if (wake_fd >= 0) {
-                sockaddr_in addr{};
-                addr.sin_family = AF_INET;
-                addr.sin_port = htons(static_cast<uint16_t>(listen_port_));
-                addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
-                (void)::connect(wake_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
-                ::close(wake_fd);
-            }
+        for (const auto& reactor : reactors_) {
+            Wake(*reactor);
         }
 #endif
     }
 
 private:
-#if !defined(_WIN32)
-    static std::string Trim(const std::string& value) {
-        std::size_t start = 0;
-        while (start < value.size() && (value[start] == ' ' || value[start] == '\t' || value[start] == '\r')) {
-            ++start;
+#if defined(__linux__)
+    // Connections whose request header block grows past this are dropped; bodies are bounded by
+    // set_payload_max_length().
+    static constexpr std::size_t kMaxHeaderBytes = 64 * 1024;
+    static constexpr int kMaxEvents = 64;
+    // How often reactors look for connections past the keep-alive timeout.
+    static constexpr std::chrono::milliseconds kIdleSweepInterval{1000};
+    // A streamed body is handed to the reactor in batches of about this size, and its worker waits
+    // while more than kMaxUnsentBytes of it are queued for a slow client.
+    static constexpr std::size_t kStreamBatchBytes = 16 * 1024;
+    static constexpr std::size_t kMaxUnsentBytes = 256 * 1024;
+
+    using Clock = std::chrono::steady_clock;
+
+    // Flow control between the worker streaming a response and the reactor sending it.
+    struct OutputWindow {
+        std::mutex mutex;
+        std::condition_variable drained;
+        // Bytes the worker has handed over that have not reached the socket yet.
+        std::size_t unsent{0};
+        // Nothing more will be sent: the write failed or the server is stopping.
+        bool closed{false};
+    };
+
+    static void CloseWindow(OutputWindow& window) {
+        {
+            std::lock_guard lock(window.mutex);
+            window.closed = true;
+        }
+        window.drained.notify_all();
+    }
+
+    struct Connection {
+        int fd{-1};
+        // Received bytes not yet consumed; may hold several pipelined requests.
+        std::string in;
+        // How far the request at the front of `in` has been framed.
+        detail::RequestFrame frame;
+        // The request being served. Its fields view the front `request_bytes` of `in`, so `in` is
+        // left untouched while a worker holds it.
+        Request request;
+        std::size_t request_bytes{0};
+        std::string out;
+        std::size_t out_offset{0};
+        // Shared with the worker serving `request`.
+        std::shared_ptr<OutputWindow> window;
+        // A request from this connection is with a worker; the fd stays open until it answers. A
+        // streamed response is sent while the worker is still producing it.
+        bool busy{false};
+        // A send failed while the worker was still busy; the connection closes once it finishes.
+        bool write_failed{false};
+        // The peer finished sending (FIN) or the socket failed.
+        bool read_closed{false};
+        // The response being written is the last one on this connection.
+        bool close_after_response{false};
+        std::size_t requests{0};
+        Clock::time_point last_active{};
+    };
+
+    struct Completion {
+        int fd{-1};
+        std::string payload;
+        // The payload ends the connection, e.g. a chunked body whose provider failed part way.
+        bool close{false};
+        // False for a leading part of a streamed response; the worker still holds the connection.
+        bool last{true};
+    };
+
+    struct Reactor {
+        int epoll_fd{-1};
+        int wake_fd{-1};
+        // Owned by the reactor thread.
+        std::unordered_map<int, std::unique_ptr<Connection>> connections;
+        // Responses produced by workers, drained by the reactor thread after a wake.
+        std::mutex completions_mutex;
+        std::vector<Completion> completions;
+    };
+
+    static void Wake(Reactor& reactor) {
+        const std::uint64_t one = 1;
+        (void)::write(reactor.wake_fd, &one, sizeof(one));
+    }
+
+    void RunReactor(Reactor& reactor, int server_fd) {
+        epoll_event events[kMaxEvents];
+        auto last_sweep = Clock::now();
+        while (running_.load()) {
+            const int ready = ::epoll_wait(reactor.epoll_fd, events, kMaxEvents,
+                                           static_cast<int>(kIdleSweepInterval.count()));
+            for (int i = 0; i < ready; ++i) {
+                const int fd = events[i].data.fd;
+                if (fd == server_fd) {
+                    AcceptConnections(reactor, server_fd);
+                } else if (fd == reactor.wake_fd) {
+                    std::uint64_t count = 0;
+                    (void)::read(reactor.wake_fd, &count, sizeof(count));
+                    DrainCompletions(reactor);
+                } else if (const auto it = reactor.connections.find(fd); it != reactor.connections.end()) {
+                    OnConnectionEvent(reactor, *it->second, events[i].events);
+                }
+            }
+            if (const auto now = Clock::now(); now - last_sweep >= kIdleSweepInterval) {
+                CloseIdleConnections(reactor, now);
+                last_sweep = now;
+            }
+        }
+    }
+
+    // Connections waiting on a worker are exempt; everything else must make progress within the timeout.
+    void CloseIdleConnections(Reactor& reactor, Clock::time_point now) {
+        std::vector<int> idle;
+        for (const auto& [fd, connection] : reactor.connections) {
+            if (!connection->busy && now - connection->last_active > keep_alive_timeout_) {
+                idle.push_back(fd);
+            }
         }
-        std::size_t end = value.size();
-        while (end > start && (value[end - 1] == ' ' || value[end - 1] == '\t' || value[end - 1] == '\r')) {
-            --end;
+        for (const int fd : idle) {
+            CloseConnection(reactor, fd);
         }
-        return value.substr(start, end - start);
+    }
+
+    void AcceptConnections(Reactor& reactor, int server_fd) {
+        for (;;) {
+            const int client_fd = ::accept4(server_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (client_fd < 0) {
+                return;
+            }
+            epoll_event event{.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET, .data = {.fd = client_fd}};
+            if (::epoll_ctl(reactor.epoll_fd, EPOLL_CTL_ADD, client_fd, &event) < 0) {
+                ::close(client_fd);
+                continue;
+            }
+            auto connection = std::make_unique<Connection>();
+            connection->fd = client_fd;
+            connection->last_active = Clock::now();
+            reactor.connections.emplace(client_fd, std::move(connection));
+        }
+    }
+
+    void OnConnectionEvent(Reactor& reactor, Connection& connection, std::uint32_t events) {
+        // Reading is paused while a worker views the buffer; FlushOutput() resumes it. A response
+        // being streamed keeps draining meanwhile.
+        if (connection.busy) {
+            if (!connection.out.empty()) {
+                FlushOutput(reactor, connection);
+            }
+            return;
+        }
+        if ((events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) != 0) {
+            ReadAvailable(connection);
+        }
+        if (!connection.out.empty()) {
+            FlushOutput(reactor, connection);
+            return;
+        }
+        TryDispatch(reactor, connection);
+    }
+
+    // Edge-triggered: drain the socket until it would block.
+    static void ReadAvailable(Connection& connection) {
+        char buffer[16384];
+        while (!connection.read_closed) {
+            const auto n = ::recv(connection.fd, buffer, sizeof(buffer), 0);
+            if (n > 0) {
+                connection.in.append(buffer, static_cast<std::size_t>(n));
+                connection.last_active = Clock::now();
+                continue;
+            }
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                return;
+            }
+            connection.read_closed = true;
+        }
+    }
+
+    void TryDispatch(Reactor& reactor, Connection& connection) {
+        const int fd = connection.fd;
+        const auto consumed = detail::frame_request(connection.in, connection.frame);
+        // The declared length is checked as soon as the headers are in, before any body is buffered.
+        if (connection.frame.body_start != 0 && connection.frame.error_status == 0 &&
+            connection.frame.content_length > payload_max_length_) {
+            connection.frame.error_status = 413;
+        }
+        if (connection.frame.error_status != 0) {
+            RejectRequest(reactor, connection);
+            return;
+        }
+        if (!consumed) {
+            // Incomplete: wait for more bytes unless none can arrive or the headers are over budget.
+            if (connection.read_closed ||
+                (connection.frame.body_start == 0 && connection.in.size() > kMaxHeaderBytes)) {
+                CloseConnection(reactor, fd);
+            }
+            return;
+        }
+        connection.request = Request{};
+        detail::parse_framed_request(connection.in, connection.frame, connection.request);
+        connection.frame = detail::RequestFrame{};
+        // A reset or full hang-up always counts. A FIN (POLLRDHUP) counts once nothing is pipelined
+        // behind this request, which is how a client that called close() looks and what cpp-httplib
+        // reports too; one that half-closed after sending more requests still wants their responses.
+        // Reading stays paused while the worker runs, so `pipelined` cannot change under it.
+        const auto pipelined = connection.in.size() - *consumed;
+        connection.request.is_connection_closed = [fd, pipelined]() {
+            pollfd probe{.fd = fd, .events = POLLRDHUP, .revents = 0};
+            if (::poll(&probe, 1, 0) <= 0) {
+                return false;
+            }
+            if ((probe.revents & (POLLHUP | POLLERR)) != 0) {
+                return true;
+            }
+            int unread = 0;
+            return (probe.revents & POLLRDHUP) != 0 && pipelined == 0 && ::ioctl(fd, FIONREAD, &unread) == 0 &&
+                   unread == 0;
+        };
+        connection.request_bytes = *consumed;
+        connection.busy = true;
+        const bool keep_alive = running_.load() && WantsKeepAlive(connection.request) &&
+                                ++connection.requests < keep_alive_max_count_;
+        connection.close_after_response = !keep_alive;
+
+        connection.window = std::make_shared<OutputWindow>();
+
+        Reactor* owner = &reactor;
+        Connection* served = &connection;
+        const bool queued = task_queue_->enqueue([this, owner, served, keep_alive, window = connection.window]() {
+            Response res = Handle(served->request);
+            const bool head_request = served->request.method == "HEAD";
+            if (res.content_provider && !head_request && res.status != 304) {
+                StreamResponse(*owner, served->fd, res, keep_alive, *window, [served]() {
+                    return served->request.is_connection_closed();
+                });
+                return;
+            }
+            bool keep = keep_alive;
+            auto payload = SerializeResponse(res, keep, head_request);
+            Post(*owner, Completion{.fd = served->fd, .payload = std::move(payload), .close = !keep, .last = true});
+        });
+        if (!queued) {
+            CloseConnection(reactor, fd);
+        }
+    }
+
+    // Answers `frame.error_status` for a request whose body is unknown in length or too large and
+    // closes the connection, so the bytes after its headers are never read as another request.
+    void RejectRequest(Reactor& reactor, Connection& connection) {
+        Response res{};
+        res.status = connection.frame.error_status;
+        res.set_content("{\"error\":\"" + ReasonPhrase(res.status) + "\"}", "application/json");
+        bool keep_alive = false;
+        connection.out = SerializeResponse(res, keep_alive, false);
+        connection.out_offset = 0;
+        connection.close_after_response = true;
+        FlushOutput(reactor, connection);
+    }
+
+    void DrainCompletions(Reactor& reactor) {
+        std::vector<Completion> completions;
+        {
+            std::lock_guard lock(reactor.completions_mutex);
+            completions.swap(reactor.completions);
+        }
+        for (auto& completion : completions) {
+            const auto it = reactor.connections.find(completion.fd);
+            if (it == reactor.connections.end()) {
+                continue;
+            }
+            Connection& connection = *it->second;
+            if (completion.last) {
+                connection.busy = false;
+                connection.in.erase(0, connection.request_bytes);
+                connection.request_bytes = 0;
+                connection.close_after_response = connection.close_after_response || completion.close;
+            }
+            if (connection.out.empty()) {
+                connection.out = std::move(completion.payload);
+                connection.out_offset = 0;
+            } else {
+                connection.out += completion.payload;
+            }
+            FlushOutput(reactor, connection);
+        }
+    }
+
+    void FlushOutput(Reactor& reactor, Connection& connection) {
+        if (connection.write_failed) {
+            connection.out.clear();
+            connection.out_offset = 0;
+            if (!connection.busy) {
+                CloseConnection(reactor, connection.fd);
+            }
+            return;
+        }
+        while (connection.out_offset < connection.out.size()) {
+            const auto n = ::send(connection.fd,
+                                  connection.out.data() + connection.out_offset,
+                                  connection.out.size() - connection.out_offset,
+                                  MSG_NOSIGNAL);
+            if (n > 0) {
+                connection.out_offset += static_cast<std::size_t>(n);
+                connection.last_active = Clock::now();
+                if (connection.window) {
+                    {
+                        std::lock_guard lock(connection.window->mutex);
+                        connection.window->unsent -= std::min(connection.window->unsent, static_cast<std::size_t>(n));
+                    }
+                    connection.window->drained.notify_all();
+                }
+                continue;
+            }
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                // EPOLLOUT fires once the socket drains.
+                return;
+            }
+            if (connection.busy) {
+                // The worker still views `request`, so the connection outlives it; the worker is told
+                // to stop producing and the connection closes once it finishes.
+                CloseWindow(*connection.window);
+                connection.write_failed = true;
+                connection.out.clear();
+                connection.out_offset = 0;
+                return;
+            }
+            CloseConnection(reactor, connection.fd);
+            return;
+        }
+        connection.out.clear();
+        connection.out_offset = 0;
+        if (connection.busy) {
+            // More of a streamed response is on its way.
+            return;
+        }
+        if (connection.close_after_response) {
+            CloseConnection(reactor, connection.fd);
+            return;
+        }
+        // Pick up whatever arrived while the request was served, then start the next pipelined one.
+        ReadAvailable(connection);
+        TryDispatch(reactor, connection);
+    }
+
+    static void CloseConnection(Reactor& reactor, int fd) {
+        ::epoll_ctl(reactor.epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+        ::close(fd);
+        reactor.connections.erase(fd);
     }
 
     static std::string ReasonPhrase(int status) {
         switch (status) {
             case 200:
                 return "OK";
+            case 304:
+                return "Not Modified";
             case 404:
                 return "Not Found";
             case 405:
                 return "Method Not Allowed";
+            case 400:
+                return "Bad Request";
+            case 401:
+                return "Unauthorized";
+            case 413:
+                return "Payload Too Large";
+            case 429:
+                return "Too Many Requests";
+            case 500:
+                return "Internal Server Error";
+            case 501:
+                return "Not Implemented";
+            case 503:
+                return "Service Unavailable";
+            case 504:
+                return "Gateway Timeout";
             default:
                 return "OK";
         }
     }
+#endif
 
     static bool LooksLikeRegex(const std::string& pattern) {
         return pattern.find('(') != std::string::npos ||
@@ -209,26 +1070,6 @@ private:
                pattern.find('\\') != std::string::npos;
     }
 
-    static void ParseQueryString(const std::string& query, Request& req) {
-        std::size_t start = 0;
-        while (start <= query.size()) {
-            const auto end = query.find('&', start);
-            const auto token = query.substr(start, end == std::string::npos ? std::string::npos : end - start);
-            if (!token.empty()) {
-                const auto eq = token.find('=');
-                if (eq == std::string::npos) {
-                    req.params[token] = "";
-                } else {
-                    req.params[token.substr(0, eq)] = token.substr(eq + 1);
-                }
-            }
-            if (end == std::string::npos) {
-                break;
-            }
-            start = end + 1;
-        }
-    }
-
     struct Route {
         std::string pattern;
         Handler handler;
@@ -236,7 +1077,22 @@ private:
         std::regex regex;
     };
 
-    bool Dispatch(const std::vector<Route>& routes, Request& req, Response& res) {
+#if defined(__linux__)
+    // HTTP/1.1 connections persist unless the client asks to close; HTTP/1.0 ones only on request.
+    static bool WantsKeepAlive(const Request& req) {
+        const auto* connection = req.headers.find("Connection", true);
+        const std::string_view value = connection == nullptr ? std::string_view{} : *connection;
+        if (detail::icontains(value, "close")) {
+            return false;
+        }
+        if (req.version == "HTTP/1.0") {
+            return detail::icontains(value, "keep-alive");
+        }
+        return true;
+    }
+#endif
+
+    bool Dispatch(const std::vector<Route>& routes, Request& req, Response& res) const {
         for (const auto& route : routes) {
             if (!route.is_regex) {
                 if (route.pattern == req.path) {
@@ -246,11 +1102,18 @@ private:
                 continue;
             }
 
-            std::smatch match;
-            if (std::regex_match(req.path, match, route.regex)) {
+            std::match_results<std::string_view::const_iterator> match;
+            if (std::regex_match(req.path.begin(), req.path.end(), match, route.regex)) {
                 req.matches.clear();
                 for (std::size_t i = 0; i < match.size(); ++i) {
-                    req.matches.push_back(Request::Match{.value = match[i].str()});
+                    if (!match[i].matched) {
+                        req.matches.push_back(Request::Match{});
+                        continue;
+                    }
+                    req.matches.push_back(Request::Match{
+                        .value = req.path.substr(static_cast<std::size_t>(match.position(i)),
+                                                 static_cast<std::size_t>(match.length(i)))
+                    });
                 }
                 route.handler(req, res);
                 return true;
@@ -259,131 +1122,187 @@ private:
         return false;
     }
 
-    void HandleClient(int client_fd) {
-        std::string raw;
-        char buffer[4096];
-        for (;;) {
-            const auto n = ::recv(client_fd, buffer, sizeof(buffer), 0);
-            if (n <= 0) {
-                return;
-            }
-            raw.append(buffer, static_cast<std::size_t>(n));
-            if (raw.find("\r\n\r\n") != std::string::npos || raw.find("\n\n") != std::string::npos) {
-                break;
+#if defined(__linux__)
+    Response Handle(Request& req) const {
+        // Handlers start from 200, as with cpp-httplib, and set another status when they need one.
+        Response res{};
+
+        if (pre_routing_handler_ && pre_routing_handler_(req, res) == HandlerResponse::Handled) {
+            // handled
+        } else if (req.method == "GET" || req.method == "HEAD") {
+            if (!Dispatch(get_routes_, req, res)) {
+                res.status = 404;
+                res.set_content("{\"error\":\"Not Found\"}", "application/json");
             }
-            if (raw.size() > 1024 * 1024) {
-                return;
+        } else if (req.method == "POST") {
+            if (!Dispatch(post_routes_, req, res)) {
+                res.status = 405;
+                res.set_content("{\"error\":\"Method Not Allowed\"}", "application/json");
             }
+        } else {
+            res.status = 405;
+            res.set_content("{\"error\":\"Method Not Allowed\"}", "application/json");
         }
 
-        std::istringstream stream(raw);
-        std::string request_line;
-        if (!std::getline(stream, request_line)) {
-            return;
-        }
-        if (!request_line.empty() && request_line.back() == '\r') {
-            request_line.pop_back();
+        if (res.content_type.empty()) {
+            res.content_type = "text/plain";
         }
+        return res;
+    }
 
-        std::istringstream request_line_stream(request_line);
-        std::string method;
-        std::string target;
-        std::string version;
-        request_line_stream >> method >> target >> version;
-        if (method.empty() || target.empty()) {
-            return;
+    static void Post(Reactor& reactor, Completion completion) {
+        {
+            std::lock_guard lock(reactor.completions_mutex);
+            reactor.completions.push_back(std::move(completion));
         }
+        Wake(reactor);
+    }
 
-        Request req{};
-        req.path = target;
-        if (const auto q = req.path.find('?'); q != std::string::npos) {
-            ParseQueryString(req.path.substr(q + 1), req);
-            req.path = req.path.substr(0, q);
+    // Status line and headers, through the blank line.
+    std::string SerializeHead(const Response& res, bool keep_alive) const {
+        std::ostringstream head;
+        head << "HTTP/1.1 " << res.status << " " << ReasonPhrase(res.status) << "\r\n";
+        // A 304 describes the representation the client already has, so it carries neither a body nor
+        // body headers.
+        if (res.status != 304) {
+            head << "Content-Type: " << res.content_type << "\r\n";
+            if (res.content_provider) {
+                head << "Transfer-Encoding: chunked\r\n";
+            } else if (res.sized_content_provider) {
+                head << "Content-Length: " << res.content_length << "\r\n";
+            } else {
+                head << "Content-Length: " << res.body.size() << "\r\n";
+            }
+        }
+        for (const auto& [name, value] : res.headers) {
+            head << name << ": " << value << "\r\n";
         }
+        if (keep_alive) {
+            head << "Connection: keep-alive\r\n";
+            head << "Keep-Alive: timeout=" << keep_alive_timeout_.count() << ", max=" << keep_alive_max_count_
+                 << "\r\n\r\n";
+        } else {
+            head << "Connection: close\r\n\r\n";
+        }
+        return head.str();
+    }
 
-        std::string header_line;
-        while (std::getline(stream, header_line)) {
-            if (!header_line.empty() && header_line.back() == '\r') {
-                header_line.pop_back();
-            }
-            if (header_line.empty()) {
-                break;
-            }
-            const auto colon = header_line.find(':');
-            if (colon == std::string::npos) {
-                continue;
+    // A whole response other than a streamed chunked body (see StreamResponse()). A sized provider
+    // runs to completion here; if it fails part way the body is left short and `keep_alive` is
+    // cleared, which tells the client the response was cut short. A `head_request` response carries
+    // the GET headers but no body, and its providers are not run.
+    std::string SerializeResponse(const Response& res, bool& keep_alive, bool head_request) const {
+        std::string provided;
+        const bool with_body = !head_request && res.status != 304;
+        if (res.sized_content_provider && with_body) {
+            provided.reserve(res.content_length);
+            DataSink sink;
+            sink.write = [&](const char* data, std::size_t size) {
+                provided.append(data, std::min(size, res.content_length - provided.size()));
+                return true;
+            };
+            sink.is_writable = []() { return true; };
+            sink.done = []() {};
+            while (provided.size() < res.content_length) {
+                const auto before = provided.size();
+                // A provider that stops making progress is treated as failed rather than spun on.
+                if (!res.sized_content_provider(before, res.content_length - before, sink) ||
+                    provided.size() == before) {
+                    keep_alive = false;
+                    break;
+                }
             }
-            const auto key = Trim(header_line.substr(0, colon));
-            const auto value = Trim(header_line.substr(colon + 1));
-            req.headers[detail::ascii_lower(key)] = value;
         }
 
-        Response res{};
-        res.status = 404;
-        res.set_content("{\"error\":\"Not Found\"}", "application/json");
-
-        std::size_t content_length = 0;
-        if (const auto it = req.headers.find("content-length"); it != req.headers.end()) {
-            try {
-                content_length = static_cast<std::size_t>(std::stoul(it->second));
-            } catch (...) {
-                content_length = 0;
-            }
+        auto response = SerializeHead(res, keep_alive);
+        if (with_body) {
+            response += res.sized_content_provider ? provided : res.body;
         }
+        return response;
+    }
 
-        std::string body_remainder;
-        std::getline(stream, body_remainder, '\0');
-        req.body = body_remainder;
-        // Header parsing may stop before the full body arrives; keep reading until content-length.
-        while (req.body.size() < content_length) {
-            const auto n = ::recv(client_fd, buffer, sizeof(buffer), 0);
-            if (n <= 0) {
-                break;
+    // Sends a chunked provider's body while it is produced: the head goes to the reactor first, then
+    // the framed chunks in batches of about kStreamBatchBytes. The worker waits while more than
+    // kMaxUnsentBytes are queued, so a slow client holds the provider back rather than the body
+    // piling up in memory. `DataSink::is_writable` turns false once the client has gone away or a
+    // send failed. A provider that fails part way leaves the body unterminated and closes the
+    // connection; its head has already gone out, so that is how the client learns of it.
+    void StreamResponse(Reactor& reactor,
+                        int fd,
+                        const Response& res,
+                        bool keep_alive,
+                        OutputWindow& window,
+                        const std::function<bool()>& client_gone) const {
+        std::string batch = SerializeHead(res, keep_alive);
+        const auto hand_over = [&](bool last, bool close) {
+            {
+                std::unique_lock lock(window.mutex);
+                if (!last) {
+                    window.drained.wait(lock, [&]() { return window.closed || window.unsent < kMaxUnsentBytes; });
+                }
+                window.unsent += batch.size();
             }
-            req.body.append(buffer, static_cast<std::size_t>(n));
-        }
-        // Ignore any trailing bytes past the declared content-length for deterministic handling.
-        if (req.body.size() > content_length) {
-            req.body.resize(content_length);
-        }
+            Post(reactor, Completion{.fd = fd, .payload = std::move(batch), .close = close, .last = last});
+            batch.clear();
+        };
 
-        if (method == "GET") {
-            if (Dispatch(get_routes_, req, res)) {
-                // handled
+        bool done = false;
+        bool failed = false;
+        std::size_t offset = 0;
+        DataSink sink;
+        sink.write = [&](const char* data, std::size_t size) {
+            if (size == 0) {
+                return true;
             }
-        } else if (method == "POST") {
-            if (!Dispatch(post_routes_, req, res)) {
-                res.status = 405;
-                res.set_content("{\"error\":\"Method Not Allowed\"}", "application/json");
+            std::array<char, 16> digits{};
+            const auto [end, ec] = std::to_chars(digits.data(), digits.data() + digits.size(), size, 16);
+            batch.append(digits.data(), end);
+            batch += "\r\n";
+            batch.append(data, size);
+            batch += "\r\n";
+            offset += size;
+            if (batch.size() >= kStreamBatchBytes) {
+                hand_over(false, false);
+            }
+            return true;
+        };
+        sink.is_writable = [&]() {
+            {
+                std::lock_guard lock(window.mutex);
+                if (window.closed) {
+                    return false;
+                }
+            }
+            return !client_gone();
+        };
+        sink.done = [&]() { done = true; };
+        while (!done) {
+            if (!res.content_provider(offset, sink)) {
+                failed = true;
+                break;
             }
-        } else {
-            res.status = 405;
-            res.set_content("{\"error\":\"Method Not Allowed\"}", "application/json");
         }
-
-        if (res.content_type.empty()) {
-            res.content_type = "text/plain";
+        if (!failed) {
+            batch += "0\r\n\r\n";
         }
-
-        std::ostringstream response;
-        response << "HTTP/1.1 " << res.status << " " << ReasonPhrase(res.status) << "\r\n";
-        response << "Content-Type: " << res.content_type << "\r\n";
-        response << "Content-Length: " << res.body.size() << "\r\n";
-        response << "Connection: close\r\n\r\n";
-        response << res.body;
-        const auto payload = response.str();
-        (void)::send(client_fd, payload.data(), payload.size(), 0);
+        hand_over(true, failed || !keep_alive);
     }
 #endif
 
     std::vector<Route> get_routes_;
     std::vector<Route> post_routes_;
-    // True while listen() should continue accepting new connections.
+    HandlerWithResponse pre_routing_handler_;
+    // True while the reactors should keep running.
     std::atomic<bool> running_{false};
-    // Listening socket descriptor; -1 means no active listener.
-    int server_fd_{-1};
-    // Bound port used by stop() to wake accept(); 0 before listen() starts.
-    int listen_port_{0};
+#if defined(__linux__)
+    // Guards creation and teardown of `reactors_` against a concurrent stop().
+    std::mutex lifecycle_mutex_;
+    std::vector<std::unique_ptr<Reactor>> reactors_;
+    std::unique_ptr<TaskQueue> task_queue_;
+#endif
+    std::size_t keep_alive_max_count_{CPPHTTPLIB_KEEPALIVE_MAX_COUNT};
+    std::size_t payload_max_length_{CPPHTTPLIB_PAYLOAD_MAX_LENGTH};
+    std::chrono::seconds keep_alive_timeout_{CPPHTTPLIB_KEEPALIVE_TIMEOUT_SECOND};
 };
 
 }  // namespace httplib
@@ -0,0 +1,60 @@
+#include "src/http/json_writer.h"
+
+#include <array>
+
+#include "src/domain/audit_json.h"
+#include "src/util/json_dump.h"
+#include "src/util/json_writer.h"
+
+namespace encounter_service::http {
+
+namespace {
+
+using util::AppendJsonObject;
+using util::AppendJsonString;
+using util::AppendJsonTimestamp;
+using util::JsonField;
+
+void AppendJsonValue(std::string& out, const nlohmann::json& value) {
+    util::AppendJsonDump(out, value);
+}
+
+constexpr std::array<JsonField<domain::EncounterMetadata>, 3> kMetadataFields{{
+    {"\"createdAt\":",
+     [](std::string& out, const domain::EncounterMetadata& m) { AppendJsonTimestamp(out, m.createdAt); }},
+    {"\"createdBy\":",
+     [](std::string& out, const domain::EncounterMetadata& m) { AppendJsonString(out, m.createdBy); }},
+    {"\"updatedAt\":",
+     [](std::string& out, const domain::EncounterMetadata& m) { AppendJsonTimestamp(out, m.updatedAt); }},
+}};
+static_assert(util::JsonKeysSorted(kMetadataFields));
+
+constexpr std::array<JsonField<domain::Encounter>, 7> kEncounterFields{{
+    {"\"clinicalData\":",
+     [](std::string& out, const domain::Encounter& e) { AppendJsonValue(out, e.clinicalData); }},
+    {"\"encounterDate\":",
+     [](std::string& out, const domain::Encounter& e) { AppendJsonTimestamp(out, e.encounterDate); }},
+    {"\"encounterId\":",
+     [](std::string& out, const domain::Encounter& e) { AppendJsonString(out, e.encounterId); }},
+    {"\"encounterType\":",
+     [](std::string& out, const domain::Encounter& e) { AppendJsonString(out, e.encounterType); }},
+    {"\"metadata\":",
+     [](std::string& out, const domain::Encounter& e) { AppendJsonObject(out, e.metadata, kMetadataFields); }},
+    {"\"patientId\":",
+     [](std::string& out, const domain::Encounter& e) { AppendJsonString(out, e.patientId); }},
+    {"\"providerId\":",
+     [](std::string& out, const domain::Encounter& e) { AppendJsonString(out, e.providerId); }},
+}};
+static_assert(util::JsonKeysSorted(kEncounterFields));
+
+}  // namespace
+
+void AppendEncounterJson(std::string& out, const domain::Encounter& encounter) {
+    AppendJsonObject(out, encounter, kEncounterFields);
+}
+
+void AppendAuditEntryJson(std::string& out, const domain::AuditEntry& entry) {
+    domain::AppendAuditEntryJsonObject(out, entry);
+}
+
+}  // namespace encounter_service::http
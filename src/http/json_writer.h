@@ -0,0 +1,21 @@
+#pragma once
+
+#include <string>
+
+#include "src/domain/audit_models.h"
+#include "src/domain/encounter_models.h"
+
+namespace encounter_service::http {
+
+// Direct-to-buffer JSON serialization for response models. Each function appends to `out`, so one
+// buffer can be reused across records, and produces the same bytes as building the equivalent
+// nlohmann::json object and calling dump(): keys in sorted order, no whitespace, same escaping.
+// Strings and other scalars go through util/json_writer.h.
+
+// Appends `{"clinicalData":...,"encounterDate":...,...,"metadata":{...},...}`.
+void AppendEncounterJson(std::string& out, const domain::Encounter& encounter);
+
+// Appends `{"action":...,"actor":...,"encounterId":...,"timestamp":...}`.
+void AppendAuditEntryJson(std::string& out, const domain::AuditEntry& entry);
+
+}  // namespace encounter_service::http
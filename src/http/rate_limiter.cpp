@@ -0,0 +1,99 @@
+#include "src/http/rate_limiter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <mutex>
+
+namespace encounter_service::http {
+
+namespace {
+
+// Shards smaller than this are not swept.
+constexpr std::size_t kMinSweepSize = 64;
+
+}  // namespace
+
+RateLimiter::RateLimiter(RateLimitOptions options)
+    : shardCount_(std::max<std::size_t>(options.shardCount, 1)) {
+    for (std::size_t i = 0; i < kRouteClassCount; ++i) {
+        const auto& limit = options.limits[i];
+        if (limit.ratePerSecond <= 0) {
+            continue;
+        }
+        emissionInterval_[i] = std::max<std::int64_t>(1, std::llround(1e9 / limit.ratePerSecond));
+        burstTolerance_[i] = std::llround(std::max(limit.burst - 1.0, 0.0) * static_cast<double>(emissionInterval_[i]));
+    }
+    shards_ = std::make_unique<Shard[]>(shardCount_);
+}
+
+RateLimitDecision RateLimiter::Allow(const std::string& actor, RouteClass routeClass) {
+    return AllowAt(actor, routeClass, std::chrono::steady_clock::now());
+}
+
+RateLimitDecision RateLimiter::AllowAt(const std::string& actor,
+                                       RouteClass routeClass,
+                                       std::chrono::steady_clock::time_point now) {
+    const auto index = static_cast<std::size_t>(routeClass);
+    if (emissionInterval_[index] == 0) {
+        return RateLimitDecision{};
+    }
+
+    const std::int64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+    auto& shard = shards_[std::hash<std::string>{}(actor) % shardCount_];
+    {
+        // Held while the bucket is touched so a concurrent sweep cannot free it.
+        std::shared_lock lock(shard.mutex);
+        if (const auto it = shard.actors.find(actor); it != shard.actors.end()) {
+            return Consume(it->second->tat[index], index, nowNs);
+        }
+    }
+    std::unique_lock lock(shard.mutex);
+    auto it = shard.actors.find(actor);
+    if (it == shard.actors.end()) {
+        if (shard.actors.size() >= shard.sweepAt) {
+            SweepIdleLocked(shard, nowNs);
+            shard.sweepAt = std::max(kMinSweepSize, shard.actors.size() * 2);
+        }
+        it = shard.actors.emplace(actor, std::make_unique<ActorBuckets>()).first;
+    }
+    return Consume(it->second->tat[index], index, nowNs);
+}
+
+std::size_t RateLimiter::trackedActors() const {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < shardCount_; ++i) {
+        std::shared_lock lock(shards_[i].mutex);
+        count += shards_[i].actors.size();
+    }
+    return count;
+}
+
+RateLimitDecision RateLimiter::Consume(std::atomic<std::int64_t>& tat, std::size_t index, std::int64_t nowNs) const {
+    const auto interval = emissionInterval_[index];
+    auto observed = tat.load(std::memory_order_relaxed);
+    for (;;) {
+        // An idle bucket refills to full burst: arrival time never lags behind `now`.
+        const auto arrival = std::max(observed, nowNs);
+        const auto ahead = arrival - nowNs;
+        if (ahead > burstTolerance_[index]) {
+            return RateLimitDecision{
+                .allowed = false,
+                .retryAfter = std::chrono::nanoseconds{ahead - burstTolerance_[index]},
+            };
+        }
+        if (tat.compare_exchange_weak(observed, arrival + interval, std::memory_order_relaxed)) {
+            return RateLimitDecision{};
+        }
+    }
+}
+
+void RateLimiter::SweepIdleLocked(Shard& shard, std::int64_t nowNs) {
+    std::erase_if(shard.actors, [nowNs](const auto& entry) {
+        return std::all_of(entry.second->tat.begin(), entry.second->tat.end(), [nowNs](const auto& tat) {
+            return tat.load(std::memory_order_relaxed) <= nowNs;
+        });
+    });
+}
+
+}  // namespace encounter_service::http
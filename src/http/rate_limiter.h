@@ -0,0 +1,90 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+#include "src/http/route_class.h"
+
+namespace encounter_service::http {
+
+struct TokenBucketOptions {
+    // Sustained requests per second. A non-positive rate disables the limit for the class.
+    double ratePerSecond{50.0};
+    // Requests that may be made back-to-back after an idle period.
+    double burst{100.0};
+};
+
+struct RateLimitOptions {
+    // Indexed by RouteClass. List scans and audit queries get much smaller budgets than point reads.
+    std::array<TokenBucketOptions, kRouteClassCount> limits{
+        TokenBucketOptions{.ratePerSecond = 50.0, .burst = 100.0},  // Read
+        TokenBucketOptions{.ratePerSecond = 20.0, .burst = 40.0},   // Write
+        TokenBucketOptions{.ratePerSecond = 2.0, .burst = 5.0},     // Audit
+        TokenBucketOptions{.ratePerSecond = 5.0, .burst = 10.0},    // List
+    };
+    // Independent actor-map shards; new actors only contend with others hashed to the same shard.
+    std::size_t shardCount{32};
+};
+
+struct RateLimitDecision {
+    bool allowed{true};
+    // When rejected, how long until the next request of this class would be allowed.
+    std::chrono::nanoseconds retryAfter{0};
+};
+
+// Per-actor, per-route-class token buckets. Each bucket is a single atomic "theoretical arrival
+// time" (the GCRA formulation of a token bucket) updated with a CAS loop, so checks for known
+// actors never block: they hold a shared shard lock while they find the bucket and touch one atomic.
+// The exclusive shard lock is only taken the first time an actor is seen. A bucket whose arrival
+// times have all caught up with the clock is indistinguishable from a new one, so when a shard's
+// map has doubled since its last sweep, inserting the next actor first drops every such idle
+// bucket. Keys that stop sending (or are used once) therefore do not accumulate.
+class RateLimiter {
+public:
+    explicit RateLimiter(RateLimitOptions options = {});
+
+    RateLimiter(const RateLimiter&) = delete;
+    RateLimiter& operator=(const RateLimiter&) = delete;
+
+    // Consumes one token for `actor` in `routeClass`, or reports how long to wait when none is left.
+    [[nodiscard]] RateLimitDecision Allow(const std::string& actor, RouteClass routeClass);
+    // Same as Allow() with an explicit monotonic `now`, for deterministic tests.
+    [[nodiscard]] RateLimitDecision AllowAt(const std::string& actor,
+                                            RouteClass routeClass,
+                                            std::chrono::steady_clock::time_point now);
+    // Number of actors currently holding buckets.
+    [[nodiscard]] std::size_t trackedActors() const;
+
+private:
+    struct ActorBuckets {
+        // Theoretical arrival time per route class, in steady_clock nanoseconds.
+        std::array<std::atomic<std::int64_t>, kRouteClassCount> tat{};
+    };
+
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<std::string, std::unique_ptr<ActorBuckets>> actors;
+        // Map size at which the next insertion sweeps idle buckets first.
+        std::size_t sweepAt{0};
+    };
+
+    // Consumes one token from `tat` or reports the wait; the caller keeps the bucket alive.
+    RateLimitDecision Consume(std::atomic<std::int64_t>& tat, std::size_t index, std::int64_t nowNs) const;
+    // Drops buckets with no arrival time past `nowNs`. Requires the shard's exclusive lock.
+    static void SweepIdleLocked(Shard& shard, std::int64_t nowNs);
+
+    // Nanoseconds between tokens and the burst allowance per class, precomputed from the options.
+    std::array<std::int64_t, kRouteClassCount> emissionInterval_{};
+    std::array<std::int64_t, kRouteClassCount> burstTolerance_{};
+    std::size_t shardCount_{0};
+    std::unique_ptr<Shard[]> shards_;
+};
+
+}  // namespace encounter_service::http
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+
+namespace encounter_service::http {
+
+// Groups routes that share admission and rate limits. `/health` belongs to no class and is never
+// limited, so probes keep answering under load.
+enum class RouteClass : std::size_t {
+    Read = 0,   // GET /encounters/{id}, POST /encounters:batchGet
+    Write = 1,  // POST /encounters
+    Audit = 2,  // GET /audit/encounters*
+    List = 3,   // GET /encounters (filtered scans)
+};
+
+inline constexpr std::size_t kRouteClassCount = 4;
+
+}  // namespace encounter_service::http
@@ -0,0 +1,243 @@
+#include "src/http/router.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace encounter_service::http {
+
+struct Router::Node {
+    // Literal children, sorted by segment.
+    std::vector<std::pair<std::string, std::unique_ptr<Node>>> literals;
+    // At most one parameter child per position.
+    std::unique_ptr<Node> param;
+    std::string paramName;
+    PathParamType paramType{PathParamType::Segment};
+    // Handlers for paths ending at this node, by method.
+    std::vector<std::pair<std::string, Handler>> handlers;
+};
+
+namespace {
+
+bool Accepts(PathParamType type, std::string_view segment) {
+    if (segment.empty()) {
+        return false;
+    }
+    switch (type) {
+        case PathParamType::Slug:
+            return std::all_of(segment.begin(), segment.end(), [](char ch) {
+                return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9') ||
+                       ch == '_' || ch == '-';
+            });
+        case PathParamType::Integer:
+            return std::all_of(segment.begin(), segment.end(), [](char ch) { return ch >= '0' && ch <= '9'; });
+        case PathParamType::Segment:
+            return true;
+    }
+    return false;
+}
+
+// Splits "/a/b" into its first segment ("a") and the rest ("/b"). Requires a leading '/'.
+std::pair<std::string_view, std::string_view> NextSegment(std::string_view path) {
+    path.remove_prefix(1);
+    const auto slash = path.find('/');
+    if (slash == std::string_view::npos) {
+        return {path, {}};
+    }
+    return {path.substr(0, slash), path.substr(slash)};
+}
+
+}  // namespace
+
+std::string_view PathParams::Get(std::string_view name) const {
+    for (std::size_t i = 0; i < size_; ++i) {
+        if (values_[i].first == name) {
+            return values_[i].second;
+        }
+    }
+    return {};
+}
+
+Router::Router()
+    : root_(std::make_unique<Node>()) {}
+
+Router::~Router() = default;
+
+void Router::Add(std::string_view method, std::string_view pattern, Handler handler) {
+    if (pattern.empty() || pattern.front() != '/') {
+        throw std::invalid_argument("route pattern must start with '/': " + std::string(pattern));
+    }
+
+    Node* node = root_.get();
+    std::size_t params = 0;
+    for (auto rest = pattern; !rest.empty();) {
+        const auto [segment, next] = NextSegment(rest);
+        rest = next;
+
+        if (segment.size() >= 2 && segment.front() == '{' && segment.back() == '}') {
+            const auto spec = segment.substr(1, segment.size() - 2);
+            const auto colon = spec.find(':');
+            const auto name = spec.substr(0, colon);
+            const auto typeName = colon == std::string_view::npos ? std::string_view{} : spec.substr(colon + 1);
+            PathParamType type = PathParamType::Segment;
+            if (typeName == "slug") {
+                type = PathParamType::Slug;
+            } else if (typeName == "int") {
+                type = PathParamType::Integer;
+            } else if (!typeName.empty()) {
+                throw std::invalid_argument("unknown path parameter type in route: " + std::string(pattern));
+            }
+            if (name.empty() || ++params > PathParams::kMaxParams) {
+                throw std::invalid_argument("invalid path parameter in route: " + std::string(pattern));
+            }
+
+            if (!node->param) {
+                node->param = std::make_unique<Node>();
+                node->paramName = std::string(name);
+                node->paramType = type;
+            } else if (node->paramName != name || node->paramType != type) {
+                throw std::invalid_argument("conflicting path parameter in route: " + std::string(pattern));
+            }
+            node = node->param.get();
+            continue;
+        }
+
+        auto it = std::lower_bound(node->literals.begin(), node->literals.end(), segment,
+                                   [](const auto& entry, std::string_view key) { return entry.first < key; });
+        if (it == node->literals.end() || it->first != segment) {
+            it = node->literals.emplace(it, std::string(segment), std::make_unique<Node>());
+        }
+        node = it->second.get();
+    }
+
+    const auto existing = std::find_if(node->handlers.begin(), node->handlers.end(),
+                                       [method](const auto& entry) { return entry.first == method; });
+    if (existing != node->handlers.end()) {
+        throw std::invalid_argument("route registered twice: " + std::string(method) + " " + std::string(pattern));
+    }
+    node->handlers.emplace_back(std::string(method), std::move(handler));
+}
+
+namespace {
+
+template <typename Node, typename Handler>
+const Handler* Match(const Node& node,
+                     std::string_view method,
+                     std::string_view rest,
+                     std::array<std::pair<std::string_view, std::string_view>, PathParams::kMaxParams>& values,
+                     std::size_t& size) {
+    if (rest.empty()) {
+        const Handler* get = nullptr;
+        for (const auto& [registered, handler] : node.handlers) {
+            if (registered == method) {
+                return &handler;
+            }
+            if (registered == "GET") {
+                get = &handler;
+            }
+        }
+        return method == "HEAD" ? get : nullptr;
+    }
+
+    const auto [segment, next] = NextSegment(rest);
+    const auto it = std::lower_bound(node.literals.begin(), node.literals.end(), segment,
+                                     [](const auto& entry, std::string_view key) { return entry.first < key; });
+    if (it != node.literals.end() && it->first == segment) {
+        if (const auto* handler = Match<Node, Handler>(*it->second, method, next, values, size)) {
+            return handler;
+        }
+    }
+
+    if (node.param && Accepts(node.paramType, segment)) {
+        values[size++] = {node.paramName, segment};
+        if (const auto* handler = Match<Node, Handler>(*node.param, method, next, values, size)) {
+            return handler;
+        }
+        --size;
+    }
+    return nullptr;
+}
+
+}  // namespace
+
+bool Router::Dispatch(const httplib::Request& req, httplib::Response& res) const {
+    const std::string_view path = req.path;
+    if (path.empty() || path.front() != '/') {
+        return false;
+    }
+
+    PathParams params;
+    const auto* handler = Match<Node, Handler>(*root_, req.method, path, params.values_, params.size_);
+    if (handler == nullptr) {
+        return false;
+    }
+    (*handler)(req, res, params);
+    return true;
+}
+
+std::vector<std::size_t> Router::SegmentCounts(std::string_view method) const {
+    std::vector<std::size_t> counts;
+    const auto visit = [&counts, method](const auto& self, const Node& node, std::size_t depth) -> void {
+        for (const auto& [registered, handler] : node.handlers) {
+            if (registered == method) {
+                counts.push_back(depth);
+            }
+        }
+        for (const auto& [segment, child] : node.literals) {
+            self(self, *child, depth + 1);
+        }
+        if (node.param) {
+            self(self, *node.param, depth + 1);
+        }
+    };
+    visit(visit, *root_, 0);
+    std::sort(counts.begin(), counts.end());
+    counts.erase(std::unique(counts.begin(), counts.end()), counts.end());
+    return counts;
+}
+
+namespace {
+
+// cpp-httplib runs the pre-routing handler before it reads the request body, so requests that
+// carry one are routed after the body has arrived instead. The fallback server reads the whole
+// request first, so this is always false there.
+bool BodyPending(const httplib::Request& req) {
+    if (!req.body.empty()) {
+        return false;
+    }
+    if (req.has_header("Transfer-Encoding")) {
+        return true;
+    }
+    const auto length = req.get_header_value("Content-Length");
+    return !length.empty() && length != "0";
+}
+
+}  // namespace
+
+void InstallRouter(httplib::Server& server, std::shared_ptr<const Router> router) {
+    server.set_pre_routing_handler([router](const httplib::Request& req, httplib::Response& res) {
+        if (BodyPending(req)) {
+            return httplib::Server::HandlerResponse::Unhandled;
+        }
+        return router->Dispatch(req, res) ? httplib::Server::HandlerResponse::Handled
+                                          : httplib::Server::HandlerResponse::Unhandled;
+    });
+#if __has_include("vendor/httplib.h")
+    // `/:s0/:s1` matches any two-segment path without std::regex; the router then picks the route.
+    for (const auto count : router->SegmentCounts("POST")) {
+        std::string pattern;
+        for (std::size_t i = 0; i < count; ++i) {
+            pattern += "/:s" + std::to_string(i);
+        }
+        if (pattern.empty()) {
+            continue;
+        }
+        server.Post(pattern, [router](const httplib::Request& req, httplib::Response& res) {
+            if (!router->Dispatch(req, res)) {
+                res.status = 404;
+            }
+        });
+    }
+#endif
+}
+
+}  // namespace encounter_service::http
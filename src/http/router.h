@@ -0,0 +1,101 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "src/http/httplib_compat.h"
+
+namespace encounter_service::http {
+
+// Values captured from `{name:type}` pattern segments, viewing the request path.
+class PathParams {
+public:
+    static constexpr std::size_t kMaxParams = 4;
+
+    // Captured value for `name`, or an empty view when the route has no such parameter.
+    [[nodiscard]] std::string_view Get(std::string_view name) const;
+    [[nodiscard]] std::size_t size() const { return size_; }
+
+private:
+    friend class Router;
+
+    std::array<std::pair<std::string_view, std::string_view>, kMaxParams> values_{};
+    std::size_t size_{0};
+};
+
+enum class PathParamType {
+    // One or more of [A-Za-z0-9_-].
+    Slug,
+    // One or more ASCII digits.
+    Integer,
+    // Any non-empty segment.
+    Segment,
+};
+
+// Routes requests through a trie of path segments instead of trying a std::regex per route.
+// Patterns are `/`-separated literal segments or typed parameters, `{name:slug}`, `{name:int}` or
+// `{name}` (any segment). Matching walks the path once, prefers literal segments over parameters,
+// and does not allocate.
+class Router {
+public:
+    using Handler = std::function<void(const httplib::Request&, httplib::Response&, const PathParams&)>;
+
+    Router();
+    ~Router();
+    Router(const Router&) = delete;
+    Router& operator=(const Router&) = delete;
+
+    // Throws std::invalid_argument for a malformed pattern, a route registered twice, or two
+    // differently named or typed parameters at the same position.
+    void Add(std::string_view method, std::string_view pattern, Handler handler);
+
+    // Handlers may omit the PathParams argument.
+    template <typename F>
+    void Get(std::string_view pattern, F handler) {
+        Add("GET", pattern, Adapt(std::move(handler)));
+    }
+
+    template <typename F>
+    void Post(std::string_view pattern, F handler) {
+        Add("POST", pattern, Adapt(std::move(handler)));
+    }
+
+    // Runs the handler registered for the request's method and path; HEAD falls back to the GET
+    // handler. Returns false when none matches.
+    bool Dispatch(const httplib::Request& req, httplib::Response& res) const;
+
+    // Segment counts of the patterns registered for `method`, ascending and without duplicates.
+    [[nodiscard]] std::vector<std::size_t> SegmentCounts(std::string_view method) const;
+
+private:
+    struct Node;
+
+    template <typename F>
+    static Handler Adapt(F handler) {
+        if constexpr (std::is_invocable_v<F&, const httplib::Request&, httplib::Response&, const PathParams&>) {
+            return Handler(std::move(handler));
+        } else {
+            return [handler = std::move(handler)](const httplib::Request& req,
+                                                  httplib::Response& res,
+                                                  const PathParams&) { handler(req, res); };
+        }
+    }
+
+    std::unique_ptr<Node> root_;
+};
+
+// Makes `router` answer the requests it matches on `server`. Body-less requests are dispatched from
+// the pre-routing hook, ahead of any std::regex route. cpp-httplib reads a POST body only after that
+// hook, so POSTs with one are picked up by one `/:s0/.../:sN` route per registered segment count,
+// which httplib matches segment by segment rather than with std::regex. Unmatched body-less requests
+// fall through to the server's own routes; unmatched POSTs get 404.
+void InstallRouter(httplib::Server& server, std::shared_ptr<const Router> router);
+
+}  // namespace encounter_service::http
@@ -1,13 +1,26 @@
 #include "src/http/routes.h"
 
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 #include <variant>
+#include <vector>
 
 #include "src/http/auth.h"
+#include "src/http/compression.h"
 #include "src/http/error_mapper.h"
+#include "src/http/etag.h"
+#include "src/http/json_writer.h"
 #include "src/http/validation.h"
 #include "src/util/json_compat.h"
+#include "src/util/json_writer.h"
+#include "src/util/request_context.h"
 #include "src/util/time.h"
 
 namespace encounter_service::http {
@@ -18,9 +31,19 @@ constexpr const char* kMethodGet = "GET";
 constexpr const char* kMethodPost = "POST";
 constexpr const char* kPathHealth = "/health";
 constexpr const char* kPathEncounters = "/encounters";
-constexpr const char* kPathEncounterByIdPattern = R"(/encounters/([A-Za-z0-9_-]+))";
+constexpr const char* kPathEncountersBatchGet = "/encounters:batchGet";
+constexpr const char* kPathEncounterByIdPattern = "/encounters/{encounterId:slug}";
 constexpr const char* kPathEncounterByIdLog = "/encounters/:encounterId";
 constexpr const char* kPathAuditEncounters = "/audit/encounters";
+constexpr const char* kPathAuditRollups = "/audit/encounters/rollups";
+constexpr const char* kPathAuditHistory = "/audit/encounters/history";
+constexpr const char* kHeaderRequestTimeout = "X-Request-Timeout-Ms";
+// Longer client timeouts are clamped so `now + timeout` cannot overflow the clock's range.
+constexpr std::int64_t kMaxRequestTimeoutMs = std::int64_t{24} * 60 * 60 * 1000;
+// Encounters serialized between deadline checks.
+constexpr std::uint32_t kSerializeCheckInterval = 64;
+// Serialized bytes buffered before a streamed list response writes a chunk.
+constexpr std::size_t kStreamChunkBytes = 16 * 1024;
 
 std::optional<std::string> GetRequestId(const httplib::Request& req) {
     if (!req.has_header("X-Request-Id")) {
@@ -62,11 +85,98 @@ void LogHttpResult(util::Logger& logger,
     logger.Log(util::LogLevel::Info, redacted.dump());
 }
 
-std::optional<std::string> RegexCaptureEncounterId(const httplib::Request& req) {
-    if (req.matches.size() < 2) {
-        return std::nullopt;
+// Returns a ticket to hold for the rest of the handler, or writes a 503 with `Retry-After` and
+// returns std::nullopt when `routeClass` is over its limit. A null controller admits everything.
+std::optional<AdmissionTicket> Admit(AdmissionController* admission,
+                                     RouteClass routeClass,
+                                     const std::optional<std::string>& requestId,
+                                     httplib::Response& res) {
+    if (admission == nullptr) {
+        return AdmissionTicket{};
+    }
+    auto ticket = admission->TryAdmit(routeClass);
+    if (!ticket) {
+        res.set_header("Retry-After", std::to_string(admission->retryAfter().count()));
+        WriteDomainError(res,
+                         domain::DomainError{.code = domain::DomainErrorCode::Unavailable,
+                                            .message = "Service overloaded, retry later",
+                                            .details = std::nullopt},
+                         requestId);
+    }
+    return ticket;
+}
+
+// Body of the `scheduler` object in `GET /health`; wait times are whole microseconds.
+nlohmann::json SchedulerStatsJson(const util::WorkStealingStats& stats) {
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    nlohmann::json body = nlohmann::json::object();
+    body["threads"] = stats.threads;
+    body["queueDepth"] = stats.queueDepth;
+    body["executed"] = stats.executed;
+    body["stolen"] = stats.stolen;
+    body["meanWaitMicros"] = stats.executed == 0 ? 0 : duration_cast<microseconds>(stats.totalWait).count() /
+                                                           static_cast<std::int64_t>(stats.executed);
+    body["maxWaitMicros"] = duration_cast<microseconds>(stats.maxWait).count();
+    return body;
+}
+
+// Returns false after writing a 429 with `Retry-After` when `key` (see RateLimitKey()) has no tokens
+// left for `routeClass`. A null limiter allows everything.
+bool WithinRateLimit(RateLimiter* limiter,
+                     RouteClass routeClass,
+                     const std::string& key,
+                     const std::optional<std::string>& requestId,
+                     httplib::Response& res) {
+    if (limiter == nullptr) {
+        return true;
+    }
+    const auto decision = limiter->Allow(key, routeClass);
+    if (decision.allowed) {
+        return true;
+    }
+    // Whole seconds, rounded up so a client honoring the header is not rejected again.
+    const auto retrySeconds = std::chrono::ceil<std::chrono::seconds>(decision.retryAfter).count();
+    res.set_header("Retry-After", std::to_string(std::max<std::int64_t>(retrySeconds, 1)));
+    WriteDomainError(res,
+                     domain::DomainError{.code = domain::DomainErrorCode::RateLimited,
+                                        .message = "Rate limit exceeded, retry later",
+                                        .details = std::nullopt},
+                     requestId);
+    return false;
+}
+
+// Returns a probe for client disconnects when the HTTP backend exposes one before the response
+// starts (`Request::is_connection_closed`). Only the fallback server in httplib_compat.h does; the
+// vendored cpp-httplib 0.16.3 does not, so there a disconnect is only noticed once the body streams
+// (see `DataSink::is_writable` in SendJsonStream()).
+template <typename RequestT>
+std::function<bool()> DisconnectProbe(const RequestT& req) {
+    if constexpr (requires { req.is_connection_closed(); }) {
+        return [&req]() { return req.is_connection_closed(); };
+    } else {
+        return {};
+    }
+}
+
+// Deadline is the earlier of the client's `X-Request-Timeout-Ms` and `routeDefault` (zero means
+// none). Malformed or non-positive header values are ignored.
+util::RequestContext MakeRequestContext(const httplib::Request& req, std::chrono::milliseconds routeDefault) {
+    const auto now = util::RequestContext::Clock::now();
+    std::optional<util::RequestContext::Clock::time_point> deadline;
+    if (routeDefault.count() > 0) {
+        deadline = now + routeDefault;
+    }
+    if (req.has_header(kHeaderRequestTimeout)) {
+        const auto value = req.get_header_value(kHeaderRequestTimeout);
+        std::int64_t millis = 0;
+        const auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), millis);
+        if (ec == std::errc{} && end == value.data() + value.size() && millis > 0) {
+            const auto requested = now + std::chrono::milliseconds{std::min(millis, kMaxRequestTimeoutMs)};
+            deadline = deadline ? std::min(*deadline, requested) : requested;
+        }
     }
-    return req.matches[1].str();
+    return util::RequestContext(deadline, DisconnectProbe(req));
 }
 
 std::variant<nlohmann::json, domain::DomainError> ParseRequestJson(const httplib::Request& req) {
@@ -97,74 +207,318 @@ std::variant<nlohmann::json, domain::DomainError> ParseRequestJson(const httplib
 #endif
 }
 
-nlohmann::json EncounterToJson(const domain::Encounter& encounter) {
+bool GzipNegotiated(const httplib::Request& req, const CompressionOptions& compression) {
+    return compression.level > 0 && AcceptsGzip(req.get_header_value("Accept-Encoding"));
+}
+
+bool ShouldGzip(const httplib::Request& req, std::size_t bodyBytes, const CompressionOptions& compression) {
+    return bodyBytes >= compression.minBytes && GzipNegotiated(req, compression);
+}
+
+void SetGzipHeaders(httplib::Response& res) {
+    res.set_header("Content-Encoding", "gzip");
+}
+
+// Sends a serialized JSON body, gzip-encoded when the client accepts it and the body reaches
+// `compression.minBytes`. `Vary` is set either way so shared caches key on the negotiated encoding.
+void WriteJsonBody(const httplib::Request& req,
+                   httplib::Response& res,
+                   int status,
+                   std::string body,
+                   const CompressionOptions& compression) {
+    res.status = status;
+    res.set_header("Vary", "Accept-Encoding");
+    if (ShouldGzip(req, body.size(), compression)) {
+        SetGzipHeaders(res);
+        res.set_content(GzipCompress(body, compression.level), "application/json");
+        return;
+    }
+    res.set_content(std::move(body), "application/json");
+}
+
+// Strong validators must differ between content codings, so a gzip body carries the `-gzip`
+// variant of the encounter's tag.
+void SetEncounterEtag(httplib::Response& res, const domain::Encounter& encounter) {
+    if (encounter.etag.empty()) {
+        return;
+    }
+    const bool gzip = res.get_header_value("Content-Encoding") == "gzip";
+    res.set_header("ETag", gzip ? EncodedVariantEtag(encounter.etag, "gzip") : encounter.etag);
+}
+
+// Answers a conditional GET whose validator still matches: no body, just the matched tag.
+void WriteNotModified(httplib::Response& res, const std::string& etag) {
+    res.status = 304;
+    res.set_header("ETag", etag);
+    res.set_header("Vary", "Accept-Encoding");
+}
+
+// Serves an immutable shared body (e.g. a cached gzip encounter) without copying it into the response.
+void SetSharedContent(httplib::Response& res, std::shared_ptr<const std::string> body, const std::string& type) {
+    const auto length = body->size();
+    res.set_content_provider(length, type,
+                             [body = std::move(body)](std::size_t offset, std::size_t size, httplib::DataSink& sink) {
+                                 return sink.write(body->data() + offset, size);
+                             });
+}
+
+// Encounters never change once created, so their gzip body can be cached under the encounter ID;
+// a cache hit skips serialization as well as compression.
+void WriteEncounter(const httplib::Request& req,
+                    httplib::Response& res,
+                    int status,
+                    const domain::Encounter& encounter,
+                    const RouteOptions& options) {
+    auto* cache = options.compressedEncounters;
+    if (cache != nullptr && GzipNegotiated(req, options.compression)) {
+        if (const auto cached = cache->Find(encounter.encounterId)) {
+            res.status = status;
+            res.set_header("Vary", "Accept-Encoding");
+            SetGzipHeaders(res);
+            SetSharedContent(res, cached, "application/json");
+            SetEncounterEtag(res, encounter);
+            return;
+        }
+    }
+
+    std::string body;
+    AppendEncounterJson(body, encounter);
+    if (cache != nullptr && ShouldGzip(req, body.size(), options.compression)) {
+        auto compressed = std::make_shared<const std::string>(GzipCompress(body, options.compression.level));
+        cache->Insert(encounter.encounterId, compressed);
+        res.status = status;
+        res.set_header("Vary", "Accept-Encoding");
+        SetGzipHeaders(res);
+        SetSharedContent(res, std::move(compressed), "application/json");
+        SetEncounterEtag(res, encounter);
+        return;
+    }
+    WriteJsonBody(req, res, status, std::move(body), options.compression);
+    SetEncounterEtag(res, encounter);
+}
+
+// Serializes batch results in request order; unknown IDs carry a per-item not_found error.
+std::string BatchGetToJson(const std::vector<std::string>& ids,
+                           const std::vector<std::optional<domain::Encounter>>& encounters) {
+    std::string out = "{\"results\":[";
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        if (i > 0) {
+            out += ',';
+        }
+        if (i < encounters.size() && encounters[i]) {
+            out += "{\"encounter\":";
+            AppendEncounterJson(out, *encounters[i]);
+            out += ",\"encounterId\":";
+            util::AppendJsonString(out, ids[i]);
+            out += '}';
+        } else {
+            out += "{\"encounterId\":";
+            util::AppendJsonString(out, ids[i]);
+            out += ",\"error\":{\"code\":\"not_found\",\"message\":\"Encounter not found\"}}";
+        }
+    }
+    out += "]}";
+    return out;
+}
+
+nlohmann::json AuditRollupToJson(const domain::AuditRollup& rollup) {
     nlohmann::json json = nlohmann::json::object();
-    json["encounterId"] = encounter.encounterId;
-    json["patientId"] = encounter.patientId;
-    json["providerId"] = encounter.providerId;
-    json["encounterDate"] = util::FormatIso8601Utc(encounter.encounterDate);
-    json["encounterType"] = encounter.encounterType;
-    json["clinicalData"] = encounter.clinicalData;
-
-    nlohmann::json metadata = nlohmann::json::object();
-    metadata["createdAt"] = util::FormatIso8601Utc(encounter.metadata.createdAt);
-    metadata["updatedAt"] = util::FormatIso8601Utc(encounter.metadata.updatedAt);
-    metadata["createdBy"] = encounter.metadata.createdBy;
-    json["metadata"] = metadata;
+    // Rollups are day-granular; emit only the `YYYY-MM-DD` date part.
+    json["day"] = util::FormatIso8601Utc(rollup.day).substr(0, 10);
+    json["actor"] = rollup.actor;
+    json["action"] = domain::AuditActionName(rollup.action);
+    json["count"] = rollup.count;
     return json;
 }
 
-nlohmann::json AuditEntryToJson(const domain::AuditEntry& entry) {
-    nlohmann::json json = nlohmann::json::object();
-    json["timestamp"] = util::FormatIso8601Utc(entry.timestamp);
-    json["actor"] = entry.actor;
-    json["encounterId"] = entry.encounterId;
-    switch (entry.action) {
-        case domain::AuditAction::READ_ENCOUNTER:
-            json["action"] = "READ_ENCOUNTER";
-            break;
-        case domain::AuditAction::CREATE_ENCOUNTER:
-            json["action"] = "CREATE_ENCOUNTER";
-            break;
+// Sends the JSON body produced by `fill`, which replaces its argument with the next batch of about
+// kStreamChunkBytes and returns true once the body is complete. The first batch is produced up
+// front: if it is the whole body it goes out as an ordinary body (compressed past the threshold).
+// Otherwise the rest streams with chunked transfer encoding, one reused buffer per provider call,
+// and gzip applied incrementally when the client accepts it (streamed bodies are always past any
+// sensible threshold). util::RequestCancelled thrown while producing the first batch propagates to
+// the caller; once the 200 status has been sent it aborts the connection instead. `ticket` is held
+// until the body has been produced, so streaming responses keep counting against admission.
+void SendJsonStream(const httplib::Request& req,
+                    httplib::Response& res,
+                    std::function<bool(std::string& buffer)> fill,
+                    const CompressionOptions& compression,
+                    AdmissionTicket ticket = {}) {
+    struct StreamState {
+        std::function<bool(std::string&)> fill;
+        std::optional<AdmissionTicket> ticket;
+        bool finished{false};
+        // The batch in `buffer` was filled before streaming started and is not yet sent.
+        bool primed{true};
+        std::string buffer;
+        std::unique_ptr<GzipEncoder> encoder;
+        std::string compressed;
+    };
+    auto state = std::make_shared<StreamState>();
+    state->fill = std::move(fill);
+    state->ticket.emplace(std::move(ticket));
+    state->finished = state->fill(state->buffer);
+    if (state->finished) {
+        WriteJsonBody(req, res, 200, std::move(state->buffer), compression);
+        return;
     }
-    return json;
+
+    res.status = 200;
+    res.set_header("Vary", "Accept-Encoding");
+    if (GzipNegotiated(req, compression)) {
+        state->encoder = std::make_unique<GzipEncoder>(compression.level);
+        SetGzipHeaders(res);
+    }
+    res.set_chunked_content_provider("application/json", [state](std::size_t, httplib::DataSink& sink) {
+        auto& stream = *state;
+        // Stop producing batches for a client that has gone away.
+        if (sink.is_writable && !sink.is_writable()) {
+            return false;
+        }
+        if (stream.primed) {
+            stream.primed = false;
+        } else {
+            try {
+                stream.finished = stream.fill(stream.buffer);
+            } catch (const util::RequestCancelled&) {
+                return false;
+            }
+        }
+        const std::string* chunk = &stream.buffer;
+        if (stream.encoder) {
+            stream.compressed.clear();
+            stream.encoder->Write(stream.buffer, stream.compressed);
+            if (stream.finished) {
+                stream.encoder->Finish(stream.compressed);
+            }
+            chunk = &stream.compressed;
+        }
+        // Deflate may hold a whole batch back; an empty write would read as the terminating chunk.
+        if (!chunk->empty() && !sink.write(chunk->data(), chunk->size())) {
+            return false;
+        }
+        if (stream.finished) {
+            sink.done();
+        }
+        return true;
+    });
 }
 
-nlohmann::json EncounterListToJson(const std::vector<domain::Encounter>& encounters) {
-    nlohmann::json arr = nlohmann::json::array();
-    for (const auto& encounter : encounters) {
-        arr.push_back(EncounterToJson(encounter));
+// Streams a JSON array of either owned records, released as they are written, or `shared` records,
+// which stay with their owner and are only read. `context` is checked as records are serialized.
+template <typename Record>
+class JsonArrayStream {
+public:
+    JsonArrayStream(std::vector<Record> owned,
+                    std::shared_ptr<const std::vector<Record>> shared,
+                    void (*append)(std::string& out, const Record& record),
+                    util::RequestContext context)
+        : owned_(std::move(owned)),
+          shared_(std::move(shared)),
+          append_(append),
+          context_(std::move(context)),
+          checkpoint_(context_, kSerializeCheckInterval) {}
+
+    // Replaces `buffer` with the next batch, closing the array after the last record.
+    bool Fill(std::string& buffer) {
+        const auto size = shared_ ? shared_->size() : owned_.size();
+        buffer.clear();
+        if (next_ == 0) {
+            buffer += '[';
+        }
+        while (next_ < size && buffer.size() < kStreamChunkBytes) {
+            checkpoint_.Tick();
+            if (next_ > 0) {
+                buffer += ',';
+            }
+            if (shared_) {
+                append_(buffer, (*shared_)[next_++]);
+            } else {
+                const auto record = std::move(owned_[next_++]);
+                append_(buffer, record);
+            }
+        }
+        if (next_ == size) {
+            buffer += ']';
+            return true;
+        }
+        return false;
     }
-    return arr;
+
+private:
+    std::vector<Record> owned_;
+    std::shared_ptr<const std::vector<Record>> shared_;
+    void (*append_)(std::string& out, const Record& record);
+    util::RequestContext context_;
+    util::CancellationCheckpoint checkpoint_;
+    std::size_t next_{0};
+};
+
+// Sends `records` as a JSON array through SendJsonStream(), releasing each record once written.
+template <typename Record>
+void SendJsonArray(const httplib::Request& req,
+                   httplib::Response& res,
+                   std::vector<Record> records,
+                   void (*append)(std::string& out, const Record& record),
+                   const CompressionOptions& compression,
+                   util::RequestContext context = {},
+                   AdmissionTicket ticket = {}) {
+    auto state = std::make_shared<JsonArrayStream<Record>>(std::move(records), nullptr, append, std::move(context));
+    SendJsonStream(
+        req, res, [state](std::string& buffer) { return state->Fill(buffer); }, compression, std::move(ticket));
+}
+
+// Sends shared, immutable `records` (e.g. a cached query result) without copying them.
+template <typename Record>
+void SendJsonArray(const httplib::Request& req,
+                   httplib::Response& res,
+                   std::shared_ptr<const std::vector<Record>> records,
+                   void (*append)(std::string& out, const Record& record),
+                   const CompressionOptions& compression,
+                   util::RequestContext context = {},
+                   AdmissionTicket ticket = {}) {
+    auto state = std::make_shared<JsonArrayStream<Record>>(
+        std::vector<Record>{}, std::move(records), append, std::move(context));
+    SendJsonStream(
+        req, res, [state](std::string& buffer) { return state->Fill(buffer); }, compression, std::move(ticket));
 }
 
-nlohmann::json AuditListToJson(const std::vector<domain::AuditEntry>& entries) {
+nlohmann::json AuditRollupListToJson(const std::vector<domain::AuditRollup>& rollups) {
     nlohmann::json arr = nlohmann::json::array();
-    for (const auto& entry : entries) {
-        arr.push_back(AuditEntryToJson(entry));
+    for (const auto& rollup : rollups) {
+        arr.push_back(AuditRollupToJson(rollup));
     }
     return arr;
 }
 
 }  // namespace
 
-void RegisterRoutes(httplib::Server& server,
+void RegisterRoutes(Router& router,
                     domain::EncounterService& encounterService,
                     util::Logger& logger,
-                    util::Redactor& redactor) {
+                    util::Redactor& redactor,
+                    const RouteOptions& options) {
     auto* service = &encounterService;
     auto* log = &logger;
     auto* redact = &redactor;
 
-    server.Get(kPathHealth, [log](const httplib::Request&, httplib::Response& res) {
+    router.Get(kPathHealth, [log, options](const httplib::Request&, httplib::Response& res) {
         log->Log(util::LogLevel::Info, "GET /health");
         nlohmann::json body = nlohmann::json::object();
         body["status"] = "ok";
+        if (options.scheduler != nullptr) {
+            body["scheduler"] = SchedulerStatsJson(options.scheduler->stats());
+        }
         WriteJson(res, 200, body);
     });
 
-    server.Post(kPathEncounters, [service, log, redact](const httplib::Request& req, httplib::Response& res) {
+    router.Post(kPathEncounters, [service, log, redact, options](const httplib::Request& req, httplib::Response& res) {
         const auto requestId = GetRequestId(req);
+        const auto admitted = Admit(options.admission, RouteClass::Write, requestId, res);
+        if (!admitted) {
+            LogHttpResult(*log, *redact, kMethodPost, kPathEncounters, requestId, res.status);
+            return;
+        }
 
         const auto auth = Authenticate(req);
         if (std::holds_alternative<domain::DomainError>(auth)) {
@@ -173,68 +527,146 @@ void RegisterRoutes(httplib::Server& server,
             return;
         }
         const auto actor = std::get<std::string>(auth);
-
-        const auto parsedBody = ParseRequestJson(req);
-        if (std::holds_alternative<domain::DomainError>(parsedBody)) {
-            WriteDomainError(res, std::get<domain::DomainError>(parsedBody), requestId);
+        if (!WithinRateLimit(options.rateLimiter, RouteClass::Write, RateLimitKey(req), requestId, res)) {
             LogHttpResult(*log, *redact, kMethodPost, kPathEncounters, requestId, res.status);
             return;
         }
 
-        const auto validation = ValidateCreateEncounterRequest(std::get<nlohmann::json>(parsedBody));
+        // One pass over the raw body validates the envelope and builds only `clinicalData`, which is then
+        // moved through the service and the repository; the repository's returned copy is serialized.
+        auto validation = ParseCreateEncounterRequest(req.body, options.createLimits);
         if (std::holds_alternative<domain::DomainError>(validation)) {
             WriteDomainError(res, std::get<domain::DomainError>(validation), requestId);
             LogHttpResult(*log, *redact, kMethodPost, kPathEncounters, requestId, res.status);
             return;
         }
 
-        const auto serviceResult = service->CreateEncounter(
-            std::get<domain::CreateEncounterInput>(validation), actor);
+        auto serviceResult = service->CreateEncounter(
+            std::get<domain::CreateEncounterInput>(std::move(validation)), actor);
         if (std::holds_alternative<domain::DomainError>(serviceResult)) {
             WriteDomainError(res, std::get<domain::DomainError>(serviceResult), requestId);
             LogHttpResult(*log, *redact, kMethodPost, kPathEncounters, requestId, res.status);
             return;
         }
 
-        WriteJson(res, 201, EncounterToJson(std::get<domain::Encounter>(serviceResult)));
+        WriteEncounter(req, res, 201, std::get<domain::Encounter>(serviceResult), options);
         LogHttpResult(*log, *redact, kMethodPost, kPathEncounters, requestId, res.status);
     });
 
-    server.Get(kPathEncounterByIdPattern, [service, log, redact](const httplib::Request& req, httplib::Response& res) {
+    router.Post(kPathEncountersBatchGet, [service, log, redact, options](const httplib::Request& req,
+                                                                         httplib::Response& res) {
         const auto requestId = GetRequestId(req);
+        const auto admitted = Admit(options.admission, RouteClass::Read, requestId, res);
+        if (!admitted) {
+            LogHttpResult(*log, *redact, kMethodPost, kPathEncountersBatchGet, requestId, res.status);
+            return;
+        }
 
         const auto auth = Authenticate(req);
         if (std::holds_alternative<domain::DomainError>(auth)) {
             WriteDomainError(res, std::get<domain::DomainError>(auth), requestId);
-            LogHttpResult(*log, *redact, kMethodGet, kPathEncounterByIdLog, requestId, res.status);
+            LogHttpResult(*log, *redact, kMethodPost, kPathEncountersBatchGet, requestId, res.status);
             return;
         }
         const auto actor = std::get<std::string>(auth);
+        if (!WithinRateLimit(options.rateLimiter, RouteClass::Read, RateLimitKey(req), requestId, res)) {
+            LogHttpResult(*log, *redact, kMethodPost, kPathEncountersBatchGet, requestId, res.status);
+            return;
+        }
 
-        const auto encounterId = RegexCaptureEncounterId(req);
-        if (!encounterId) {
-            WriteDomainError(res,
-                             domain::DomainError{.code = domain::DomainErrorCode::Internal,
-                                                .message = "Internal error",
-                                                .details = std::nullopt},
-                             requestId);
+        const auto parsedBody = ParseRequestJson(req);
+        if (std::holds_alternative<domain::DomainError>(parsedBody)) {
+            WriteDomainError(res, std::get<domain::DomainError>(parsedBody), requestId);
+            LogHttpResult(*log, *redact, kMethodPost, kPathEncountersBatchGet, requestId, res.status);
+            return;
+        }
+
+        const auto validation = ValidateBatchGetRequest(std::get<nlohmann::json>(parsedBody));
+        if (std::holds_alternative<domain::DomainError>(validation)) {
+            WriteDomainError(res, std::get<domain::DomainError>(validation), requestId);
+            LogHttpResult(*log, *redact, kMethodPost, kPathEncountersBatchGet, requestId, res.status);
+            return;
+        }
+
+        const auto& ids = std::get<std::vector<std::string>>(validation);
+        auto serviceResult = service->BatchGetEncounters(ids, actor);
+        if (std::holds_alternative<domain::DomainError>(serviceResult)) {
+            WriteDomainError(res, std::get<domain::DomainError>(serviceResult), requestId);
+            LogHttpResult(*log, *redact, kMethodPost, kPathEncountersBatchGet, requestId, res.status);
+            return;
+        }
+
+        WriteJsonBody(req,
+                      res,
+                      200,
+                      BatchGetToJson(ids, std::get<std::vector<std::optional<domain::Encounter>>>(serviceResult)),
+                      options.compression);
+        LogHttpResult(*log, *redact, kMethodPost, kPathEncountersBatchGet, requestId, res.status);
+    });
+
+    router.Get(kPathEncounterByIdPattern, [service, log, redact, options](const httplib::Request& req,
+                                                                          httplib::Response& res,
+                                                                          const PathParams& params) {
+        const auto requestId = GetRequestId(req);
+        const auto admitted = Admit(options.admission, RouteClass::Read, requestId, res);
+        if (!admitted) {
+            LogHttpResult(*log, *redact, kMethodGet, kPathEncounterByIdLog, requestId, res.status);
+            return;
+        }
+
+        const auto auth = Authenticate(req);
+        if (std::holds_alternative<domain::DomainError>(auth)) {
+            WriteDomainError(res, std::get<domain::DomainError>(auth), requestId);
+            LogHttpResult(*log, *redact, kMethodGet, kPathEncounterByIdLog, requestId, res.status);
+            return;
+        }
+        const auto actor = std::get<std::string>(auth);
+        if (!WithinRateLimit(options.rateLimiter, RouteClass::Read, RateLimitKey(req), requestId, res)) {
             LogHttpResult(*log, *redact, kMethodGet, kPathEncounterByIdLog, requestId, res.status);
             return;
         }
 
-        const auto serviceResult = service->GetEncounter(*encounterId, actor);
+        const std::string encounterId(params.Get("encounterId"));
+        auto serviceResult = service->GetEncounter(encounterId, actor);
         if (std::holds_alternative<domain::DomainError>(serviceResult)) {
             WriteDomainError(res, std::get<domain::DomainError>(serviceResult), requestId);
             LogHttpResult(*log, *redact, kMethodGet, kPathEncounterByIdLog, requestId, res.status);
             return;
         }
 
-        WriteJson(res, 200, EncounterToJson(std::get<domain::Encounter>(serviceResult)));
+        // The read is still audited; only serialization is skipped when the client's copy is current.
+        const auto& encounter = std::get<domain::Encounter>(serviceResult);
+        if (const auto ifNoneMatch = req.get_header_value("If-None-Match");
+            !ifNoneMatch.empty() && !encounter.etag.empty()) {
+            const auto gzipEtag = EncodedVariantEtag(encounter.etag, "gzip");
+            const bool gzipHit = IfNoneMatchHits(ifNoneMatch, gzipEtag);
+            if (gzipHit || IfNoneMatchHits(ifNoneMatch, encounter.etag)) {
+                WriteNotModified(res, gzipHit ? gzipEtag : encounter.etag);
+                LogHttpResult(*log, *redact, kMethodGet, kPathEncounterByIdLog, requestId, res.status);
+                return;
+            }
+        }
+
+        WriteEncounter(req, res, 200, encounter, options);
         LogHttpResult(*log, *redact, kMethodGet, kPathEncounterByIdLog, requestId, res.status);
     });
 
-    server.Get(kPathEncounters, [service, log, redact](const httplib::Request& req, httplib::Response& res) {
+    // List results carry a weak tag over the repository write generation. Generations restart with
+    // the process, so the tag also names this registration's start time.
+    const auto listEtagInstance =
+        static_cast<std::uint64_t>(std::chrono::system_clock::now().time_since_epoch().count());
+
+    router.Get(kPathEncounters, [service, log, redact, options, listEtagInstance](const httplib::Request& req,
+                                                                                 httplib::Response& res) {
         const auto requestId = GetRequestId(req);
+        // Started before admission so time spent queued counts against the deadline.
+        const auto context =
+            MakeRequestContext(req, options.requestTimeouts[static_cast<std::size_t>(RouteClass::List)]);
+        auto admitted = Admit(options.admission, RouteClass::List, requestId, res);
+        if (!admitted) {
+            LogHttpResult(*log, *redact, kMethodGet, kPathEncounters, requestId, res.status);
+            return;
+        }
 
         const auto auth = Authenticate(req);
         if (std::holds_alternative<domain::DomainError>(auth)) {
@@ -242,7 +674,11 @@ void RegisterRoutes(httplib::Server& server,
             LogHttpResult(*log, *redact, kMethodGet, kPathEncounters, requestId, res.status);
             return;
         }
-        (void)std::get<std::string>(auth);
+        const auto actor = std::get<std::string>(auth);
+        if (!WithinRateLimit(options.rateLimiter, RouteClass::List, RateLimitKey(req), requestId, res)) {
+            LogHttpResult(*log, *redact, kMethodGet, kPathEncounters, requestId, res.status);
+            return;
+        }
 
         const auto validation = ValidateEncounterQuery(req);
         if (std::holds_alternative<domain::DomainError>(validation)) {
@@ -251,19 +687,54 @@ void RegisterRoutes(httplib::Server& server,
             return;
         }
 
-        const auto serviceResult = service->QueryEncounters(std::get<storage::EncounterQueryFilters>(validation));
+        // Read before the query: a write racing it leaves the tag older than the body, which costs the
+        // client one extra full response rather than a stale 304.
+        const auto etag = WeakGenerationEtag(listEtagInstance, service->EncounterWriteGeneration());
+
+        // The query runs even when the tag matches, because it records the LIST_ENCOUNTERS access: a
+        // 304 still discloses the records to a client holding the cached page. Only serialization
+        // and transfer are skipped.
+        auto serviceResult =
+            service->QueryEncounters(std::get<storage::EncounterQueryFilters>(validation), actor, context);
         if (std::holds_alternative<domain::DomainError>(serviceResult)) {
             WriteDomainError(res, std::get<domain::DomainError>(serviceResult), requestId);
             LogHttpResult(*log, *redact, kMethodGet, kPathEncounters, requestId, res.status);
             return;
         }
+        if (IfNoneMatchHits(req.get_header_value("If-None-Match"), etag)) {
+            WriteNotModified(res, etag);
+            LogHttpResult(*log, *redact, kMethodGet, kPathEncounters, requestId, res.status);
+            return;
+        }
 
-        WriteJson(res, 200, EncounterListToJson(std::get<std::vector<domain::Encounter>>(serviceResult)));
+        try {
+            SendJsonArray(req,
+                          res,
+                          std::get<storage::SharedEncounters>(std::move(serviceResult)),
+                          &AppendEncounterJson,
+                          options.compression,
+                          context,
+                          std::move(*admitted));
+            // Weak tags are coding-independent, so streamed and gzip bodies share one.
+            res.set_header("ETag", etag);
+        } catch (const util::RequestCancelled&) {
+            WriteDomainError(res,
+                             domain::DomainError{.code = domain::DomainErrorCode::DeadlineExceeded,
+                                                .message = "Request deadline exceeded",
+                                                .details = std::nullopt},
+                             requestId);
+        }
         LogHttpResult(*log, *redact, kMethodGet, kPathEncounters, requestId, res.status);
     });
 
-    server.Get(kPathAuditEncounters, [service, log, redact](const httplib::Request& req, httplib::Response& res) {
+    router.Get(kPathAuditEncounters, [service, log, redact, options](const httplib::Request& req,
+                                                                     httplib::Response& res) {
         const auto requestId = GetRequestId(req);
+        auto admitted = Admit(options.admission, RouteClass::Audit, requestId, res);
+        if (!admitted) {
+            LogHttpResult(*log, *redact, kMethodGet, kPathAuditEncounters, requestId, res.status);
+            return;
+        }
 
         const auto auth = Authenticate(req);
         if (std::holds_alternative<domain::DomainError>(auth)) {
@@ -272,6 +743,10 @@ void RegisterRoutes(httplib::Server& server,
             return;
         }
         (void)std::get<std::string>(auth);
+        if (!WithinRateLimit(options.rateLimiter, RouteClass::Audit, RateLimitKey(req), requestId, res)) {
+            LogHttpResult(*log, *redact, kMethodGet, kPathAuditEncounters, requestId, res.status);
+            return;
+        }
 
         const auto validation = ValidateAuditQuery(req);
         if (std::holds_alternative<domain::DomainError>(validation)) {
@@ -280,16 +755,114 @@ void RegisterRoutes(httplib::Server& server,
             return;
         }
 
-        const auto serviceResult = service->QueryAudit(std::get<storage::AuditDateRange>(validation));
+        auto serviceResult = service->QueryAudit(std::get<storage::AuditDateRange>(validation));
         if (std::holds_alternative<domain::DomainError>(serviceResult)) {
             WriteDomainError(res, std::get<domain::DomainError>(serviceResult), requestId);
             LogHttpResult(*log, *redact, kMethodGet, kPathAuditEncounters, requestId, res.status);
             return;
         }
 
-        WriteJson(res, 200, AuditListToJson(std::get<std::vector<domain::AuditEntry>>(serviceResult)));
+        SendJsonArray(req,
+                      res,
+                      std::get<std::vector<domain::AuditEntry>>(std::move(serviceResult)),
+                      &AppendAuditEntryJson,
+                      options.compression,
+                      {},
+                      std::move(*admitted));
         LogHttpResult(*log, *redact, kMethodGet, kPathAuditEncounters, requestId, res.status);
     });
+
+    router.Get(kPathAuditRollups, [service, log, redact, options](const httplib::Request& req, httplib::Response& res) {
+        const auto requestId = GetRequestId(req);
+        const auto admitted = Admit(options.admission, RouteClass::Audit, requestId, res);
+        if (!admitted) {
+            LogHttpResult(*log, *redact, kMethodGet, kPathAuditRollups, requestId, res.status);
+            return;
+        }
+
+        const auto auth = Authenticate(req);
+        if (std::holds_alternative<domain::DomainError>(auth)) {
+            WriteDomainError(res, std::get<domain::DomainError>(auth), requestId);
+            LogHttpResult(*log, *redact, kMethodGet, kPathAuditRollups, requestId, res.status);
+            return;
+        }
+        (void)std::get<std::string>(auth);
+        if (!WithinRateLimit(options.rateLimiter, RouteClass::Audit, RateLimitKey(req), requestId, res)) {
+            LogHttpResult(*log, *redact, kMethodGet, kPathAuditRollups, requestId, res.status);
+            return;
+        }
+
+        const auto validation = ValidateAuditQuery(req);
+        if (std::holds_alternative<domain::DomainError>(validation)) {
+            WriteDomainError(res, std::get<domain::DomainError>(validation), requestId);
+            LogHttpResult(*log, *redact, kMethodGet, kPathAuditRollups, requestId, res.status);
+            return;
+        }
+
+        const auto serviceResult = service->QueryAuditRollups(std::get<storage::AuditDateRange>(validation));
+        if (std::holds_alternative<domain::DomainError>(serviceResult)) {
+            WriteDomainError(res, std::get<domain::DomainError>(serviceResult), requestId);
+            LogHttpResult(*log, *redact, kMethodGet, kPathAuditRollups, requestId, res.status);
+            return;
+        }
+
+        WriteJson(res, 200, AuditRollupListToJson(std::get<std::vector<domain::AuditRollup>>(serviceResult)));
+        LogHttpResult(*log, *redact, kMethodGet, kPathAuditRollups, requestId, res.status);
+    });
+
+    if (options.auditHistory == nullptr) {
+        return;
+    }
+    router.Get(kPathAuditHistory, [log, redact, options](const httplib::Request& req, httplib::Response& res) {
+        const auto requestId = GetRequestId(req);
+        auto admitted = Admit(options.admission, RouteClass::Audit, requestId, res);
+        if (!admitted) {
+            LogHttpResult(*log, *redact, kMethodGet, kPathAuditHistory, requestId, res.status);
+            return;
+        }
+
+        const auto auth = Authenticate(req);
+        if (std::holds_alternative<domain::DomainError>(auth)) {
+            WriteDomainError(res, std::get<domain::DomainError>(auth), requestId);
+            LogHttpResult(*log, *redact, kMethodGet, kPathAuditHistory, requestId, res.status);
+            return;
+        }
+        (void)std::get<std::string>(auth);
+        if (!WithinRateLimit(options.rateLimiter, RouteClass::Audit, RateLimitKey(req), requestId, res)) {
+            LogHttpResult(*log, *redact, kMethodGet, kPathAuditHistory, requestId, res.status);
+            return;
+        }
+
+        const auto validation = ValidateAuditQuery(req);
+        if (std::holds_alternative<domain::DomainError>(validation)) {
+            WriteDomainError(res, std::get<domain::DomainError>(validation), requestId);
+            LogHttpResult(*log, *redact, kMethodGet, kPathAuditHistory, requestId, res.status);
+            return;
+        }
+
+        // Segment strings are stored JSON-escaped, so each batch is written straight from the mappings.
+        auto stream = std::make_shared<storage::AuditHistoryJsonStream>(
+            options.auditHistory->StreamJsonArray(std::get<storage::AuditDateRange>(validation)));
+        SendJsonStream(req,
+                       res,
+                       [stream](std::string& buffer) {
+                           buffer.clear();
+                           return stream->Fill(buffer, kStreamChunkBytes);
+                       },
+                       options.compression,
+                       std::move(*admitted));
+        LogHttpResult(*log, *redact, kMethodGet, kPathAuditHistory, requestId, res.status);
+    });
+}
+
+void RegisterRoutes(httplib::Server& server,
+                    domain::EncounterService& encounterService,
+                    util::Logger& logger,
+                    util::Redactor& redactor,
+                    const RouteOptions& options) {
+    auto router = std::make_shared<Router>();
+    RegisterRoutes(*router, encounterService, logger, redactor, options);
+    InstallRouter(server, std::move(router));
 }
 
 }  // namespace encounter_service::http
@@ -1,18 +1,62 @@
 #pragma once
 
+#include <array>
+#include <chrono>
+
 #include "src/domain/encounter_service.h"
+#include "src/http/admission.h"
+#include "src/http/compression.h"
+#include "src/http/rate_limiter.h"
+#include "src/http/router.h"
 #include "src/http/httplib_compat.h"
+#include "src/http/validation.h"
+#include "src/storage/audit_segment_file.h"
 #include "src/util/logger.h"
 #include "src/util/redaction.h"
+#include "src/util/work_stealing_scheduler.h"
 
 namespace encounter_service::http {
 
-// Registers all HTTP handlers on `server`.
-// The server stores handlers that reference `encounterService`, `logger`, and `redactor`;
-// these dependencies must outlive request handling.
+// Optional route dependencies. Pointers left null disable the routes that need them.
+struct RouteOptions {
+    // Serves `GET /audit/encounters/history` from memory-mapped segment files.
+    const storage::MappedAuditHistory* auditHistory{nullptr};
+    // Sheds requests per route class with 503 + `Retry-After` once their adaptive limit and queue
+    // are exhausted. Null admits every request.
+    AdmissionController* admission{nullptr};
+    // Rejects requests with 429 + `Retry-After` once the client's API key (see RateLimitKey())
+    // exhausts its token bucket for the route class. Null disables rate limiting.
+    RateLimiter* rateLimiter{nullptr};
+    // Default deadline per route class, combined with the client's `X-Request-Timeout-Ms` (the
+    // earlier wins); zero means no default. Only GET /encounters runs cancellable work today: its
+    // repository scan, sort and first response batch stop with 504 once the deadline passes; a
+    // body that is already streaming is aborted mid-response.
+    std::array<std::chrono::milliseconds, kRouteClassCount> requestTimeouts{};
+    // gzip negotiation (`Accept-Encoding`) for encounter, batch and list bodies.
+    CompressionOptions compression{};
+    // Caches gzip bodies of `GET /encounters/{id}`, which never change once created. Null disables it.
+    CompressedResponseCache* compressedEncounters{nullptr};
+    // Body size and nesting bounds for `POST /encounters`, enforced while parsing.
+    CreateRequestLimits createLimits{};
+    // Scheduler running the HTTP workers; `GET /health` reports its queue depth, steals and task
+    // wait times. Null omits them.
+    const util::WorkStealingScheduler* scheduler{nullptr};
+};
+
+// Registers all HTTP handlers on `router`, which may be extended with more routes before it is
+// installed. The handlers reference `encounterService`, `logger`, `redactor`, and the dependencies
+// in `options`; these must outlive request handling.
+void RegisterRoutes(Router& router,
+                    domain::EncounterService& encounterService,
+                    util::Logger& logger,
+                    util::Redactor& redactor,
+                    const RouteOptions& options = {});
+
+// Registers all HTTP handlers on a new Router and installs it on `server`.
 void RegisterRoutes(httplib::Server& server,
                     domain::EncounterService& encounterService,
                     util::Logger& logger,
-                    util::Redactor& redactor);
+                    util::Redactor& redactor,
+                    const RouteOptions& options = {});
 
 }  // namespace encounter_service::http
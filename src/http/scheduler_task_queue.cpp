@@ -0,0 +1,40 @@
+#include "src/http/scheduler_task_queue.h"
+
+#include <utility>
+
+namespace encounter_service::http {
+
+SchedulerTaskQueue::SchedulerTaskQueue(util::WorkStealingScheduler& scheduler)
+    : scheduler_(scheduler) {}
+
+bool SchedulerTaskQueue::enqueue(std::function<void()> fn) {
+    {
+        std::lock_guard lock(mutex_);
+        if (shutdown_) {
+            return false;
+        }
+        ++outstanding_;
+    }
+    const bool submitted = scheduler_.TrySubmit([this, fn = std::move(fn)]() {
+        fn();
+        std::lock_guard lock(mutex_);
+        if (--outstanding_ == 0) {
+            drained_.notify_all();
+        }
+    });
+    if (!submitted) {
+        std::lock_guard lock(mutex_);
+        if (--outstanding_ == 0) {
+            drained_.notify_all();
+        }
+    }
+    return submitted;
+}
+
+void SchedulerTaskQueue::shutdown() {
+    std::unique_lock lock(mutex_);
+    shutdown_ = true;
+    drained_.wait(lock, [this]() { return outstanding_ == 0; });
+}
+
+}  // namespace encounter_service::http
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+
+#include "src/http/httplib_compat.h"
+#include "src/util/work_stealing_scheduler.h"
+
+namespace encounter_service::http {
+
+// Runs httplib::Server connection tasks on a shared WorkStealingScheduler, installed through
+// `server.new_task_queue`. The scheduler is borrowed: shutdown() waits for the tasks this queue
+// submitted but leaves the scheduler running for its other users.
+class SchedulerTaskQueue final : public httplib::TaskQueue {
+public:
+    explicit SchedulerTaskQueue(util::WorkStealingScheduler& scheduler);
+
+    bool enqueue(std::function<void()> fn) override;
+    void shutdown() override;
+
+private:
+    util::WorkStealingScheduler& scheduler_;
+    std::mutex mutex_;
+    std::condition_variable drained_;
+    std::size_t outstanding_{0};
+    bool shutdown_{false};
+};
+
+}  // namespace encounter_service::http
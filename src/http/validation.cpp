@@ -1,7 +1,10 @@
 #include "src/http/validation.h"
 
+#include <array>
+#include <cstdint>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "src/util/time.h"
@@ -18,29 +21,6 @@ domain::DomainError ValidationError(std::string path, std::string message) {
     };
 }
 
-std::optional<std::string> GetOptionalStringField(const nlohmann::json& body, const std::string& key) {
-    if (!body.is_object() || !body.contains(key)) {
-        return std::nullopt;
-    }
-    const auto& value = body.at(key);
-    if (!value.is_string()) {
-        return std::nullopt;
-    }
-    return value.get<std::string>();
-}
-
-std::variant<std::string, domain::DomainError>
-GetRequiredStringField(const nlohmann::json& body, const std::string& key) {
-    if (!body.contains(key)) {
-        return ValidationError(key, "is required");
-    }
-    const auto& value = body.at(key);
-    if (!value.is_string()) {
-        return ValidationError(key, "must be a string");
-    }
-    return value.get<std::string>();
-}
-
 std::variant<std::optional<std::chrono::system_clock::time_point>, domain::DomainError>
 ParseOptionalQueryTime(const httplib::Request& request, const std::string& paramName) {
     if (!request.has_param(paramName)) {
@@ -55,52 +35,284 @@ ParseOptionalQueryTime(const httplib::Request& request, const std::string& param
     return parsed;
 }
 
-}  // namespace
+#if __has_include("vendor/json.hpp")
+// Top-level POST /encounters members, in the order missing ones are reported.
+enum class CreateField : std::uint8_t { ClinicalData, PatientId, ProviderId, EncounterType, EncounterDate, Other };
 
-std::variant<domain::CreateEncounterInput, domain::DomainError>
-ValidateCreateEncounterRequest(const nlohmann::json& body) {
-    if (!body.is_object()) {
-        return ValidationError("body", "must be a JSON object");
+constexpr std::array<std::string_view, 5> kCreateFieldNames{
+    "clinicalData", "patientId", "providerId", "encounterType", "encounterDate"};
+
+CreateField LookupCreateField(std::string_view name) {
+    for (std::size_t i = 0; i < kCreateFieldNames.size(); ++i) {
+        if (kCreateFieldNames[i] == name) {
+            return static_cast<CreateField>(i);
+        }
     }
-    if (!body.contains("clinicalData")) {
-        return ValidationError("clinicalData", "is required");
+    return CreateField::Other;
+}
+
+// nlohmann SAX handler behind ParseCreateEncounterRequest(). Members of the body object are checked
+// as their values arrive, and only the `clinicalData` subtree is built as JSON; unknown members are
+// skipped without being stored. Any event returning false stops the parser at that token, with the
+// reason kept for Finish().
+class CreateEncounterSax {
+public:
+    explicit CreateEncounterSax(std::size_t maxDepth)
+        : maxDepth_(maxDepth) {}
+
+    bool null() {
+        return Scalar(nullptr);
     }
-    if (!body.at("clinicalData").is_object()) {
-        return ValidationError("clinicalData", "must be an object");
+
+    bool boolean(bool value) {
+        return Scalar(value);
+    }
+
+    bool number_integer(nlohmann::json::number_integer_t value) {
+        return Scalar(value);
+    }
+
+    bool number_unsigned(nlohmann::json::number_unsigned_t value) {
+        return Scalar(value);
+    }
+
+    bool number_float(nlohmann::json::number_float_t value, const std::string&) {
+        return Scalar(value);
+    }
+
+    bool binary(nlohmann::json::binary_t&) {
+        return Fail("body", "must be valid JSON");
+    }
+
+    // The parser's token buffer is reset before the next token, so strings can be moved out of it.
+    bool string(std::string& value) {
+        if (depth_ != 1 || !stack_.empty() || skipDepth_ > 0) {
+            return Scalar(std::move(value));
+        }
+        switch (field_) {
+            case CreateField::PatientId:
+                input_.patientId = std::move(value);
+                break;
+            case CreateField::ProviderId:
+                input_.providerId = std::move(value);
+                break;
+            case CreateField::EncounterType:
+                input_.encounterType = std::move(value);
+                break;
+            case CreateField::EncounterDate: {
+                const auto parsed = util::ParseIso8601Utc(value);
+                if (!parsed) {
+                    return Fail("encounterDate", "must be YYYY-MM-DD or YYYY-MM-DDTHH:MM:SSZ");
+                }
+                input_.encounterDate = *parsed;
+                break;
+            }
+            case CreateField::ClinicalData:
+            case CreateField::Other:
+                return MemberTypeMismatch();
+        }
+        seen_[static_cast<std::size_t>(field_)] = true;
+        return true;
+    }
+
+    bool start_object(std::size_t) {
+        if (++depth_ > maxDepth_) {
+            return FailDepth();
+        }
+        return depth_ == 1 || OpenContainer(nlohmann::json::object());
+    }
+
+    bool start_array(std::size_t) {
+        if (++depth_ > maxDepth_) {
+            return FailDepth();
+        }
+        if (depth_ == 1) {
+            return Fail("body", "must be a JSON object");
+        }
+        return OpenContainer(nlohmann::json::array());
     }
 
-    domain::CreateEncounterInput input{};
-    auto patientId = GetRequiredStringField(body, "patientId");
-    if (std::holds_alternative<domain::DomainError>(patientId)) {
-        return std::get<domain::DomainError>(std::move(patientId));
+    bool end_object() {
+        return CloseContainer();
     }
-    input.patientId = std::get<std::string>(std::move(patientId));
 
-    auto providerId = GetRequiredStringField(body, "providerId");
-    if (std::holds_alternative<domain::DomainError>(providerId)) {
-        return std::get<domain::DomainError>(std::move(providerId));
+    bool end_array() {
+        return CloseContainer();
     }
-    input.providerId = std::get<std::string>(std::move(providerId));
 
-    auto encounterType = GetRequiredStringField(body, "encounterType");
-    if (std::holds_alternative<domain::DomainError>(encounterType)) {
-        return std::get<domain::DomainError>(std::move(encounterType));
+    bool key(std::string& name) {
+        if (!stack_.empty()) {
+            key_ = std::move(name);
+        } else if (skipDepth_ == 0) {
+            field_ = LookupCreateField(name);
+        }
+        return true;
     }
-    input.encounterType = std::get<std::string>(std::move(encounterType));
 
-    auto encounterDateRaw = GetRequiredStringField(body, "encounterDate");
-    if (std::holds_alternative<domain::DomainError>(encounterDateRaw)) {
-        return std::get<domain::DomainError>(std::move(encounterDateRaw));
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&) {
+        return Fail("body", "must be valid JSON");
     }
 
-    const auto parsedEncounterDate = util::ParseIso8601Utc(std::get<std::string>(encounterDateRaw));
-    if (!parsedEncounterDate) {
-        return ValidationError("encounterDate", "must be YYYY-MM-DD or YYYY-MM-DDTHH:MM:SSZ");
+    std::variant<domain::CreateEncounterInput, domain::DomainError> Finish(bool parsed) && {
+        if (error_) {
+            return *std::move(error_);
+        }
+        if (!parsed) {
+            return ValidationError("body", "must be valid JSON");
+        }
+        for (std::size_t i = 0; i < kCreateFieldNames.size(); ++i) {
+            if (!seen_[i]) {
+                return ValidationError(std::string(kCreateFieldNames[i]), "is required");
+            }
+        }
+        return std::move(input_);
     }
 
-    input.encounterDate = *parsedEncounterDate;
-    input.clinicalData = body.at("clinicalData");
-    return input;
+private:
+    // A non-container value: stored inside `clinicalData`, dropped inside a skipped member, and
+    // otherwise the value of a body member (or the body itself).
+    bool Scalar(nlohmann::json value) {
+        if (depth_ == 0) {
+            return Fail("body", "must be a JSON object");
+        }
+        if (!stack_.empty()) {
+            Insert(std::move(value));
+            return true;
+        }
+        return skipDepth_ > 0 || MemberTypeMismatch();
+    }
+
+    bool OpenContainer(nlohmann::json container) {
+        if (!stack_.empty()) {
+            stack_.push_back(&Insert(std::move(container)));
+            return true;
+        }
+        if (skipDepth_ > 0 || field_ == CreateField::Other) {
+            ++skipDepth_;
+            return true;
+        }
+        if (field_ != CreateField::ClinicalData || !container.is_object()) {
+            return MemberTypeMismatch();
+        }
+        input_.clinicalData = std::move(container);
+        stack_.push_back(&input_.clinicalData);
+        seen_[static_cast<std::size_t>(CreateField::ClinicalData)] = true;
+        return true;
+    }
+
+    bool CloseContainer() {
+        --depth_;
+        if (!stack_.empty()) {
+            stack_.pop_back();
+        } else if (skipDepth_ > 0) {
+            --skipDepth_;
+        }
+        return true;
+    }
+
+    // Later duplicate keys replace earlier ones, as in nlohmann::json::parse().
+    nlohmann::json& Insert(nlohmann::json value) {
+        auto& parent = *stack_.back();
+        if (parent.is_array()) {
+            parent.push_back(std::move(value));
+            return parent.back();
+        }
+        auto& slot = parent[std::move(key_)];
+        slot = std::move(value);
+        return slot;
+    }
+
+    // The current body member's value has the wrong JSON type; unknown members accept any type.
+    bool MemberTypeMismatch() {
+        switch (field_) {
+            case CreateField::Other:
+                return true;
+            case CreateField::ClinicalData:
+                return Fail("clinicalData", "must be an object");
+            default:
+                return Fail(std::string(kCreateFieldNames[static_cast<std::size_t>(field_)]), "must be a string");
+        }
+    }
+
+    bool FailDepth() {
+        return Fail("body", "must not nest deeper than " + std::to_string(maxDepth_) + " levels");
+    }
+
+    bool Fail(std::string path, std::string message) {
+        if (!error_) {
+            error_ = ValidationError(std::move(path), std::move(message));
+        }
+        return false;
+    }
+
+    std::size_t maxDepth_;
+    // Open objects and arrays, counting the body object.
+    std::size_t depth_{0};
+    // Open containers inside a skipped unknown member.
+    std::size_t skipDepth_{0};
+    CreateField field_{CreateField::Other};
+    std::array<bool, kCreateFieldNames.size()> seen_{};
+    // Open containers of the `clinicalData` tree under construction, innermost last.
+    std::vector<nlohmann::json*> stack_;
+    std::string key_;
+    domain::CreateEncounterInput input_{};
+    std::optional<domain::DomainError> error_;
+};
+#endif
+
+}  // namespace
+
+std::variant<domain::CreateEncounterInput, domain::DomainError>
+ParseCreateEncounterRequest(std::string_view body, const CreateRequestLimits& limits) {
+    if (body.size() > limits.maxBodyBytes) {
+        return domain::DomainError{
+            .code = domain::DomainErrorCode::PayloadTooLarge,
+            .message = "Request body too large",
+            .details = std::vector<domain::FieldError>{domain::FieldError{
+                .path = "body",
+                .message = "must be at most " + std::to_string(limits.maxBodyBytes) + " bytes"
+            }}
+        };
+    }
+#if __has_include("vendor/json.hpp")
+    CreateEncounterSax sax(limits.maxDepth);
+    const bool parsed = nlohmann::json::sax_parse(body.data(), body.data() + body.size(), &sax);
+    return std::move(sax).Finish(parsed);
+#else
+    // Keep this branch compile-safe when the single-header JSON dependency is absent.
+    return ValidationError("body", "JSON parsing requires vendor/json.hpp");
+#endif
+}
+
+std::variant<std::vector<std::string>, domain::DomainError>
+ValidateBatchGetRequest(const nlohmann::json& body) {
+    if (!body.is_object()) {
+        return ValidationError("body", "must be a JSON object");
+    }
+    if (!body.contains("ids")) {
+        return ValidationError("ids", "is required");
+    }
+    const auto& ids = body.at("ids");
+    if (!ids.is_array()) {
+        return ValidationError("ids", "must be an array");
+    }
+    if (ids.empty()) {
+        return ValidationError("ids", "must not be empty");
+    }
+    if (ids.size() > kMaxBatchGetIds) {
+        return ValidationError("ids", "must contain at most " + std::to_string(kMaxBatchGetIds) + " items");
+    }
+
+    std::vector<std::string> out;
+    out.reserve(ids.size());
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        const auto& id = ids.at(i);
+        if (!id.is_string()) {
+            return ValidationError("ids[" + std::to_string(i) + "]", "must be a string");
+        }
+        out.push_back(id.get<std::string>());
+    }
+    return out;
 }
 
 std::variant<storage::EncounterQueryFilters, domain::DomainError>
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
+#include <string_view>
 #include <variant>
+#include <vector>
 
 #include "src/domain/encounter_service.h"
 #include "src/domain/errors.h"
@@ -12,11 +15,28 @@
 
 namespace encounter_service::http {
 
-// Validates POST /encounters JSON and converts it to service-layer input.
-// Returns Validation DomainError when required fields are missing, typed incorrectly,
-// or contain invalid date/time values.
+struct CreateRequestLimits {
+    // Larger bodies are rejected with PayloadTooLarge before any parsing.
+    std::size_t maxBodyBytes{std::size_t{1} << 20};
+    // Deepest object/array nesting accepted, counting the body object as level 1.
+    std::size_t maxDepth{32};
+};
+
+// Parses and validates a raw POST /encounters body in one pass and converts it to service-layer
+// input without building a DOM for the envelope. Returns Validation DomainError when required
+// fields are missing, typed incorrectly, or contain invalid date/time values. Fields are checked as
+// the parser reaches them, so a wrong type, a bad `encounterDate`, excess nesting or malformed
+// JSON stops parsing at the offending token. Strings move straight from the parser into the input,
+// and only `clinicalData` is materialized as JSON.
 std::variant<domain::CreateEncounterInput, domain::DomainError>
-ValidateCreateEncounterRequest(const nlohmann::json& body);
+ParseCreateEncounterRequest(std::string_view body, const CreateRequestLimits& limits = {});
+
+// Maximum number of IDs accepted by one POST /encounters:batchGet request.
+inline constexpr std::size_t kMaxBatchGetIds = 100;
+
+// Validates POST /encounters:batchGet JSON (`{"ids": ["enc-1", ...]}`) and returns the requested IDs.
+std::variant<std::vector<std::string>, domain::DomainError>
+ValidateBatchGetRequest(const nlohmann::json& body);
 
 // Validates and parses GET /encounters query parameters into repository filters.
 std::variant<storage::EncounterQueryFilters, domain::DomainError>
@@ -1,17 +1,36 @@
 #include "src/domain/encounter_service.h"
+#include "src/http/admission.h"
+#include "src/http/compression.h"
+#include "src/http/rate_limiter.h"
 #include "src/http/routes.h"
+#include "src/http/scheduler_task_queue.h"
+#include "src/storage/audit_archiver.h"
+#include "src/storage/audit_segment_file.h"
+#include "src/storage/caching_encounter_repo.h"
+#include "src/storage/coalescing_encounter_repo.h"
 #include "src/storage/in_memory_audit_repo.h"
 #include "src/storage/in_memory_encounter_repo.h"
+#include "src/storage/query_caching_encounter_repo.h"
 #include "src/util/clock.h"
 #include "src/util/id_generator.h"
 #include "src/util/logger.h"
 #include "src/util/redaction.h"
+#include "src/util/work_stealing_scheduler.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <optional>
 #include <string>
+#include <system_error>
+#include <utility>
 
 int main() {
     constexpr const char* kBindAddress = "127.0.0.1";
     constexpr int kDefaultPort = 8080;
+    constexpr std::chrono::minutes kAuditArchiveInterval{1};
 
     encounter_service::storage::InMemoryEncounterRepository encounter_repo;
     encounter_service::storage::InMemoryAuditRepository audit_repo;
@@ -20,14 +39,134 @@ int main() {
     encounter_service::util::StdoutLogger logger;
     encounter_service::util::BasicRedactor redactor;
 
+    // ENCOUNTER_CACHE_MAX_BYTES > 0 puts a read-through LRU cache in front of the encounter repository.
+    encounter_service::storage::EncounterRepository* service_encounter_repo = &encounter_repo;
+    std::unique_ptr<encounter_service::storage::CachingEncounterRepository> encounter_cache;
+    if (const char* cache_bytes = std::getenv("ENCOUNTER_CACHE_MAX_BYTES"); cache_bytes != nullptr) {
+        encounter_service::storage::EncounterCacheOptions cache_options{};
+        cache_options.maxBytes = static_cast<std::size_t>(std::strtoull(cache_bytes, nullptr, 10));
+        if (cache_options.maxBytes > 0) {
+            encounter_cache = std::make_unique<encounter_service::storage::CachingEncounterRepository>(
+                encounter_repo, cache_options);
+            service_encounter_repo = encounter_cache.get();
+        }
+    }
+
+    // Identical list queries that overlap in time share one execution.
+    encounter_service::storage::CoalescingEncounterRepository coalescing_repo(*service_encounter_repo);
+
+    // ENCOUNTER_QUERY_CACHE_MAX_BYTES > 0 caches list results in front of the coalescing layer, so
+    // only cache misses are coalesced.
+    encounter_service::storage::EncounterRepository* query_repo = &coalescing_repo;
+    std::unique_ptr<encounter_service::storage::QueryCachingEncounterRepository> query_cache;
+    if (const char* query_cache_bytes = std::getenv("ENCOUNTER_QUERY_CACHE_MAX_BYTES"); query_cache_bytes != nullptr) {
+        encounter_service::storage::QueryCacheOptions query_cache_options{};
+        query_cache_options.maxBytes = static_cast<std::size_t>(std::strtoull(query_cache_bytes, nullptr, 10));
+        if (query_cache_options.maxBytes > 0) {
+            query_cache = std::make_unique<encounter_service::storage::QueryCachingEncounterRepository>(
+                coalescing_repo, query_cache_options);
+            query_repo = query_cache.get();
+        }
+    }
+
     encounter_service::domain::DefaultEncounterService service(
-        encounter_repo,
+        *query_repo,
         audit_repo,
         clock,
         id_generator);
 
+    // Historical audit segments are served read-only from memory-mapped files when configured. The
+    // archiver seals every cold segment into the directory and maps it as it goes.
+    encounter_service::http::RouteOptions route_options;
+    std::optional<encounter_service::storage::MappedAuditHistory> audit_history;
+    std::optional<encounter_service::storage::AuditHistorySink> audit_history_sink;
+    if (const char* history_dir = std::getenv("ENCOUNTER_AUDIT_HISTORY_DIR"); history_dir != nullptr) {
+        std::error_code error;
+        std::filesystem::create_directories(history_dir, error);
+        audit_history.emplace();
+        audit_history->AddDirectory(history_dir);
+        route_options.auditHistory = &*audit_history;
+        audit_history_sink = encounter_service::storage::AuditHistorySink{
+            .directory = history_dir,
+            .history = &*audit_history
+        };
+        logger.Log(encounter_service::util::LogLevel::Info,
+                   "Mapped " + std::to_string(audit_history->segmentCount()) + " audit history segments");
+    }
+
+    encounter_service::storage::AuditArchiver audit_archiver(
+        audit_repo, clock, kAuditArchiveInterval, std::move(audit_history_sink));
+    audit_archiver.Start();
+
+    // ENCOUNTER_ADMISSION_CONTROL=1 sheds overload per route class instead of queueing without bound.
+    std::optional<encounter_service::http::AdmissionController> admission;
+    if (const char* admission_control = std::getenv("ENCOUNTER_ADMISSION_CONTROL");
+        admission_control != nullptr && std::string(admission_control) == "1") {
+        admission.emplace();
+        route_options.admission = &*admission;
+    }
+
+    // ENCOUNTER_RATE_LIMIT=1 enforces per-API-key token buckets with the default per-class budgets.
+    std::optional<encounter_service::http::RateLimiter> rate_limiter;
+    if (const char* rate_limit = std::getenv("ENCOUNTER_RATE_LIMIT");
+        rate_limit != nullptr && std::string(rate_limit) == "1") {
+        rate_limiter.emplace();
+        route_options.rateLimiter = &*rate_limiter;
+    }
+
+    // ENCOUNTER_LIST_TIMEOUT_MS > 0 bounds how long a list query may run when the client sends no
+    // shorter X-Request-Timeout-Ms.
+    if (const char* list_timeout = std::getenv("ENCOUNTER_LIST_TIMEOUT_MS"); list_timeout != nullptr) {
+        route_options.requestTimeouts[static_cast<std::size_t>(encounter_service::http::RouteClass::List)] =
+            std::chrono::milliseconds{std::strtoll(list_timeout, nullptr, 10)};
+    }
+
+    // Responses are gzip-encoded for clients that accept it. ENCOUNTER_GZIP_LEVEL sets the zlib level
+    // (0 disables compression), ENCOUNTER_GZIP_MIN_BYTES the smallest body worth compressing, and
+    // ENCOUNTER_GZIP_CACHE_MAX_BYTES > 0 caches compressed single-encounter bodies.
+    if (const char* gzip_level = std::getenv("ENCOUNTER_GZIP_LEVEL"); gzip_level != nullptr) {
+        route_options.compression.level = std::clamp(static_cast<int>(std::strtol(gzip_level, nullptr, 10)), 0, 9);
+    }
+    if (const char* gzip_min_bytes = std::getenv("ENCOUNTER_GZIP_MIN_BYTES"); gzip_min_bytes != nullptr) {
+        route_options.compression.minBytes = static_cast<std::size_t>(std::strtoull(gzip_min_bytes, nullptr, 10));
+    }
+    std::optional<encounter_service::http::CompressedResponseCache> compressed_cache;
+    if (const char* gzip_cache_bytes = std::getenv("ENCOUNTER_GZIP_CACHE_MAX_BYTES"); gzip_cache_bytes != nullptr) {
+        if (const auto max_bytes = std::strtoull(gzip_cache_bytes, nullptr, 10); max_bytes > 0) {
+            compressed_cache.emplace(static_cast<std::size_t>(max_bytes));
+            route_options.compressedEncounters = &*compressed_cache;
+        }
+    }
+
+    // ENCOUNTER_CREATE_MAX_BODY_BYTES caps `POST /encounters` bodies (default 1 MiB); larger ones get 413.
+    // The server enforces it as its payload limit too, so oversized bodies are refused from their
+    // Content-Length instead of being buffered first; the other POST bodies are far smaller.
+    if (const char* max_body = std::getenv("ENCOUNTER_CREATE_MAX_BODY_BYTES"); max_body != nullptr) {
+        if (const auto max_bytes = std::strtoull(max_body, nullptr, 10); max_bytes > 0) {
+            route_options.createLimits.maxBodyBytes = static_cast<std::size_t>(max_bytes);
+        }
+    }
+
+    // HTTP connections run on a work-stealing scheduler. ENCOUNTER_WORKER_THREADS overrides the
+    // worker count (default CPPHTTPLIB_THREAD_POOL_COUNT); ENCOUNTER_PIN_WORKERS=1 pins each worker to a CPU.
+    encounter_service::util::WorkStealingOptions scheduler_options{};
+    scheduler_options.threadCount = CPPHTTPLIB_THREAD_POOL_COUNT;
+    if (const char* worker_threads = std::getenv("ENCOUNTER_WORKER_THREADS"); worker_threads != nullptr) {
+        if (const auto count = std::strtoull(worker_threads, nullptr, 10); count > 0) {
+            scheduler_options.threadCount = static_cast<std::size_t>(count);
+        }
+    }
+    if (const char* pin_workers = std::getenv("ENCOUNTER_PIN_WORKERS");
+        pin_workers != nullptr && std::string(pin_workers) == "1") {
+        scheduler_options.pinThreads = true;
+    }
+    encounter_service::util::WorkStealingScheduler scheduler(scheduler_options);
+    route_options.scheduler = &scheduler;
+
     httplib::Server server;
-    encounter_service::http::RegisterRoutes(server, service, logger, redactor);
+    server.set_payload_max_length(route_options.createLimits.maxBodyBytes);
+    server.new_task_queue = [&scheduler]() { return new encounter_service::http::SchedulerTaskQueue(scheduler); };
+    encounter_service::http::RegisterRoutes(server, service, logger, redactor, route_options);
 
     logger.Log(encounter_service::util::LogLevel::Info,
                "Starting Encounter Service on port " + std::to_string(kDefaultPort));
@@ -0,0 +1,26 @@
+#include "src/storage/async_audit_repo.h"
+
+namespace encounter_service::storage {
+
+ReadyAuditRepository::ReadyAuditRepository(AuditRepository& repository)
+    : repository_(repository) {}
+
+util::Task<> ReadyAuditRepository::AppendAsync(domain::AuditEntry entry) {
+    repository_.Append(entry);
+    co_return;
+}
+
+util::Task<> ReadyAuditRepository::AppendBulkAsync(domain::BulkAuditEntry entry) {
+    repository_.AppendBulk(entry);
+    co_return;
+}
+
+util::Task<std::vector<domain::AuditEntry>> ReadyAuditRepository::QueryAsync(AuditDateRange range) {
+    co_return repository_.Query(range);
+}
+
+util::Task<std::vector<domain::AuditRollup>> ReadyAuditRepository::QueryRollupsAsync(AuditDateRange range) {
+    co_return repository_.QueryRollups(range);
+}
+
+}  // namespace encounter_service::storage
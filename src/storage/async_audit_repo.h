@@ -0,0 +1,43 @@
+#pragma once
+
+#include <vector>
+
+#include "src/domain/audit_models.h"
+#include "src/storage/audit_repo.h"
+#include "src/util/task.h"
+
+namespace encounter_service::storage {
+
+// Awaitable counterpart of AuditRepository. Arguments are taken by value so they live in the
+// coroutine frame until the operation completes.
+class AsyncAuditRepository {
+public:
+    virtual ~AsyncAuditRepository() = default;
+
+    // Appends `entry` to the audit trail.
+    virtual util::Task<> AppendAsync(domain::AuditEntry entry) = 0;
+    // Appends one access event covering `entry.encounterIds`.
+    virtual util::Task<> AppendBulkAsync(domain::BulkAuditEntry entry) = 0;
+    // Completes with audit entries that match `range`.
+    virtual util::Task<std::vector<domain::AuditEntry>> QueryAsync(AuditDateRange range) = 0;
+    // Completes with per-day (actor, action) counts for UTC days overlapping `range`.
+    virtual util::Task<std::vector<domain::AuditRollup>> QueryRollupsAsync(AuditDateRange range) = 0;
+};
+
+// Exposes a synchronous audit repository (such as InMemoryAuditRepository) through the async
+// interface. Every task completes when first awaited, without suspending or changing threads.
+class ReadyAuditRepository final : public AsyncAuditRepository {
+public:
+    // Borrows `repository`, which must outlive the adapter.
+    explicit ReadyAuditRepository(AuditRepository& repository);
+
+    util::Task<> AppendAsync(domain::AuditEntry entry) override;
+    util::Task<> AppendBulkAsync(domain::BulkAuditEntry entry) override;
+    util::Task<std::vector<domain::AuditEntry>> QueryAsync(AuditDateRange range) override;
+    util::Task<std::vector<domain::AuditRollup>> QueryRollupsAsync(AuditDateRange range) override;
+
+private:
+    AuditRepository& repository_;
+};
+
+}  // namespace encounter_service::storage
@@ -0,0 +1,28 @@
+#include "src/storage/async_encounter_repo.h"
+
+#include <utility>
+
+namespace encounter_service::storage {
+
+ReadyEncounterRepository::ReadyEncounterRepository(EncounterRepository& repository)
+    : repository_(repository) {}
+
+util::Task<domain::Encounter> ReadyEncounterRepository::CreateAsync(domain::Encounter encounter) {
+    co_return repository_.Create(std::move(encounter));
+}
+
+util::Task<std::optional<domain::Encounter>> ReadyEncounterRepository::GetByIdAsync(std::string encounterId) {
+    co_return repository_.GetById(encounterId);
+}
+
+util::Task<std::vector<std::optional<domain::Encounter>>> ReadyEncounterRepository::GetByIdsAsync(
+    std::vector<std::string> encounterIds) {
+    co_return repository_.GetByIds(encounterIds);
+}
+
+util::Task<std::vector<domain::Encounter>> ReadyEncounterRepository::QueryAsync(EncounterQueryFilters filters,
+                                                                                util::RequestContext context) {
+    co_return repository_.Query(filters, context);
+}
+
+}  // namespace encounter_service::storage
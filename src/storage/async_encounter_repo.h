@@ -0,0 +1,51 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "src/domain/encounter_models.h"
+#include "src/storage/encounter_repo.h"
+#include "src/util/request_context.h"
+#include "src/util/task.h"
+
+namespace encounter_service::storage {
+
+// Awaitable counterpart of EncounterRepository for backends with real I/O latency.
+// Arguments are taken by value so they live in the coroutine frame until the operation completes.
+class AsyncEncounterRepository {
+public:
+    virtual ~AsyncEncounterRepository() = default;
+
+    // Stores `encounter` and completes with the persisted value.
+    virtual util::Task<domain::Encounter> CreateAsync(domain::Encounter encounter) = 0;
+    // Completes with the encounter for `encounterId`, or std::nullopt when not found.
+    virtual util::Task<std::optional<domain::Encounter>> GetByIdAsync(std::string encounterId) = 0;
+    // Completes with one slot per requested ID in request order; unknown IDs yield std::nullopt.
+    virtual util::Task<std::vector<std::optional<domain::Encounter>>> GetByIdsAsync(
+        std::vector<std::string> encounterIds) = 0;
+    // Completes with encounters that match `filters`, or fails with util::RequestCancelled once
+    // `context` is done.
+    virtual util::Task<std::vector<domain::Encounter>> QueryAsync(EncounterQueryFilters filters,
+                                                                  util::RequestContext context) = 0;
+};
+
+// Exposes a synchronous repository (such as InMemoryEncounterRepository) through the async
+// interface. Every task completes when first awaited, without suspending or changing threads.
+class ReadyEncounterRepository final : public AsyncEncounterRepository {
+public:
+    // Borrows `repository`, which must outlive the adapter.
+    explicit ReadyEncounterRepository(EncounterRepository& repository);
+
+    util::Task<domain::Encounter> CreateAsync(domain::Encounter encounter) override;
+    util::Task<std::optional<domain::Encounter>> GetByIdAsync(std::string encounterId) override;
+    util::Task<std::vector<std::optional<domain::Encounter>>> GetByIdsAsync(
+        std::vector<std::string> encounterIds) override;
+    util::Task<std::vector<domain::Encounter>> QueryAsync(EncounterQueryFilters filters,
+                                                          util::RequestContext context) override;
+
+private:
+    EncounterRepository& repository_;
+};
+
+}  // namespace encounter_service::storage
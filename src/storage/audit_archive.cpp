@@ -0,0 +1,113 @@
+#include "src/storage/audit_archive.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "src/util/varint.h"
+
+namespace encounter_service::storage {
+
+ArchivedAuditSegment ArchivedAuditSegment::Encode(std::vector<PackedAuditRecord> records,
+                                                  std::size_t blockRows,
+                                                  std::vector<std::vector<std::uint8_t>> bulkPayloads) {
+    if (blockRows == 0) {
+        blockRows = 1;
+    }
+    std::stable_sort(records.begin(), records.end(), [](const PackedAuditRecord& a, const PackedAuditRecord& b) {
+        return a.ticks < b.ticks;
+    });
+
+    ArchivedAuditSegment segment;
+    segment.rows_ = records.size();
+    segment.index_.reserve((records.size() + blockRows - 1) / blockRows);
+
+    for (std::size_t begin = 0; begin < records.size(); begin += blockRows) {
+        const auto end = std::min(begin + blockRows, records.size());
+        if (segment.bytes_.size() > std::numeric_limits<std::uint32_t>::max()) {
+            throw std::length_error("archived audit segment is too large");
+        }
+        segment.index_.push_back(BlockIndexEntry{
+            .firstTicks = records[begin].ticks,
+            .lastTicks = records[end - 1].ticks,
+            .offset = static_cast<std::uint32_t>(segment.bytes_.size()),
+            .rows = static_cast<std::uint32_t>(end - begin)
+        });
+
+        auto previousTicks = records[begin].ticks;
+        std::int64_t previousKey = 0;
+        for (std::size_t i = begin; i < end; ++i) {
+            const auto& record = records[i];
+            util::AppendVarint(segment.bytes_, static_cast<std::uint64_t>(record.ticks - previousTicks));
+            util::AppendVarint(segment.bytes_, record.actorAction);
+            util::AppendVarint(segment.bytes_, util::ZigZagEncode(static_cast<std::int64_t>(record.encounterKey) - previousKey));
+            previousTicks = record.ticks;
+            previousKey = record.encounterKey;
+        }
+    }
+
+    segment.bytes_.shrink_to_fit();
+    segment.bulkPayloads_ = std::move(bulkPayloads);
+    return segment;
+}
+
+void ArchivedAuditSegment::DecodeRange(std::int64_t fromTicks,
+                                       std::int64_t toTicks,
+                                       std::vector<PackedAuditRecord>& out) const {
+    // Blocks are ordered by timestamp, so skip straight to the first block that can overlap.
+    auto block = std::lower_bound(index_.begin(), index_.end(), fromTicks,
+                                  [](const BlockIndexEntry& entry, std::int64_t ticks) {
+                                      return entry.lastTicks < ticks;
+                                  });
+
+    for (; block != index_.end() && block->firstTicks <= toTicks; ++block) {
+        std::size_t pos = block->offset;
+        auto ticks = block->firstTicks;
+        std::int64_t key = 0;
+        for (std::uint32_t row = 0; row < block->rows; ++row) {
+            const auto delta = util::ReadVarint(bytes_.data(), bytes_.size(), pos);
+            const auto actorAction = util::ReadVarint(bytes_.data(), bytes_.size(), pos);
+            const auto keyDelta = util::ReadVarint(bytes_.data(), bytes_.size(), pos);
+            if (!delta || !actorAction || !keyDelta) {
+                throw std::runtime_error("corrupt archived audit block");
+            }
+            ticks += static_cast<std::int64_t>(*delta);
+            key += util::ZigZagDecode(*keyDelta);
+            if (ticks < fromTicks || ticks > toTicks) {
+                continue;
+            }
+            out.push_back(PackedAuditRecord{
+                .ticks = ticks,
+                .actorAction = static_cast<std::uint32_t>(*actorAction),
+                .encounterKey = static_cast<std::uint32_t>(key)
+            });
+        }
+    }
+}
+
+std::int64_t ArchivedAuditSegment::minTicks() const {
+    return index_.empty() ? std::numeric_limits<std::int64_t>::max() : index_.front().firstTicks;
+}
+
+std::int64_t ArchivedAuditSegment::maxTicks() const {
+    return index_.empty() ? std::numeric_limits<std::int64_t>::min() : index_.back().lastTicks;
+}
+
+const std::vector<std::uint8_t>& ArchivedAuditSegment::bulkPayload(std::uint32_t key) const {
+    return bulkPayloads_.at(key);
+}
+
+std::size_t ArchivedAuditSegment::size() const {
+    return rows_;
+}
+
+std::size_t ArchivedAuditSegment::encodedBytes() const {
+    auto bytes = bytes_.size() + (index_.size() * sizeof(BlockIndexEntry));
+    for (const auto& payload : bulkPayloads_) {
+        bytes += payload.size();
+    }
+    return bytes;
+}
+
+}  // namespace encounter_service::storage
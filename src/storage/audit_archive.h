@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace encounter_service::storage {
+
+// Fixed-width audit row shared by hot columns and archived blocks.
+struct PackedAuditRecord {
+    std::int64_t ticks{0};
+    // Interned actor ID packed with the AuditAction (see CompactAuditLog).
+    std::uint32_t actorAction{0};
+    std::uint32_t encounterKey{0};
+};
+
+// Immutable archive of a sealed audit segment.
+// Rows are sorted by timestamp and split into blocks; each block stores the first timestamp in a
+// per-block index and encodes rows as varint timestamp deltas, varint actor/action IDs and
+// zigzag-varint encounter key deltas. Range reads decode only blocks overlapping the range.
+// Bulk rows keep their encoded key lists alongside the blocks, indexed by the row's encounter key.
+class ArchivedAuditSegment {
+public:
+    // Encodes `records` into blocks of at most `blockRows` rows. Bulk rows in `records` must
+    // reference `bulkPayloads` by index.
+    static ArchivedAuditSegment Encode(std::vector<PackedAuditRecord> records,
+                                       std::size_t blockRows,
+                                       std::vector<std::vector<std::uint8_t>> bulkPayloads = {});
+
+    // Appends records whose ticks fall in [`fromTicks`, `toTicks`] to `out`.
+    void DecodeRange(std::int64_t fromTicks, std::int64_t toTicks, std::vector<PackedAuditRecord>& out) const;
+
+    [[nodiscard]] std::int64_t minTicks() const;
+    [[nodiscard]] std::int64_t maxTicks() const;
+    // Returns the encoded key list of bulk payload `key`.
+    [[nodiscard]] const std::vector<std::uint8_t>& bulkPayload(std::uint32_t key) const;
+    // Returns the number of archived rows.
+    [[nodiscard]] std::size_t size() const;
+    // Returns the encoded rows, block index and bulk payload sizes in bytes.
+    [[nodiscard]] std::size_t encodedBytes() const;
+
+private:
+    struct BlockIndexEntry {
+        std::int64_t firstTicks{0};
+        std::int64_t lastTicks{0};
+        std::uint32_t offset{0};
+        std::uint32_t rows{0};
+    };
+
+    std::vector<BlockIndexEntry> index_;
+    std::vector<std::uint8_t> bytes_;
+    std::vector<std::vector<std::uint8_t>> bulkPayloads_;
+    std::size_t rows_{0};
+};
+
+}  // namespace encounter_service::storage
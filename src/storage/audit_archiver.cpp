@@ -0,0 +1,62 @@
+#include "src/storage/audit_archiver.h"
+
+#include <utility>
+#include <vector>
+
+namespace encounter_service::storage {
+
+AuditArchiver::AuditArchiver(InMemoryAuditRepository& repository,
+                             util::Clock& clock,
+                             std::chrono::milliseconds interval,
+                             std::optional<AuditHistorySink> historySink)
+    : repository_(repository),
+      clock_(clock),
+      interval_(interval),
+      historySink_(std::move(historySink)) {}
+
+AuditArchiver::~AuditArchiver() {
+    Stop();
+}
+
+void AuditArchiver::Start() {
+    std::lock_guard lock(mutex_);
+    if (thread_.joinable()) {
+        return;
+    }
+    stopping_ = false;
+    thread_ = std::thread([this]() { Run(); });
+}
+
+void AuditArchiver::Stop() {
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void AuditArchiver::Run() {
+    std::unique_lock lock(mutex_);
+    while (!wake_.wait_for(lock, interval_, [this]() { return stopping_; })) {
+        lock.unlock();
+        if (!historySink_) {
+            (void)repository_.ArchiveColdSegments(clock_.Now());
+        } else {
+            std::vector<std::vector<domain::AuditEntry>> archived;
+            (void)repository_.ArchiveColdSegments(clock_.Now(), &archived);
+            // A segment that fails to write is still archived in memory, so `GET /audit/encounters`
+            // keeps serving it; only the history route misses it.
+            for (auto& entries : archived) {
+                if (const auto path = SealAuditSegmentFile(historySink_->directory, std::move(entries))) {
+                    (void)historySink_->history->AddFile(*path);
+                }
+            }
+        }
+        lock.lock();
+    }
+}
+
+}  // namespace encounter_service::storage
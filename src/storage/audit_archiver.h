@@ -0,0 +1,57 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "src/storage/audit_segment_file.h"
+#include "src/storage/in_memory_audit_repo.h"
+#include "src/util/clock.h"
+
+namespace encounter_service::storage {
+
+// Where archived segments are also sealed as segment files for `GET /audit/encounters/history`.
+struct AuditHistorySink {
+    // Existing directory the `.audseg` files are written to.
+    std::string directory;
+    // Maps each file once it is written; must outlive the archiver.
+    MappedAuditHistory* history{nullptr};
+};
+
+// Background worker that periodically archives cold audit segments so compression never runs
+// on the request path. With a history sink, each archived segment is also written to disk and
+// served from then on by the history it is registered with.
+class AuditArchiver {
+public:
+    // Borrows `repository` and `clock`; both must outlive the archiver.
+    AuditArchiver(InMemoryAuditRepository& repository,
+                  util::Clock& clock,
+                  std::chrono::milliseconds interval,
+                  std::optional<AuditHistorySink> historySink = std::nullopt);
+    ~AuditArchiver();
+
+    AuditArchiver(const AuditArchiver&) = delete;
+    AuditArchiver& operator=(const AuditArchiver&) = delete;
+
+    // Starts the worker thread; no-op when already running.
+    void Start();
+    // Stops and joins the worker thread; no-op when not running.
+    void Stop();
+
+private:
+    void Run();
+
+    InMemoryAuditRepository& repository_;
+    util::Clock& clock_;
+    std::chrono::milliseconds interval_;
+    std::optional<AuditHistorySink> historySink_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stopping_{false};
+    std::thread thread_;
+};
+
+}  // namespace encounter_service::storage
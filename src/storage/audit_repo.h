@@ -21,8 +21,12 @@ public:
 
     // Appends `entry` to the audit trail.
     virtual void Append(const domain::AuditEntry& entry) = 0;
+    // Appends one access event covering `entry.encounterIds`; Query() expands it per encounter.
+    virtual void AppendBulk(const domain::BulkAuditEntry& entry) = 0;
     // Returns audit entries that match `range`.
     virtual std::vector<domain::AuditEntry> Query(const AuditDateRange& range) const = 0;
+    // Returns per-day (actor, action) counts for UTC days overlapping `range`.
+    virtual std::vector<domain::AuditRollup> QueryRollups(const AuditDateRange& range) const = 0;
 };
 
 }  // namespace encounter_service::storage
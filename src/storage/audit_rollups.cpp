@@ -0,0 +1,63 @@
+#include "src/storage/audit_rollups.h"
+
+#include <algorithm>
+#include <chrono>
+#include <tuple>
+
+namespace encounter_service::storage {
+
+namespace {
+
+using Days = std::chrono::duration<std::int64_t, std::ratio<86400>>;
+
+std::int64_t DayIndex(std::chrono::system_clock::time_point value) {
+    return std::chrono::floor<Days>(value).time_since_epoch().count();
+}
+
+std::uint64_t PackKey(StringInterner::Id actor, domain::AuditAction action) {
+    return (static_cast<std::uint64_t>(actor) << 32) | static_cast<std::uint64_t>(action);
+}
+
+}  // namespace
+
+void AuditRollupTable::Add(const domain::AuditEntry& entry) {
+    Add(entry.timestamp, entry.actor, entry.action);
+}
+
+void AuditRollupTable::Add(std::chrono::system_clock::time_point timestamp,
+                           std::string_view actor,
+                           domain::AuditAction action,
+                           std::uint64_t count) {
+    days_[DayIndex(timestamp)][PackKey(actors_.Intern(actor), action)] += count;
+}
+
+std::vector<domain::AuditRollup> AuditRollupTable::Query(const AuditDateRange& range) const {
+    std::vector<domain::AuditRollup> out;
+    if (range.from && range.to && *range.from > *range.to) {
+        return out;
+    }
+
+    auto it = range.from ? days_.lower_bound(DayIndex(*range.from)) : days_.begin();
+    const auto end = range.to ? days_.upper_bound(DayIndex(*range.to)) : days_.end();
+    for (; it != end; ++it) {
+        const auto day = std::chrono::system_clock::time_point{
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(Days{it->first})};
+        const auto dayBegin = out.size();
+        for (const auto& [key, count] : it->second) {
+            out.push_back(domain::AuditRollup{
+                .day = day,
+                .actor = actors_.Resolve(static_cast<StringInterner::Id>(key >> 32)),
+                .action = static_cast<domain::AuditAction>(key & 0xFFFFFFFFu),
+                .count = count
+            });
+        }
+        // Buckets within a day come from a hash map; sort them for deterministic output.
+        std::sort(out.begin() + static_cast<std::ptrdiff_t>(dayBegin), out.end(),
+                  [](const domain::AuditRollup& a, const domain::AuditRollup& b) {
+                      return std::tie(a.actor, a.action) < std::tie(b.actor, b.action);
+                  });
+    }
+    return out;
+}
+
+}  // namespace encounter_service::storage
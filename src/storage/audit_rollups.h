@@ -0,0 +1,38 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "src/domain/audit_models.h"
+#include "src/storage/audit_repo.h"
+#include "src/storage/string_interner.h"
+
+namespace encounter_service::storage {
+
+// Per-day audit counters keyed by (UTC day, actor, action), maintained incrementally on append
+// so aggregate queries cost O(days in range) instead of O(audit entries).
+// Not thread-safe; InMemoryAuditRepository serializes access.
+class AuditRollupTable {
+public:
+    // Counts `entry` toward its (day, actor, action) bucket.
+    void Add(const domain::AuditEntry& entry);
+    // Counts `count` entries recorded at `timestamp` by `actor` toward their bucket.
+    void Add(std::chrono::system_clock::time_point timestamp,
+             std::string_view actor,
+             domain::AuditAction action,
+             std::uint64_t count = 1);
+    // Returns rollups for UTC days overlapping `range`, ordered by day, then actor, then action.
+    // Bounds are day-granular: any day containing part of the range is included in full.
+    [[nodiscard]] std::vector<domain::AuditRollup> Query(const AuditDateRange& range) const;
+
+private:
+    // Key packs the interned actor ID (high 32 bits) with the AuditAction (low bits).
+    std::map<std::int64_t, std::unordered_map<std::uint64_t, std::uint64_t>> days_;
+    StringInterner actors_;
+};
+
+}  // namespace encounter_service::storage
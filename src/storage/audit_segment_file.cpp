@@ -0,0 +1,411 @@
+#include "src/storage/audit_segment_file.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "src/domain/audit_json.h"
+#include "src/util/json_writer.h"
+
+namespace encounter_service::storage {
+
+namespace {
+
+constexpr char kMagic[8] = {'E', 'N', 'C', 'A', 'U', 'D', 'S', '1'};
+constexpr unsigned kActionShift = 28;
+constexpr std::uint32_t kActorMask = (std::uint32_t{1} << kActionShift) - 1;
+constexpr std::uint32_t kMaxAction = static_cast<std::uint32_t>(domain::AuditAction::LIST_ENCOUNTERS);
+
+struct FileHeader {
+    char magic[8];
+    std::uint32_t recordCount;
+    std::uint32_t stringCount;
+    std::int64_t minTicks;
+    std::int64_t maxTicks;
+    std::uint64_t stringTableOffset;
+};
+
+struct FileRecord {
+    std::int64_t ticks;
+    std::uint32_t actorAction;
+    std::uint32_t encounterRef;
+};
+
+static_assert(sizeof(FileHeader) == 40);
+static_assert(sizeof(FileRecord) == 16);
+
+const FileHeader& HeaderOf(const std::uint8_t* data) {
+    return *reinterpret_cast<const FileHeader*>(data);
+}
+
+const FileRecord* RecordsOf(const std::uint8_t* data) {
+    return reinterpret_cast<const FileRecord*>(data + sizeof(FileHeader));
+}
+
+const std::uint32_t* StringOffsetsOf(const std::uint8_t* data) {
+    return reinterpret_cast<const std::uint32_t*>(data + HeaderOf(data).stringTableOffset);
+}
+
+// Record fields as kAuditEntryJsonFields reads them; the strings point into the string table.
+struct MappedAuditEntry {
+    domain::AuditAction action;
+    util::EscapedJsonString actor;
+    util::EscapedJsonString encounterId;
+    std::chrono::system_clock::time_point timestamp;
+};
+
+class StringTableBuilder {
+public:
+    std::uint32_t Add(const std::string& value) {
+        const auto [it, inserted] = ids_.try_emplace(value, static_cast<std::uint32_t>(offsets_.size()));
+        if (inserted) {
+            offsets_.push_back(static_cast<std::uint32_t>(bytes_.size()));
+            util::AppendJsonEscaped(bytes_, value);
+        }
+        return it->second;
+    }
+
+    [[nodiscard]] std::uint32_t size() const { return static_cast<std::uint32_t>(offsets_.size()); }
+
+    void WriteTo(std::ostream& out) {
+        offsets_.push_back(static_cast<std::uint32_t>(bytes_.size()));
+        out.write(reinterpret_cast<const char*>(offsets_.data()),
+                  static_cast<std::streamsize>(offsets_.size() * sizeof(std::uint32_t)));
+        out.write(bytes_.data(), static_cast<std::streamsize>(bytes_.size()));
+    }
+
+private:
+    std::unordered_map<std::string, std::uint32_t> ids_;
+    std::vector<std::uint32_t> offsets_;
+    std::string bytes_;
+};
+
+// Checks the header and string table bounds once so range queries can read without checks.
+bool IsWellFormed(const std::uint8_t* data, std::size_t size) {
+    if (size < sizeof(FileHeader)) {
+        return false;
+    }
+    const auto& header = HeaderOf(data);
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+        return false;
+    }
+    const auto recordsEnd = sizeof(FileHeader) + std::uint64_t{header.recordCount} * sizeof(FileRecord);
+    const auto offsetsBytes = (std::uint64_t{header.stringCount} + 1) * sizeof(std::uint32_t);
+    // Compared as `offsetsBytes > size - offset` so a crafted offset near 2^64 cannot wrap the sum.
+    if (header.stringTableOffset < recordsEnd || header.stringTableOffset % alignof(std::uint32_t) != 0 ||
+        header.stringTableOffset > size || offsetsBytes > size - header.stringTableOffset) {
+        return false;
+    }
+    const auto* offsets = StringOffsetsOf(data);
+    const auto bytesAvailable = size - header.stringTableOffset - offsetsBytes;
+    for (std::uint32_t i = 0; i < header.stringCount; ++i) {
+        if (offsets[i] > offsets[i + 1]) {
+            return false;
+        }
+    }
+    if (offsets[header.stringCount] > bytesAvailable) {
+        return false;
+    }
+    const auto* records = RecordsOf(data);
+    for (std::uint32_t i = 0; i < header.recordCount; ++i) {
+        if ((records[i].actorAction & kActorMask) >= header.stringCount ||
+            (records[i].actorAction >> kActionShift) > kMaxAction ||
+            records[i].encounterRef >= header.stringCount ||
+            (i > 0 && records[i - 1].ticks > records[i].ticks)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+bool WriteAuditSegmentFile(const std::string& path, std::vector<domain::AuditEntry> entries) {
+    std::sort(entries.begin(), entries.end(), [](const auto& lhs, const auto& rhs) {
+        return std::tie(lhs.timestamp, lhs.encounterId, lhs.actor, lhs.action) <
+               std::tie(rhs.timestamp, rhs.encounterId, rhs.actor, rhs.action);
+    });
+
+    StringTableBuilder strings;
+    std::vector<FileRecord> records;
+    records.reserve(entries.size());
+    for (const auto& entry : entries) {
+        const auto actor = strings.Add(entry.actor);
+        if (actor > kActorMask) {
+            return false;
+        }
+        records.push_back(FileRecord{
+            .ticks = entry.timestamp.time_since_epoch().count(),
+            .actorAction = actor | (static_cast<std::uint32_t>(entry.action) << kActionShift),
+            .encounterRef = strings.Add(entry.encounterId)
+        });
+    }
+
+    FileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.recordCount = static_cast<std::uint32_t>(records.size());
+    header.stringCount = strings.size();
+    header.minTicks = records.empty() ? 0 : records.front().ticks;
+    header.maxTicks = records.empty() ? 0 : records.back().ticks;
+    header.stringTableOffset = sizeof(FileHeader) + records.size() * sizeof(FileRecord);
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(records.data()),
+              static_cast<std::streamsize>(records.size() * sizeof(FileRecord)));
+    strings.WriteTo(out);
+    return static_cast<bool>(out.flush());
+}
+
+std::optional<std::string> SealAuditSegmentFile(const std::string& directory,
+                                                std::vector<domain::AuditEntry> entries) {
+    std::int64_t minTicks = 0;
+    std::int64_t maxTicks = 0;
+    if (!entries.empty()) {
+        const auto [lowest, highest] = std::minmax_element(entries.begin(), entries.end(), [](const auto& lhs,
+                                                                                             const auto& rhs) {
+            return lhs.timestamp < rhs.timestamp;
+        });
+        minTicks = lowest->timestamp.time_since_epoch().count();
+        maxTicks = highest->timestamp.time_since_epoch().count();
+    }
+
+    const std::filesystem::path dir(directory);
+    const auto stem = "audit-" + std::to_string(minTicks) + "-" + std::to_string(maxTicks);
+    std::error_code error;
+    for (int attempt = 0; attempt < 1000; ++attempt) {
+        const auto name = attempt == 0 ? stem : stem + "-" + std::to_string(attempt);
+        const auto path = dir / (name + kAuditSegmentFileExtension);
+        if (std::filesystem::exists(path, error)) {
+            continue;
+        }
+        const auto staging = dir / (name + kAuditSegmentFileExtension + ".tmp");
+        if (!WriteAuditSegmentFile(staging.string(), std::move(entries))) {
+            std::filesystem::remove(staging, error);
+            return std::nullopt;
+        }
+        std::filesystem::rename(staging, path, error);
+        if (error) {
+            std::filesystem::remove(staging, error);
+            return std::nullopt;
+        }
+        return path.string();
+    }
+    return std::nullopt;
+}
+
+MappedAuditSegment::MappedAuditSegment(const std::uint8_t* data, std::size_t size)
+    : data_(data), size_(size) {}
+
+MappedAuditSegment::MappedAuditSegment(MappedAuditSegment&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+MappedAuditSegment& MappedAuditSegment::operator=(MappedAuditSegment&& other) noexcept {
+    if (this != &other) {
+        MappedAuditSegment released(std::move(*this));
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+}
+
+MappedAuditSegment::~MappedAuditSegment() {
+#if !defined(_WIN32)
+    if (data_ != nullptr) {
+        ::munmap(const_cast<std::uint8_t*>(data_), size_);
+    }
+#endif
+}
+
+std::optional<MappedAuditSegment> MappedAuditSegment::Open(const std::string& path) {
+#if defined(_WIN32)
+    (void)path;
+    return std::nullopt;
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return std::nullopt;
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(FileHeader))) {
+        ::close(fd);
+        return std::nullopt;
+    }
+    const auto size = static_cast<std::size_t>(info.st_size);
+    void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return std::nullopt;
+    }
+    MappedAuditSegment segment(static_cast<const std::uint8_t*>(mapping), size);
+    if (!IsWellFormed(segment.data_, segment.size_)) {
+        return std::nullopt;
+    }
+    return segment;
+#endif
+}
+
+std::int64_t MappedAuditSegment::minTicks() const {
+    return HeaderOf(data_).minTicks;
+}
+
+std::int64_t MappedAuditSegment::maxTicks() const {
+    return HeaderOf(data_).maxTicks;
+}
+
+std::size_t MappedAuditSegment::size() const {
+    return HeaderOf(data_).recordCount;
+}
+
+std::string_view MappedAuditSegment::StringAt(std::uint32_t index) const {
+    const auto& header = HeaderOf(data_);
+    const auto* offsets = StringOffsetsOf(data_);
+    const auto* bytes = reinterpret_cast<const char*>(offsets + header.stringCount + 1);
+    return std::string_view(bytes + offsets[index], offsets[index + 1] - offsets[index]);
+}
+
+std::pair<std::size_t, std::size_t> MappedAuditSegment::RecordRange(const AuditDateRange& range) const {
+    const auto fromTicks = range.from ? range.from->time_since_epoch().count()
+                                      : std::numeric_limits<std::int64_t>::min();
+    const auto toTicks = range.to ? range.to->time_since_epoch().count()
+                                  : std::numeric_limits<std::int64_t>::max();
+    if (fromTicks > toTicks || size() == 0 || toTicks < minTicks() || fromTicks > maxTicks()) {
+        return {0, 0};
+    }
+
+    const auto* begin = RecordsOf(data_);
+    const auto* end = begin + size();
+    const auto* lower = std::lower_bound(begin, end, fromTicks, [](const FileRecord& record, std::int64_t ticks) {
+        return record.ticks < ticks;
+    });
+    const auto* upper = std::upper_bound(lower, end, toTicks, [](std::int64_t ticks, const FileRecord& record) {
+        return ticks < record.ticks;
+    });
+    return {static_cast<std::size_t>(lower - begin), static_cast<std::size_t>(upper - begin)};
+}
+
+void MappedAuditSegment::AppendJsonRecord(std::size_t position, std::string& out) const {
+    const auto& record = RecordsOf(data_)[position];
+    domain::AppendAuditEntryJsonObject(
+        out,
+        MappedAuditEntry{
+            .action = static_cast<domain::AuditAction>(record.actorAction >> kActionShift),
+            .actor = {StringAt(record.actorAction & kActorMask)},
+            .encounterId = {StringAt(record.encounterRef)},
+            .timestamp = std::chrono::system_clock::time_point(std::chrono::system_clock::duration(record.ticks))
+        });
+}
+
+std::size_t MappedAuditSegment::AppendJsonRange(const AuditDateRange& range, std::string& out, bool& first) const {
+    const auto [lower, upper] = RecordRange(range);
+    for (auto position = lower; position < upper; ++position) {
+        if (!first) {
+            out += ',';
+        }
+        first = false;
+        AppendJsonRecord(position, out);
+    }
+    return upper - lower;
+}
+
+AuditHistoryJsonStream::AuditHistoryJsonStream(std::vector<std::shared_ptr<const MappedAuditSegment>> segments,
+                                               AuditDateRange range)
+    : segments_(std::move(segments)),
+      range_(std::move(range)) {}
+
+bool AuditHistoryJsonStream::Fill(std::string& out, std::size_t minBytes) {
+    if (!started_) {
+        started_ = true;
+        out += '[';
+        if (!segments_.empty()) {
+            std::tie(next_, end_) = segments_.front()->RecordRange(range_);
+        }
+    }
+    while (!finished_ && out.size() < minBytes) {
+        if (next_ == end_) {
+            if (++segment_ >= segments_.size()) {
+                out += ']';
+                finished_ = true;
+                break;
+            }
+            std::tie(next_, end_) = segments_[segment_]->RecordRange(range_);
+            continue;
+        }
+        if (!firstRecord_) {
+            out += ',';
+        }
+        firstRecord_ = false;
+        segments_[segment_]->AppendJsonRecord(next_++, out);
+    }
+    return finished_;
+}
+
+std::size_t MappedAuditHistory::AddDirectory(const std::string& directory) {
+    std::size_t added = 0;
+    std::error_code error;
+    for (const auto& item : std::filesystem::directory_iterator(directory, error)) {
+        if (!item.is_regular_file(error) || item.path().extension() != kAuditSegmentFileExtension) {
+            continue;
+        }
+        if (AddFile(item.path().string())) {
+            ++added;
+        }
+    }
+    return added;
+}
+
+bool MappedAuditHistory::AddFile(const std::string& path) {
+    auto segment = MappedAuditSegment::Open(path);
+    if (!segment) {
+        return false;
+    }
+    Insert(std::move(*segment));
+    return true;
+}
+
+void MappedAuditHistory::Insert(MappedAuditSegment segment) {
+    auto shared = std::make_shared<const MappedAuditSegment>(std::move(segment));
+    std::unique_lock lock(mutex_);
+    const auto position = std::upper_bound(segments_.begin(), segments_.end(), shared->minTicks(),
+                                           [](std::int64_t ticks, const auto& existing) {
+                                               return ticks < existing->minTicks();
+                                           });
+    segments_.insert(position, std::move(shared));
+}
+
+std::vector<std::shared_ptr<const MappedAuditSegment>> MappedAuditHistory::Snapshot() const {
+    std::shared_lock lock(mutex_);
+    return segments_;
+}
+
+void MappedAuditHistory::WriteJsonArray(const AuditDateRange& range, std::string& out) const {
+    StreamJsonArray(range).Fill(out, std::numeric_limits<std::size_t>::max());
+}
+
+AuditHistoryJsonStream MappedAuditHistory::StreamJsonArray(const AuditDateRange& range) const {
+    return AuditHistoryJsonStream(Snapshot(), range);
+}
+
+std::size_t MappedAuditHistory::segmentCount() const {
+    std::shared_lock lock(mutex_);
+    return segments_.size();
+}
+
+}  // namespace encounter_service::storage
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "src/domain/audit_models.h"
+#include "src/storage/audit_repo.h"
+
+namespace encounter_service::storage {
+
+// Sealed on-disk audit segment layout (host byte order):
+// - 40-byte header: magic, record count, string count, min/max ticks, string table offset
+// - fixed-width 16-byte records sorted by (timestamp, encounterId, actor):
+//   int64 ticks, uint32 actor string index packed with the action, uint32 encounterId string index
+// - string table: uint32 offsets[count + 1] followed by JSON-escaped string bytes
+// Strings are stored pre-escaped so readers can copy them straight into JSON output.
+inline constexpr const char* kAuditSegmentFileExtension = ".audseg";
+
+// Writes `entries` as a sealed audit segment file at `path`. Returns false on I/O failure; strings
+// that are not valid UTF-8 throw, as they would when serialized by `GET /audit/encounters`.
+bool WriteAuditSegmentFile(const std::string& path, std::vector<domain::AuditEntry> entries);
+
+// Writes `entries` as a new segment file in `directory`, named after its time range and never
+// replacing an existing file. The file is written under a temporary name and renamed into place, so
+// a directory scan never sees it half written. Returns its path, or std::nullopt on I/O failure.
+std::optional<std::string> SealAuditSegmentFile(const std::string& directory,
+                                                std::vector<domain::AuditEntry> entries);
+
+// Read-only memory mapping of one sealed audit segment file. Range queries binary-search the
+// fixed-width timestamp field in place and serialize matches without per-entry heap allocation.
+class MappedAuditSegment {
+public:
+    // Maps the segment at `path`, or returns std::nullopt when it is missing or malformed.
+    static std::optional<MappedAuditSegment> Open(const std::string& path);
+
+    MappedAuditSegment(MappedAuditSegment&& other) noexcept;
+    MappedAuditSegment& operator=(MappedAuditSegment&& other) noexcept;
+    MappedAuditSegment(const MappedAuditSegment&) = delete;
+    MappedAuditSegment& operator=(const MappedAuditSegment&) = delete;
+    ~MappedAuditSegment();
+
+    [[nodiscard]] std::int64_t minTicks() const;
+    [[nodiscard]] std::int64_t maxTicks() const;
+    [[nodiscard]] std::size_t size() const;
+
+    // Appends entries inside `range` to `out` as comma-separated JSON objects matching the
+    // `GET /audit/encounters` entry shape. `first` tracks whether a separator is needed.
+    // Returns the number of entries written.
+    std::size_t AppendJsonRange(const AuditDateRange& range, std::string& out, bool& first) const;
+    // Positions [first, last) of the records inside `range`.
+    [[nodiscard]] std::pair<std::size_t, std::size_t> RecordRange(const AuditDateRange& range) const;
+    // Appends the record at `position` to `out` as one JSON object, as AppendJsonRange() does.
+    void AppendJsonRecord(std::size_t position, std::string& out) const;
+
+private:
+    MappedAuditSegment(const std::uint8_t* data, std::size_t size);
+
+    [[nodiscard]] std::string_view StringAt(std::uint32_t index) const;
+
+    const std::uint8_t* data_{nullptr};
+    std::size_t size_{0};
+};
+
+// Serializes a range query over a snapshot of mapped segments a batch at a time, so a response
+// can be streamed straight from the mappings without building the whole array first.
+class AuditHistoryJsonStream {
+public:
+    AuditHistoryJsonStream(std::vector<std::shared_ptr<const MappedAuditSegment>> segments, AuditDateRange range);
+
+    // Appends the next part of the JSON array to `out`, stopping once `out` holds at least
+    // `minBytes` or the array is closed. Returns true once the closing bracket has been written.
+    bool Fill(std::string& out, std::size_t minBytes);
+
+private:
+    std::vector<std::shared_ptr<const MappedAuditSegment>> segments_;
+    AuditDateRange range_;
+    std::size_t segment_{0};
+    // Remaining records [next_, end_) of the current segment.
+    std::size_t next_{0};
+    std::size_t end_{0};
+    bool started_{false};
+    bool firstRecord_{true};
+    bool finished_{false};
+};
+
+// Collection of mapped segment files that together hold historical audit data. Segments may be
+// added while requests read; readers work on a snapshot of the segments present when they started.
+class MappedAuditHistory {
+public:
+    MappedAuditHistory() = default;
+    MappedAuditHistory(const MappedAuditHistory&) = delete;
+    MappedAuditHistory& operator=(const MappedAuditHistory&) = delete;
+
+    // Maps every segment file in `directory`. Unreadable or malformed files are skipped.
+    // Returns the number of segments added.
+    std::size_t AddDirectory(const std::string& directory);
+    // Maps the segment file at `path`; returns false when it is missing or malformed.
+    bool AddFile(const std::string& path);
+
+    // Writes entries inside `range` to `out` as a JSON array. Segments are expected to cover
+    // disjoint time ranges; entries are ordered within each segment.
+    void WriteJsonArray(const AuditDateRange& range, std::string& out) const;
+    // Streams the array WriteJsonArray() writes over the segments present now.
+    [[nodiscard]] AuditHistoryJsonStream StreamJsonArray(const AuditDateRange& range) const;
+    [[nodiscard]] std::size_t segmentCount() const;
+
+private:
+    void Insert(MappedAuditSegment segment);
+    [[nodiscard]] std::vector<std::shared_ptr<const MappedAuditSegment>> Snapshot() const;
+
+    mutable std::shared_mutex mutex_;
+    // Ordered by earliest timestamp.
+    std::vector<std::shared_ptr<const MappedAuditSegment>> segments_;
+};
+
+}  // namespace encounter_service::storage
@@ -0,0 +1,185 @@
+#include "src/storage/caching_encounter_repo.h"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+namespace encounter_service::storage {
+
+namespace {
+
+// Approximates the serialized size of `value` by walking the tree: strings and keys count their raw
+// length plus punctuation, and every other scalar a fixed width. Nothing is serialized or allocated.
+std::size_t EstimateJsonBytes(const nlohmann::json& value) {
+#if __has_include("vendor/json.hpp")
+    constexpr std::size_t kScalarBytes = 8;
+    switch (value.type()) {
+        case nlohmann::json::value_t::object: {
+            std::size_t bytes = 2;
+            for (const auto& [key, member] : value.get_ref<const nlohmann::json::object_t&>()) {
+                bytes += key.size() + 4 + EstimateJsonBytes(member);
+            }
+            return bytes;
+        }
+        case nlohmann::json::value_t::array: {
+            std::size_t bytes = 2;
+            for (const auto& element : value.get_ref<const nlohmann::json::array_t&>()) {
+                bytes += 1 + EstimateJsonBytes(element);
+            }
+            return bytes;
+        }
+        case nlohmann::json::value_t::string:
+            return value.get_ref<const nlohmann::json::string_t&>().size() + 2;
+        default:
+            return kScalarBytes;
+    }
+#else
+    return value.dump().size();
+#endif
+}
+
+}  // namespace
+
+std::size_t EstimateEncounterBytes(const domain::Encounter& encounter) {
+    return sizeof(domain::Encounter) + encounter.encounterId.size() + encounter.patientId.size() +
+           encounter.providerId.size() + encounter.encounterType.size() + encounter.metadata.createdBy.size() +
+           encounter.etag.size() + EstimateJsonBytes(encounter.clinicalData);
+}
+
+CachingEncounterRepository::CachingEncounterRepository(EncounterRepository& backing, EncounterCacheOptions options)
+    : backing_(backing),
+      shardCount_(std::max<std::size_t>(options.shardCount, 1)) {
+    shardBudget_ = options.maxBytes / shardCount_;
+    shards_ = std::make_unique<Shard[]>(shardCount_);
+}
+
+CachingEncounterRepository::Shard& CachingEncounterRepository::ShardFor(const std::string& encounterId) const {
+    return shards_[std::hash<std::string>{}(encounterId) % shardCount_];
+}
+
+domain::Encounter CachingEncounterRepository::Create(domain::Encounter encounter) {
+    auto persisted = backing_.Create(std::move(encounter));
+    Invalidate(persisted.encounterId);
+    return persisted;
+}
+
+std::optional<domain::Encounter> CachingEncounterRepository::GetById(const std::string& encounterId) const {
+    if (const auto cached = Lookup(encounterId)) {
+        return *cached;
+    }
+    auto found = backing_.GetById(encounterId);
+    if (found) {
+        Insert(*found);
+    }
+    return found;
+}
+
+std::vector<std::optional<domain::Encounter>> CachingEncounterRepository::GetByIds(
+    const std::vector<std::string>& encounterIds) const {
+    std::vector<std::optional<domain::Encounter>> found;
+    found.reserve(encounterIds.size());
+    std::vector<std::string> missingIds;
+    std::vector<std::size_t> missingSlots;
+    for (std::size_t i = 0; i < encounterIds.size(); ++i) {
+        if (const auto cached = Lookup(encounterIds[i])) {
+            found.emplace_back(*cached);
+        } else {
+            found.emplace_back();
+            missingIds.push_back(encounterIds[i]);
+            missingSlots.push_back(i);
+        }
+    }
+    if (missingIds.empty()) {
+        return found;
+    }
+
+    // Misses are resolved with one backing call so the batch still costs a single backend pass.
+    auto fetched = backing_.GetByIds(missingIds);
+    for (std::size_t i = 0; i < missingSlots.size() && i < fetched.size(); ++i) {
+        if (fetched[i]) {
+            Insert(*fetched[i]);
+            found[missingSlots[i]] = std::move(fetched[i]);
+        }
+    }
+    return found;
+}
+
+std::vector<domain::Encounter> CachingEncounterRepository::Query(const EncounterQueryFilters& filters,
+                                                                 const util::RequestContext& context) const {
+    return backing_.Query(filters, context);
+}
+
+std::uint64_t CachingEncounterRepository::WriteGeneration() const {
+    return backing_.WriteGeneration();
+}
+
+EncounterCacheStats CachingEncounterRepository::stats() const {
+    EncounterCacheStats stats{};
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.misses = misses_.load(std::memory_order_relaxed);
+    stats.evictions = evictions_.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < shardCount_; ++i) {
+        std::lock_guard lock(shards_[i].mutex);
+        stats.entries += shards_[i].index.size();
+        stats.bytes += shards_[i].bytes;
+    }
+    return stats;
+}
+
+std::shared_ptr<const domain::Encounter> CachingEncounterRepository::Lookup(const std::string& encounterId) const {
+    auto& shard = ShardFor(encounterId);
+    std::lock_guard lock(shard.mutex);
+    const auto it = shard.index.find(encounterId);
+    if (it == shard.index.end()) {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    return it->second->encounter;
+}
+
+void CachingEncounterRepository::Invalidate(const std::string& encounterId) const {
+    auto& shard = ShardFor(encounterId);
+    std::lock_guard lock(shard.mutex);
+    EraseLocked(shard, encounterId);
+}
+
+void CachingEncounterRepository::EraseLocked(Shard& shard, const std::string& encounterId) {
+    if (const auto it = shard.index.find(encounterId); it != shard.index.end()) {
+        shard.bytes -= it->second->bytes;
+        shard.lru.erase(it->second);
+        shard.index.erase(it);
+    }
+}
+
+void CachingEncounterRepository::Insert(const domain::Encounter& encounter) const {
+    // The entry also stores its own key alongside the encounter.
+    const auto bytes = EstimateEncounterBytes(encounter) + encounter.encounterId.size();
+    auto& shard = ShardFor(encounter.encounterId);
+    // Entries larger than a whole shard would only evict everything else and then be evicted.
+    if (bytes > shardBudget_) {
+        std::lock_guard lock(shard.mutex);
+        EraseLocked(shard, encounter.encounterId);
+        return;
+    }
+    // Copied before locking so the shard is never held across a payload copy.
+    auto cached = std::make_shared<const domain::Encounter>(encounter);
+    std::lock_guard lock(shard.mutex);
+
+    EraseLocked(shard, encounter.encounterId);
+
+    while (shard.bytes + bytes > shardBudget_ && !shard.lru.empty()) {
+        auto& victim = shard.lru.back();
+        shard.bytes -= victim.bytes;
+        shard.index.erase(victim.key);
+        shard.lru.pop_back();
+        evictions_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    shard.lru.push_front(Entry{.key = encounter.encounterId, .encounter = std::move(cached), .bytes = bytes});
+    shard.index.emplace(shard.lru.front().key, shard.lru.begin());
+    shard.bytes += bytes;
+}
+
+}  // namespace encounter_service::storage
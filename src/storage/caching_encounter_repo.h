@@ -0,0 +1,94 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "src/storage/encounter_repo.h"
+
+namespace encounter_service::storage {
+
+struct EncounterCacheOptions {
+    // Upper bound on the estimated size of cached encounters, split evenly across shards.
+    std::size_t maxBytes{std::size_t{64} << 20};
+    // Independent LRU shards; keys are assigned by hash so lookups for different IDs rarely contend.
+    std::size_t shardCount{16};
+};
+
+struct EncounterCacheStats {
+    std::uint64_t hits{0};
+    std::uint64_t misses{0};
+    std::uint64_t evictions{0};
+    std::size_t entries{0};
+    std::size_t bytes{0};
+};
+
+// Approximates the heap footprint of one encounter for cache budgeting. clinicalData is measured
+// by a walk that approximates its serialized size, which tracks the parsed tree closely enough;
+// it runs on every cache insert, so it neither serializes nor allocates.
+[[nodiscard]] std::size_t EstimateEncounterBytes(const domain::Encounter& encounter);
+
+// Read-through decorator that keeps recently read encounters in a sharded LRU bounded by
+// estimated bytes (clinicalData sizes vary too much for an entry-count bound).
+// Create() writes through and invalidates the cached copy, so the payload is not copied a second
+// time on the write path; Query() is passed through uncached.
+// The cache itself is thread-safe; concurrent use still requires a thread-safe backing repository.
+class CachingEncounterRepository final : public EncounterRepository {
+public:
+    // Borrows `backing`, which must outlive the decorator.
+    explicit CachingEncounterRepository(EncounterRepository& backing, EncounterCacheOptions options = {});
+
+    CachingEncounterRepository(const CachingEncounterRepository&) = delete;
+    CachingEncounterRepository& operator=(const CachingEncounterRepository&) = delete;
+
+    domain::Encounter Create(domain::Encounter encounter) override;
+    std::optional<domain::Encounter> GetById(const std::string& encounterId) const override;
+    std::vector<std::optional<domain::Encounter>> GetByIds(const std::vector<std::string>& encounterIds) const override;
+    std::vector<domain::Encounter> Query(const EncounterQueryFilters& filters,
+                                         const util::RequestContext& context) const override;
+    std::uint64_t WriteGeneration() const override;
+
+    [[nodiscard]] EncounterCacheStats stats() const;
+
+private:
+    struct Entry {
+        std::string key;
+        // Immutable once cached, so readers copy it after releasing the shard lock.
+        std::shared_ptr<const domain::Encounter> encounter;
+        std::size_t bytes{0};
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        // Most recently used at the front.
+        std::list<Entry> lru;
+        std::unordered_map<std::string, std::list<Entry>::iterator> index;
+        std::size_t bytes{0};
+    };
+
+    [[nodiscard]] Shard& ShardFor(const std::string& encounterId) const;
+    // Returns the cached encounter, or nullptr, and marks it most recently used.
+    [[nodiscard]] std::shared_ptr<const domain::Encounter> Lookup(const std::string& encounterId) const;
+    void Insert(const domain::Encounter& encounter) const;
+    void Invalidate(const std::string& encounterId) const;
+    // Removes `encounterId` from `shard`. Requires `shard.mutex`.
+    static void EraseLocked(Shard& shard, const std::string& encounterId);
+
+    EncounterRepository& backing_;
+    std::size_t shardBudget_{0};
+    std::unique_ptr<Shard[]> shards_;
+    std::size_t shardCount_{0};
+
+    mutable std::atomic<std::uint64_t> hits_{0};
+    mutable std::atomic<std::uint64_t> misses_{0};
+    mutable std::atomic<std::uint64_t> evictions_{0};
+};
+
+}  // namespace encounter_service::storage
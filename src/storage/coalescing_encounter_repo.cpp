@@ -0,0 +1,136 @@
+#include "src/storage/coalescing_encounter_repo.h"
+
+#include <chrono>
+#include <exception>
+#include <utility>
+
+namespace encounter_service::storage {
+
+namespace {
+
+// How often a waiter re-checks its own RequestContext while the leader is still running.
+constexpr std::chrono::milliseconds kWaiterPollInterval{10};
+
+// Length-prefixed so values containing separators cannot collide with other field layouts.
+void AppendField(std::string& key, const std::optional<std::string>& value) {
+    if (!value) {
+        key += "-;";
+        return;
+    }
+    key += std::to_string(value->size());
+    key += ':';
+    key += *value;
+    key += ';';
+}
+
+void AppendField(std::string& key, const std::optional<std::chrono::system_clock::time_point>& value) {
+    if (!value) {
+        key += "-;";
+        return;
+    }
+    key += std::to_string(value->time_since_epoch().count());
+    key += ';';
+}
+
+}  // namespace
+
+std::string NormalizeQueryFilters(const EncounterQueryFilters& filters) {
+    std::string key;
+    AppendField(key, filters.patientId);
+    AppendField(key, filters.providerId);
+    AppendField(key, filters.encounterDateFrom);
+    AppendField(key, filters.encounterDateTo);
+    AppendField(key, filters.encounterType);
+    key += std::to_string(filters.limit);
+    key += ';';
+    key += std::to_string(filters.offset);
+    return key;
+}
+
+CoalescingEncounterRepository::CoalescingEncounterRepository(EncounterRepository& backing)
+    : backing_(backing) {}
+
+domain::Encounter CoalescingEncounterRepository::Create(domain::Encounter encounter) {
+    return backing_.Create(std::move(encounter));
+}
+
+std::optional<domain::Encounter> CoalescingEncounterRepository::GetById(const std::string& encounterId) const {
+    return backing_.GetById(encounterId);
+}
+
+std::vector<std::optional<domain::Encounter>> CoalescingEncounterRepository::GetByIds(
+    const std::vector<std::string>& encounterIds) const {
+    return backing_.GetByIds(encounterIds);
+}
+
+std::vector<domain::Encounter> CoalescingEncounterRepository::Query(const EncounterQueryFilters& filters,
+                                                                    const util::RequestContext& context) const {
+    return *QueryShared(filters, context);
+}
+
+SharedEncounters CoalescingEncounterRepository::QueryShared(const EncounterQueryFilters& filters,
+                                                            const util::RequestContext& context) const {
+    // Keyed by write generation too, so a caller never joins a flight that started before a write
+    // it has already observed (see EncounterRepository::WriteGeneration()).
+    auto key = NormalizeQueryFilters(filters);
+    key += ';';
+    key += std::to_string(backing_.WriteGeneration());
+
+    std::promise<SharedEncounters> leader;
+    {
+        std::unique_lock lock(mutex_);
+        if (const auto it = inFlight_.find(key); it != inFlight_.end()) {
+            coalesced_.fetch_add(1, std::memory_order_relaxed);
+            auto pending = it->second.result;
+            lock.unlock();
+
+            // Waiters honor their own deadline rather than the leader's.
+            while (pending.wait_for(kWaiterPollInterval) != std::future_status::ready) {
+                context.ThrowIfDone();
+            }
+            try {
+                return pending.get();
+            } catch (const util::RequestCancelled&) {
+                // The leader's request gave up, which says nothing about this one: run or join again.
+                context.ThrowIfDone();
+                return QueryShared(filters, context);
+            }
+        }
+        inFlight_.emplace(key, Flight{.result = leader.get_future().share()});
+    }
+
+    executions_.fetch_add(1, std::memory_order_relaxed);
+    SharedEncounters result;
+    try {
+        result = backing_.QueryShared(filters, context);
+    } catch (...) {
+        // Waiters observe the same failure rather than hanging on an abandoned promise.
+        {
+            std::lock_guard lock(mutex_);
+            inFlight_.erase(key);
+        }
+        leader.set_exception(std::current_exception());
+        throw;
+    }
+
+    {
+        std::lock_guard lock(mutex_);
+        inFlight_.erase(key);
+    }
+    // Waiters share the leader's rows; none of them copies the result.
+    leader.set_value(result);
+    return result;
+}
+
+std::uint64_t CoalescingEncounterRepository::WriteGeneration() const {
+    return backing_.WriteGeneration();
+}
+
+QueryCoalescingStats CoalescingEncounterRepository::stats() const {
+    return QueryCoalescingStats{
+        .executions = executions_.load(std::memory_order_relaxed),
+        .coalesced = coalesced_.load(std::memory_order_relaxed),
+    };
+}
+
+}  // namespace encounter_service::storage
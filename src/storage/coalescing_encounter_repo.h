@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "src/storage/encounter_repo.h"
+
+namespace encounter_service::storage {
+
+struct QueryCoalescingStats {
+    // Queries that ran against the backing repository.
+    std::uint64_t executions{0};
+    // Queries answered by joining an identical in-flight execution instead of running their own.
+    std::uint64_t coalesced{0};
+};
+
+// Returns a canonical encoding of `filters` such that two filter sets produce the same key exactly
+// when the backing repository would return the same rows for them.
+[[nodiscard]] std::string NormalizeQueryFilters(const EncounterQueryFilters& filters);
+
+// Decorator that collapses identical concurrent Query() calls into one backing execution
+// ("singleflight"). Callers that arrive while a query with the same normalized filters is in flight
+// wait for it and share its immutable result: QueryShared() hands every caller the same rows, and
+// Query() copies them for callers that need their own vector. Nothing is cached once the
+// execution finishes, so later calls always observe fresh data. Other operations pass through.
+// The leader runs with its own RequestContext; waiters stop waiting at their own deadline, and
+// re-run the query if the leader was cancelled while they still have time.
+class CoalescingEncounterRepository final : public EncounterRepository {
+public:
+    // Borrows `backing`, which must outlive the decorator.
+    explicit CoalescingEncounterRepository(EncounterRepository& backing);
+
+    CoalescingEncounterRepository(const CoalescingEncounterRepository&) = delete;
+    CoalescingEncounterRepository& operator=(const CoalescingEncounterRepository&) = delete;
+
+    domain::Encounter Create(domain::Encounter encounter) override;
+    std::optional<domain::Encounter> GetById(const std::string& encounterId) const override;
+    std::vector<std::optional<domain::Encounter>> GetByIds(const std::vector<std::string>& encounterIds) const override;
+    std::vector<domain::Encounter> Query(const EncounterQueryFilters& filters,
+                                         const util::RequestContext& context) const override;
+    SharedEncounters QueryShared(const EncounterQueryFilters& filters,
+                                 const util::RequestContext& context) const override;
+    std::uint64_t WriteGeneration() const override;
+
+    [[nodiscard]] QueryCoalescingStats stats() const;
+
+private:
+    struct Flight {
+        std::shared_future<SharedEncounters> result;
+    };
+
+    EncounterRepository& backing_;
+    mutable std::mutex mutex_;
+    // In-flight executions by normalized filters; entries are removed as soon as the leader finishes.
+    mutable std::unordered_map<std::string, Flight> inFlight_;
+
+    mutable std::atomic<std::uint64_t> executions_{0};
+    mutable std::atomic<std::uint64_t> coalesced_{0};
+};
+
+}  // namespace encounter_service::storage
@@ -0,0 +1,456 @@
+#include "src/storage/compact_audit_log.h"
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#include "src/util/varint.h"
+
+namespace encounter_service::storage {
+
+namespace {
+
+constexpr unsigned kActionShift = 28;
+// Set on rows whose encounter key indexes a bulk payload rather than a single encounter ID.
+constexpr std::uint32_t kBulkFlag = std::uint32_t{1} << (kActionShift - 1);
+constexpr std::uint32_t kActorMask = kBulkFlag - 1;
+
+std::int64_t ToTicks(std::chrono::system_clock::time_point value) {
+    return static_cast<std::int64_t>(value.time_since_epoch().count());
+}
+
+std::chrono::system_clock::time_point FromTicks(std::int64_t ticks) {
+    return std::chrono::system_clock::time_point{std::chrono::system_clock::duration{ticks}};
+}
+
+// Bulk payload slots are allocated in chunks of this many as a segment's bulk rows arrive.
+constexpr std::size_t kBulkPayloadChunk = 64;
+
+bool IsBulkRow(std::uint32_t actorAction) {
+    return (actorAction & kBulkFlag) != 0;
+}
+
+// Encodes sorted keys as a varint count followed by varint deltas from the previous key.
+std::vector<std::uint8_t> EncodeKeyList(std::vector<std::uint32_t> keys) {
+    std::sort(keys.begin(), keys.end());
+    std::vector<std::uint8_t> out;
+    out.reserve(keys.size() + 2);
+    util::AppendVarint(out, keys.size());
+    std::uint32_t previous = 0;
+    for (const auto key : keys) {
+        util::AppendVarint(out, key - previous);
+        previous = key;
+    }
+    out.shrink_to_fit();
+    return out;
+}
+
+// Returns the number of encounter keys in an encoded key list.
+std::size_t BulkKeyCount(const std::vector<std::uint8_t>& payload) {
+    std::size_t pos = 0;
+    const auto count = util::ReadVarint(payload.data(), payload.size(), pos);
+    if (!count) {
+        throw std::runtime_error("corrupt bulk audit payload");
+    }
+    return static_cast<std::size_t>(*count);
+}
+
+// Replaces the bulk records in `records[first..]`, which all come from one segment, with one record
+// per referenced encounter key. `payloadFor` maps a bulk row's encounter key to its key list.
+template <typename PayloadFor>
+void ExpandBulkRecords(std::vector<PackedAuditRecord>& records, std::size_t first, PayloadFor payloadFor) {
+    const auto firstBulk = std::partition(records.begin() + static_cast<std::ptrdiff_t>(first),
+                                          records.end(),
+                                          [](const PackedAuditRecord& record) {
+                                              return !IsBulkRow(record.actorAction);
+                                          });
+    if (firstBulk == records.end()) {
+        return;
+    }
+
+    std::vector<PackedAuditRecord> bulk(firstBulk, records.end());
+    records.erase(firstBulk, records.end());
+    for (const auto& record : bulk) {
+        const std::vector<std::uint8_t>& payload = payloadFor(record.encounterKey);
+        std::size_t pos = 0;
+        const auto count = util::ReadVarint(payload.data(), payload.size(), pos);
+        if (!count) {
+            throw std::runtime_error("corrupt bulk audit payload");
+        }
+        std::uint64_t key = 0;
+        for (std::uint64_t i = 0; i < *count; ++i) {
+            const auto delta = util::ReadVarint(payload.data(), payload.size(), pos);
+            if (!delta) {
+                throw std::runtime_error("corrupt bulk audit payload");
+            }
+            key += *delta;
+            records.push_back(PackedAuditRecord{
+                .ticks = record.ticks,
+                .actorAction = record.actorAction & ~kBulkFlag,
+                .encounterKey = static_cast<std::uint32_t>(key)
+            });
+        }
+    }
+}
+
+std::uint32_t PackActorAction(StringInterner::Id actor, domain::AuditAction action) {
+    if (actor > kActorMask) {
+        throw std::length_error("audit actor dictionary is full");
+    }
+    return (static_cast<std::uint32_t>(action) << kActionShift) | actor;
+}
+
+}  // namespace
+
+CompactAuditLog::HotSegment::HotSegment(std::size_t capacity)
+    : ticks(std::make_unique<std::int64_t[]>(capacity)),
+      actorActions(std::make_unique<std::uint32_t[]>(capacity)),
+      encounterKeys(std::make_unique<std::uint32_t[]>(capacity)),
+      published(std::make_unique<std::atomic<bool>[]>(capacity)),
+      bulkPayloads(kBulkPayloadChunk, (capacity + kBulkPayloadChunk - 1) / kBulkPayloadChunk) {}
+
+void CompactAuditLog::HotSegment::CollectRange(std::size_t rows,
+                                               std::int64_t fromTicks,
+                                               std::int64_t toTicks,
+                                               std::vector<PackedAuditRecord>& out) const {
+    if (sealed.load(std::memory_order_acquire) && (maxTicks < fromTicks || minTicks > toTicks)) {
+        return;
+    }
+    for (std::size_t row = 0; row < rows; ++row) {
+        if (ticks[row] < fromTicks || ticks[row] > toTicks) {
+            continue;
+        }
+        out.push_back(PackedAuditRecord{
+            .ticks = ticks[row],
+            .actorAction = actorActions[row],
+            .encounterKey = encounterKeys[row]
+        });
+    }
+}
+
+CompactAuditLog::CompactAuditLog()
+    : CompactAuditLog(CompactAuditLogOptions{}) {}
+
+CompactAuditLog::CompactAuditLog(CompactAuditLogOptions options)
+    : options_(options) {
+    options_.segmentCapacity = std::max<std::size_t>(options_.segmentCapacity, 1);
+    options_.maxSegments = std::max<std::size_t>(options_.maxSegments, 1);
+    directory_ = std::make_unique<DirectorySlot[]>(options_.maxSegments);
+    for (std::size_t i = 0; i < options_.maxSegments; ++i) {
+        directory_[i].index.store(i, std::memory_order_relaxed);
+    }
+}
+
+CompactAuditLog::~CompactAuditLog() {
+    for (std::size_t i = 0; i < options_.maxSegments; ++i) {
+        delete directory_[i].segment.load(std::memory_order_relaxed);
+    }
+}
+
+CompactAuditLog::DirectorySlot& CompactAuditLog::SlotFor(std::size_t segmentIndex) const {
+    return directory_[segmentIndex % options_.maxSegments];
+}
+
+CompactAuditLog::HotSegment* CompactAuditLog::HotSegmentAt(std::size_t segmentIndex) const {
+    const auto& slot = SlotFor(segmentIndex);
+    if (slot.index.load(std::memory_order_acquire) != segmentIndex) {
+        return nullptr;
+    }
+    return slot.segment.load(std::memory_order_acquire);
+}
+
+std::size_t CompactAuditLog::ReservePosition() {
+    auto position = tail_.load(std::memory_order_relaxed);
+    while (true) {
+        const auto index = position / options_.segmentCapacity;
+        // Checked before reserving, so a full directory never leaves a hole in the published prefix.
+        if (SlotFor(index).index.load(std::memory_order_acquire) != index) {
+            throw std::length_error("audit log segment directory is full");
+        }
+        if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+            return position;
+        }
+    }
+}
+
+CompactAuditLog::HotSegment* CompactAuditLog::SegmentFor(std::size_t position) {
+    auto& slot = SlotFor(position / options_.segmentCapacity);
+    auto* segment = slot.segment.load(std::memory_order_acquire);
+    if (segment == nullptr) {
+        auto fresh = std::make_unique<HotSegment>(options_.segmentCapacity);
+        if (slot.segment.compare_exchange_strong(segment, fresh.get(), std::memory_order_acq_rel)) {
+            segment = fresh.release();
+        }
+    }
+    return segment;
+}
+
+void CompactAuditLog::Append(const domain::AuditEntry& entry) {
+    if (entry.action == domain::AuditAction::LIST_ENCOUNTERS) {
+        throw std::invalid_argument("LIST_ENCOUNTERS entries must be appended with AppendBulk");
+    }
+    AppendRow(ToTicks(entry.timestamp),
+              PackActorAction(actors_.Intern(entry.actor), entry.action),
+              encounterIds_.Intern(entry.encounterId));
+}
+
+void CompactAuditLog::AppendBulk(const domain::BulkAuditEntry& entry) {
+    if (entry.action == domain::AuditAction::CREATE_ENCOUNTER) {
+        throw std::invalid_argument("CREATE_ENCOUNTER entries must be appended individually");
+    }
+    std::vector<std::uint32_t> keys;
+    keys.reserve(entry.encounterIds.size());
+    for (const auto& encounterId : entry.encounterIds) {
+        keys.push_back(encounterIds_.Intern(encounterId));
+    }
+
+    AppendRow(ToTicks(entry.timestamp),
+              PackActorAction(actors_.Intern(entry.actor), entry.action) | kBulkFlag,
+              0,
+              EncodeKeyList(std::move(keys)));
+}
+
+void CompactAuditLog::AppendRow(std::int64_t ticks,
+                                std::uint32_t actorAction,
+                                std::uint32_t encounterKey,
+                                std::vector<std::uint8_t> bulkPayload) {
+    const auto position = ReservePosition();
+    auto* segment = SegmentFor(position);
+    const auto row = position % options_.segmentCapacity;
+    if (IsBulkRow(actorAction)) {
+        // Written before the row is published, so readers that see the row see the payload too.
+        encounterKey = segment->nextBulkPayload.fetch_add(1, std::memory_order_relaxed);
+        segment->bulkPayloads.Slot(encounterKey) = std::move(bulkPayload);
+    }
+    segment->ticks[row] = ticks;
+    segment->actorActions[row] = actorAction;
+    segment->encounterKeys[row] = encounterKey;
+    segment->published[row].store(true, std::memory_order_release);
+
+    if (segment->publishedCount.fetch_add(1, std::memory_order_acq_rel) + 1 == options_.segmentCapacity) {
+        Seal(*segment);
+    }
+}
+
+void CompactAuditLog::Seal(HotSegment& segment) const {
+    // Every slot is published and no appender writes here again, so plain reads are safe.
+    auto minTicks = segment.ticks[0];
+    auto maxTicks = segment.ticks[0];
+    for (std::size_t row = 1; row < options_.segmentCapacity; ++row) {
+        minTicks = std::min(minTicks, segment.ticks[row]);
+        maxTicks = std::max(maxTicks, segment.ticks[row]);
+    }
+    segment.minTicks = minTicks;
+    segment.maxTicks = maxTicks;
+    segment.sealed.store(true, std::memory_order_release);
+}
+
+std::size_t CompactAuditLog::PublishedPrefix() const {
+    const auto start = publishedHint_.load(std::memory_order_acquire);
+    const auto capacity = options_.segmentCapacity;
+    const auto reserved = tail_.load(std::memory_order_acquire);
+
+    auto prefix = start;
+    while (prefix < reserved) {
+        const auto* segment = HotSegmentAt(prefix / capacity);
+        if (segment == nullptr) {
+            break;
+        }
+        if (segment->sealed.load(std::memory_order_acquire)) {
+            prefix = ((prefix / capacity) + 1) * capacity;
+            continue;
+        }
+        if (!segment->published[prefix % capacity].load(std::memory_order_acquire)) {
+            break;
+        }
+        ++prefix;
+    }
+    prefix = std::min(prefix, reserved);
+
+    auto hint = start;
+    while (hint < prefix && !publishedHint_.compare_exchange_weak(hint, prefix, std::memory_order_acq_rel)) {
+    }
+    return prefix;
+}
+
+std::vector<domain::AuditEntry> CompactAuditLog::Query(const AuditDateRange& range) const {
+    const auto from = range.from ? ToTicks(*range.from) : std::numeric_limits<std::int64_t>::min();
+    const auto to = range.to ? ToTicks(*range.to) : std::numeric_limits<std::int64_t>::max();
+    if (from > to) {
+        return {};
+    }
+
+    std::vector<PackedAuditRecord> records;
+    {
+        std::shared_lock lock(archiveMutex_);
+        for (const auto& segment : archived_) {
+            if (segment.maxTicks() >= from && segment.minTicks() <= to) {
+                const auto first = records.size();
+                segment.DecodeRange(from, to, records);
+                ExpandBulkRecords(records, first, [&segment](std::uint32_t key) -> const std::vector<std::uint8_t>& {
+                    return segment.bulkPayload(key);
+                });
+            }
+        }
+
+        const auto prefix = PublishedPrefix();
+        const auto capacity = options_.segmentCapacity;
+        for (auto index = firstHotSegment_; index * capacity < prefix; ++index) {
+            const auto* segment = HotSegmentAt(index);
+            if (segment == nullptr) {
+                continue;
+            }
+            const auto first = records.size();
+            segment->CollectRange(std::min(capacity, prefix - (index * capacity)), from, to, records);
+            ExpandBulkRecords(records, first, [segment](std::uint32_t key) -> const std::vector<std::uint8_t>& {
+                return segment->bulkPayloads[key];
+            });
+        }
+    }
+
+    // Order on the packed fields and compare interned strings only for timestamp ties.
+    std::sort(records.begin(), records.end(), [this](const PackedAuditRecord& a, const PackedAuditRecord& b) {
+        if (a.ticks != b.ticks) {
+            return a.ticks < b.ticks;
+        }
+        if (a.encounterKey != b.encounterKey) {
+            const auto& lhs = encounterIds_.Resolve(a.encounterKey);
+            const auto& rhs = encounterIds_.Resolve(b.encounterKey);
+            if (lhs != rhs) {
+                return lhs < rhs;
+            }
+        }
+        return actors_.Resolve(a.actorAction & kActorMask) < actors_.Resolve(b.actorAction & kActorMask);
+    });
+
+    std::vector<domain::AuditEntry> out;
+    out.reserve(records.size());
+    for (const auto& record : records) {
+        out.push_back(Rehydrate(record));
+    }
+    return out;
+}
+
+std::size_t CompactAuditLog::VisitPublished(std::size_t from,
+                                            const std::function<void(const AuditRecordView&)>& visit) const {
+    std::shared_lock lock(archiveMutex_);
+    const auto prefix = PublishedPrefix();
+    const auto capacity = options_.segmentCapacity;
+    for (auto position = from; position < prefix; ++position) {
+        const auto* segment = HotSegmentAt(position / capacity);
+        if (segment == nullptr) {
+            throw std::logic_error("audit positions were archived before being visited");
+        }
+        const auto row = position % capacity;
+        const auto actorAction = segment->actorActions[row];
+        const bool bulk = IsBulkRow(actorAction);
+        static const std::string kNoEncounterId;
+        visit(AuditRecordView{
+            .timestamp = FromTicks(segment->ticks[row]),
+            .actor = actors_.Resolve(actorAction & kActorMask),
+            .action = static_cast<domain::AuditAction>(actorAction >> kActionShift),
+            .encounterId = bulk ? kNoEncounterId : encounterIds_.Resolve(segment->encounterKeys[row]),
+            .encounterCount = bulk ? BulkKeyCount(segment->bulkPayloads[segment->encounterKeys[row]]) : 1
+        });
+    }
+    return std::max(from, prefix);
+}
+
+std::size_t CompactAuditLog::ArchiveSegmentsOlderThan(std::chrono::system_clock::time_point cutoff,
+                                                      std::vector<std::vector<domain::AuditEntry>>* archivedEntries,
+                                                      std::size_t through) {
+    const auto cutoffTicks = ToTicks(cutoff);
+    const auto capacity = options_.segmentCapacity;
+
+    std::unique_lock lock(archiveMutex_);
+    const auto prefix = PublishedPrefix();
+    const auto limit = std::min(prefix, through);
+    std::size_t archivedCount = 0;
+
+    // Only segments wholly inside the published prefix are archived, so the prefix never regresses.
+    for (auto index = firstHotSegment_; (index + 1) * capacity <= limit; ++index) {
+        auto* segment = HotSegmentAt(index);
+        if (segment == nullptr || !segment->sealed.load(std::memory_order_acquire) ||
+            segment->maxTicks >= cutoffTicks) {
+            continue;
+        }
+
+        std::vector<PackedAuditRecord> records;
+        records.reserve(capacity);
+        segment->CollectRange(capacity,
+                              std::numeric_limits<std::int64_t>::min(),
+                              std::numeric_limits<std::int64_t>::max(),
+                              records);
+        const auto hotPayload = [segment](std::uint32_t key) -> const std::vector<std::uint8_t>& {
+            return segment->bulkPayloads[key];
+        };
+        if (archivedEntries != nullptr) {
+            auto expanded = records;
+            ExpandBulkRecords(expanded, 0, hotPayload);
+            auto& entries = archivedEntries->emplace_back();
+            entries.reserve(expanded.size());
+            for (const auto& record : expanded) {
+                entries.push_back(Rehydrate(record));
+            }
+        }
+        // Bulk payloads move into the archive, renumbered in row order, and leave with the segment.
+        std::vector<std::vector<std::uint8_t>> payloads;
+        for (auto& record : records) {
+            if (IsBulkRow(record.actorAction)) {
+                auto& payload = segment->bulkPayloads.Slot(record.encounterKey);
+                record.encounterKey = static_cast<std::uint32_t>(payloads.size());
+                payloads.push_back(std::move(payload));
+            }
+        }
+        archived_.push_back(
+            ArchivedAuditSegment::Encode(std::move(records), options_.archiveBlockRows, std::move(payloads)));
+        archivedEntries_ += capacity;
+        // The slot is emptied before it is handed on, so the next segment's appender installs afresh.
+        auto& slot = SlotFor(index);
+        slot.segment.store(nullptr, std::memory_order_release);
+        slot.index.store(index + options_.maxSegments, std::memory_order_release);
+        delete segment;
+        ++archivedCount;
+    }
+
+    while (firstHotSegment_ * capacity < prefix &&
+           HotSegmentAt(firstHotSegment_) == nullptr) {
+        ++firstHotSegment_;
+    }
+    return archivedCount;
+}
+
+std::size_t CompactAuditLog::ArchiveColdSegments(std::chrono::system_clock::time_point now,
+                                                 std::vector<std::vector<domain::AuditEntry>>* archivedEntries,
+                                                 std::size_t through) {
+    return ArchiveSegmentsOlderThan(now - options_.archiveAfter, archivedEntries, through);
+}
+
+std::size_t CompactAuditLog::size() const {
+    return PublishedPrefix();
+}
+
+CompactAuditLogStats CompactAuditLog::stats() const {
+    std::shared_lock lock(archiveMutex_);
+    CompactAuditLogStats stats{};
+    stats.archivedEntries = archivedEntries_;
+    stats.hotEntries = PublishedPrefix() - archivedEntries_;
+    stats.archivedSegments = archived_.size();
+    for (const auto& segment : archived_) {
+        stats.archivedBytes += segment.encodedBytes();
+    }
+    return stats;
+}
+
+domain::AuditEntry CompactAuditLog::Rehydrate(const PackedAuditRecord& record) const {
+    return domain::AuditEntry{
+        .timestamp = FromTicks(record.ticks),
+        .actor = actors_.Resolve(record.actorAction & kActorMask),
+        .action = static_cast<domain::AuditAction>(record.actorAction >> kActionShift),
+        .encounterId = encounterIds_.Resolve(record.encounterKey)
+    };
+}
+
+}  // namespace encounter_service::storage
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include "src/domain/audit_models.h"
+#include "src/storage/audit_archive.h"
+#include "src/storage/audit_repo.h"
+#include "src/storage/string_interner.h"
+#include "src/util/segmented_array.h"
+
+namespace encounter_service::storage {
+
+struct CompactAuditLogOptions {
+    // Entries per segment; a fully published segment is sealed and becomes eligible for archival.
+    std::size_t segmentCapacity{4096};
+    // Slots in the segment directory, which is sized up front. Segment `i` lives in slot
+    // `i % maxSegments` and its slot is reused once it is archived, so this bounds unarchived
+    // segments rather than total appends; appends throw std::length_error while the segment they
+    // need still finds its slot held by an unarchived one.
+    std::size_t maxSegments{std::size_t{1} << 18};
+    // ArchiveColdSegments() archives sealed segments whose newest entry is older than this.
+    std::chrono::system_clock::duration archiveAfter{std::chrono::hours{24 * 14}};
+    // Rows per archive block; smaller blocks decode less for narrow range queries.
+    std::size_t archiveBlockRows{256};
+};
+
+struct CompactAuditLogStats {
+    std::size_t hotEntries{0};
+    std::size_t archivedEntries{0};
+    std::size_t archivedSegments{0};
+    std::size_t archivedBytes{0};
+};
+
+// Borrowed view of one stored record; references stay valid for the lifetime of the log.
+// Bulk records are visited once with an empty `encounterId`.
+struct AuditRecordView {
+    std::chrono::system_clock::time_point timestamp{};
+    const std::string& actor;
+    domain::AuditAction action{domain::AuditAction::READ_ENCOUNTER};
+    const std::string& encounterId;
+    // Encounters the record covers: the key count of a bulk record, otherwise 1.
+    std::size_t encounterCount{1};
+};
+
+// Column-oriented audit trail that stores each entry in 16 bytes:
+// - timestamp as int64 `system_clock` ticks
+// - interned actor ID packed with the audit action
+// - interned encounter key
+// Entries live in fixed-size segments of struct-of-arrays columns. Append reserves a slot with one
+// atomic increment and publishes it with a per-slot flag, so slot writes never wait on other
+// appenders or on readers. Interning is not lock-free: it takes a shared lock on one
+// StringInterner shard, and an exclusive one for a string seen for the first time (every create,
+// whose encounter ID is new). Queries read the contiguous published prefix. Sealed segments older than the archive
+// threshold are re-encoded as ArchivedAuditSegment blocks; only archival excludes readers.
+// Strings are rehydrated into `domain::AuditEntry` only when a query returns results.
+// Bulk records occupy one row whose encounter key points at a delta/varint-encoded list of
+// encounter keys, stored with the row's segment and moved into its archive, so payloads are freed
+// with the hot segment; queries expand them to one entry per encounter.
+class CompactAuditLog {
+public:
+    CompactAuditLog();
+    explicit CompactAuditLog(CompactAuditLogOptions options);
+    ~CompactAuditLog();
+
+    CompactAuditLog(const CompactAuditLog&) = delete;
+    CompactAuditLog& operator=(const CompactAuditLog&) = delete;
+
+    // Appends `entry`, interning its actor and encounter ID. Safe to call from any thread.
+    void Append(const domain::AuditEntry& entry);
+    // Appends one row referencing every ID in `entry.encounterIds`. Safe to call from any thread.
+    // Throws std::invalid_argument for CREATE_ENCOUNTER, which is always recorded per entry.
+    void AppendBulk(const domain::BulkAuditEntry& entry);
+    // Returns published entries inside `range`, ordered by timestamp, then encounterId, then actor.
+    [[nodiscard]] std::vector<domain::AuditEntry> Query(const AuditDateRange& range) const;
+    // Visits published entries from position `from` up to the published prefix, in append order,
+    // and returns the new position. Positions already archived must not be revisited.
+    std::size_t VisitPublished(std::size_t from, const std::function<void(const AuditRecordView&)>& visit) const;
+    // Archives sealed, published segments whose newest entry is older than `cutoff` and that end at
+    // or before position `through`; returns how many were archived. A VisitPublished() caller passes
+    // the position it has visited through, so nothing it has not seen is archived. When
+    // `archivedEntries` is set, each archived segment's entries (bulk records expanded) are appended
+    // to it as one vector.
+    std::size_t ArchiveSegmentsOlderThan(std::chrono::system_clock::time_point cutoff,
+                                         std::vector<std::vector<domain::AuditEntry>>* archivedEntries = nullptr,
+                                         std::size_t through = std::numeric_limits<std::size_t>::max());
+    // Archives sealed segments older than `now - options.archiveAfter`, as ArchiveSegmentsOlderThan().
+    std::size_t ArchiveColdSegments(std::chrono::system_clock::time_point now,
+                                    std::vector<std::vector<domain::AuditEntry>>* archivedEntries = nullptr,
+                                    std::size_t through = std::numeric_limits<std::size_t>::max());
+    // Returns the number of published entries.
+    [[nodiscard]] std::size_t size() const;
+    [[nodiscard]] CompactAuditLogStats stats() const;
+    // Returns the fixed per-entry column footprint in bytes (excluding interned dictionaries).
+    [[nodiscard]] static constexpr std::size_t BytesPerEntry() {
+        return sizeof(std::int64_t) + sizeof(std::uint32_t) + sizeof(std::uint32_t);
+    }
+
+private:
+    struct HotSegment {
+        explicit HotSegment(std::size_t capacity);
+
+        void CollectRange(std::size_t rows,
+                          std::int64_t fromTicks,
+                          std::int64_t toTicks,
+                          std::vector<PackedAuditRecord>& out) const;
+
+        std::unique_ptr<std::int64_t[]> ticks;
+        // Low bits hold the interned actor ID, then a bulk-row flag; the top bits hold the AuditAction.
+        std::unique_ptr<std::uint32_t[]> actorActions;
+        std::unique_ptr<std::uint32_t[]> encounterKeys;
+        std::unique_ptr<std::atomic<bool>[]> published;
+        // Encoded key lists for this segment's bulk rows, indexed by the row's encounter key.
+        util::SegmentedArray<std::vector<std::uint8_t>> bulkPayloads;
+        std::atomic<std::uint32_t> nextBulkPayload{0};
+        std::atomic<std::size_t> publishedCount{0};
+        // Set by the appender that publishes the last slot, after it fills minTicks/maxTicks.
+        std::atomic<bool> sealed{false};
+        std::int64_t minTicks{0};
+        std::int64_t maxTicks{0};
+    };
+
+    struct DirectorySlot {
+        std::atomic<HotSegment*> segment{nullptr};
+        // Index of the segment this slot holds or is waiting for; archival advances it by
+        // `maxSegments`, which hands the slot to the next segment that maps to it.
+        std::atomic<std::size_t> index{0};
+    };
+
+    // Bulk rows (`kBulkFlag` set) store `bulkPayload` in their segment and ignore `encounterKey`.
+    void AppendRow(std::int64_t ticks,
+                   std::uint32_t actorAction,
+                   std::uint32_t encounterKey,
+                   std::vector<std::uint8_t> bulkPayload = {});
+    // Reserves the next log position, or throws std::length_error while its directory slot is still
+    // held by an unarchived segment; nothing is reserved in that case.
+    [[nodiscard]] std::size_t ReservePosition();
+    [[nodiscard]] DirectorySlot& SlotFor(std::size_t segmentIndex) const;
+    // Returns hot segment `segmentIndex`, or nullptr when it is archived or not yet allocated.
+    [[nodiscard]] HotSegment* HotSegmentAt(std::size_t segmentIndex) const;
+    [[nodiscard]] HotSegment* SegmentFor(std::size_t position);
+    void Seal(HotSegment& segment) const;
+    // Returns the length of the longest fully published prefix and caches it as a hint.
+    [[nodiscard]] std::size_t PublishedPrefix() const;
+    [[nodiscard]] domain::AuditEntry Rehydrate(const PackedAuditRecord& record) const;
+
+    CompactAuditLogOptions options_{};
+    std::unique_ptr<DirectorySlot[]> directory_;
+    std::atomic<std::size_t> tail_{0};
+    mutable std::atomic<std::size_t> publishedHint_{0};
+
+    // Held shared by readers and exclusively by archival, which frees hot segments.
+    mutable std::shared_mutex archiveMutex_;
+    std::vector<ArchivedAuditSegment> archived_;
+    std::size_t archivedEntries_{0};
+    // Segments below this index are archived (or never allocated).
+    std::size_t firstHotSegment_{0};
+
+    StringInterner actors_;
+    StringInterner encounterIds_;
+};
+
+}  // namespace encounter_service::storage
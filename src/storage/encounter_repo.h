@@ -2,11 +2,14 @@
 
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
 
 #include "src/domain/encounter_models.h"
+#include "src/util/request_context.h"
 
 namespace encounter_service::storage {
 
@@ -24,16 +27,34 @@ struct EncounterQueryFilters {
     std::size_t offset{0};
 };
 
+// Immutable Query() result that caching layers hand out without copying the rows.
+using SharedEncounters = std::shared_ptr<const std::vector<domain::Encounter>>;
+
 class EncounterRepository {
 public:
     virtual ~EncounterRepository() = default;
 
-    // Stores `encounter` and returns the persisted value.
-    virtual domain::Encounter Create(const domain::Encounter& encounter) = 0;
+    // Stores `encounter` and returns the persisted value. Move the encounter in to avoid copying
+    // its payload; implementations should copy it at most once (for the returned value).
+    virtual domain::Encounter Create(domain::Encounter encounter) = 0;
     // Returns the encounter for `encounterId`, or std::nullopt when not found.
     virtual std::optional<domain::Encounter> GetById(const std::string& encounterId) const = 0;
-    // Returns encounters that match `filters`.
-    virtual std::vector<domain::Encounter> Query(const EncounterQueryFilters& filters) const = 0;
+    // Returns one slot per requested ID in request order; unknown IDs yield std::nullopt.
+    virtual std::vector<std::optional<domain::Encounter>> GetByIds(const std::vector<std::string>& encounterIds) const = 0;
+    // Returns encounters that match `filters`. Long scans check `context` cooperatively and throw
+    // util::RequestCancelled once its deadline passes or it is cancelled.
+    virtual std::vector<domain::Encounter> Query(const EncounterQueryFilters& filters,
+                                                 const util::RequestContext& context) const = 0;
+    // Same as Query(), but returns the rows behind a shared pointer. Repositories that keep result
+    // sets (QueryCachingEncounterRepository) override it to serve them without a copy; the default
+    // wraps Query().
+    [[nodiscard]] virtual SharedEncounters QueryShared(const EncounterQueryFilters& filters,
+                                                       const util::RequestContext& context) const {
+        return std::make_shared<const std::vector<domain::Encounter>>(Query(filters, context));
+    }
+    // Returns a counter that advances after every write becomes visible to Query(). Results of a
+    // Query() started after reading generation `g` reflect at least every write counted in `g`.
+    [[nodiscard]] virtual std::uint64_t WriteGeneration() const = 0;
 };
 
 }  // namespace encounter_service::storage
@@ -1,38 +1,56 @@
 #include "src/storage/in_memory_audit_repo.h"
 
-#include <algorithm>
-
 namespace encounter_service::storage {
 
+InMemoryAuditRepository::InMemoryAuditRepository(CompactAuditLogOptions options)
+    : log_(options) {}
+
 void InMemoryAuditRepository::Append(const domain::AuditEntry& entry) {
-    entries_.push_back(entry);
+    log_.Append(entry);
+}
+
+void InMemoryAuditRepository::AppendBulk(const domain::BulkAuditEntry& entry) {
+    log_.AppendBulk(entry);
 }
 
 std::vector<domain::AuditEntry> InMemoryAuditRepository::Query(const AuditDateRange& range) const {
-    std::vector<domain::AuditEntry> out;
-    out.reserve(entries_.size());
-
-    for (const auto& entry : entries_) {
-        if (range.from && entry.timestamp < *range.from) {
-            continue;
-        }
-        if (range.to && entry.timestamp > *range.to) {
-            continue;
-        }
-        out.push_back(entry);
-    }
-
-    std::sort(out.begin(), out.end(), [](const domain::AuditEntry& a, const domain::AuditEntry& b) {
-        if (a.timestamp != b.timestamp) {
-            return a.timestamp < b.timestamp;
-        }
-        if (a.encounterId != b.encounterId) {
-            return a.encounterId < b.encounterId;
-        }
-        return a.actor < b.actor;
-    });
+    return log_.Query(range);
+}
+
+std::vector<domain::AuditRollup> InMemoryAuditRepository::QueryRollups(const AuditDateRange& range) const {
+    std::lock_guard lock(maintenanceMutex_);
+    FoldRollupsLocked();
+    return rollups_.Query(range);
+}
 
-    return out;
+std::size_t InMemoryAuditRepository::ArchiveSegmentsOlderThan(
+    std::chrono::system_clock::time_point cutoff,
+    std::vector<std::vector<domain::AuditEntry>>* archivedEntries) {
+    std::lock_guard lock(maintenanceMutex_);
+    // Entries must be counted before their hot segment is archived. Appends keep publishing after
+    // the fold, so archival stops at the position the fold reached rather than the live prefix.
+    FoldRollupsLocked();
+    return log_.ArchiveSegmentsOlderThan(cutoff, archivedEntries, rolledUpThrough_);
+}
+
+std::size_t InMemoryAuditRepository::ArchiveColdSegments(std::chrono::system_clock::time_point now,
+                                                         std::vector<std::vector<domain::AuditEntry>>* archivedEntries) {
+    std::lock_guard lock(maintenanceMutex_);
+    FoldRollupsLocked();
+    return log_.ArchiveColdSegments(now, archivedEntries, rolledUpThrough_);
+}
+
+CompactAuditLogStats InMemoryAuditRepository::stats() const {
+    return log_.stats();
+}
+
+void InMemoryAuditRepository::FoldRollupsLocked() const {
+    // A bulk READ row stands for one read per encounter, as a batch of single GETs would record;
+    // a LIST row is one list access however many encounters it returned.
+    rolledUpThrough_ = log_.VisitPublished(rolledUpThrough_, [this](const AuditRecordView& record) {
+        const auto count = record.action == domain::AuditAction::READ_ENCOUNTER ? record.encounterCount : 1;
+        rollups_.Add(record.timestamp, record.actor, record.action, count);
+    });
 }
 
 }  // namespace encounter_service::storage
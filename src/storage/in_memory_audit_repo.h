@@ -1,19 +1,48 @@
 #pragma once
 
+#include <chrono>
+#include <cstddef>
+#include <mutex>
 #include <vector>
 
 #include "src/storage/audit_repo.h"
+#include "src/storage/audit_rollups.h"
+#include "src/storage/compact_audit_log.h"
 
 namespace encounter_service::storage {
 
+// Thread-safe: Append never waits for queries or maintenance (only for the interner shard locks
+// described on CompactAuditLog), queries read a consistent published prefix of the log, and
+// rollup/archive maintenance serializes only with itself.
 class InMemoryAuditRepository final : public AuditRepository {
 public:
+    InMemoryAuditRepository() = default;
+    // Creates a repository whose segment size and archive threshold follow `options`.
+    explicit InMemoryAuditRepository(CompactAuditLogOptions options);
+
     void Append(const domain::AuditEntry& entry) override;
+    void AppendBulk(const domain::BulkAuditEntry& entry) override;
     std::vector<domain::AuditEntry> Query(const AuditDateRange& range) const override;
+    std::vector<domain::AuditRollup> QueryRollups(const AuditDateRange& range) const override;
+
+    // Archives sealed audit segments whose newest entry is older than `cutoff`. When
+    // `archivedEntries` is set, each archived segment's entries are appended to it.
+    std::size_t ArchiveSegmentsOlderThan(std::chrono::system_clock::time_point cutoff,
+                                         std::vector<std::vector<domain::AuditEntry>>* archivedEntries = nullptr);
+    // Archives sealed audit segments older than the configured archive threshold relative to `now`.
+    std::size_t ArchiveColdSegments(std::chrono::system_clock::time_point now,
+                                    std::vector<std::vector<domain::AuditEntry>>* archivedEntries = nullptr);
+    [[nodiscard]] CompactAuditLogStats stats() const;
 
 private:
-    // Not thread-safe. Production should use synchronization or a database-backed repository.
-    std::vector<domain::AuditEntry> entries_;
+    // Folds entries published since the last fold into `rollups_`. Requires `maintenanceMutex_`.
+    void FoldRollupsLocked() const;
+
+    CompactAuditLog log_;
+    // Rollups are folded from the log on the read/maintenance side so Append takes no lock of its own.
+    mutable std::mutex maintenanceMutex_;
+    mutable AuditRollupTable rollups_;
+    mutable std::size_t rolledUpThrough_{0};
 };
 
 }  // namespace encounter_service::storage
@@ -1,6 +1,7 @@
 #include "src/storage/in_memory_encounter_repo.h"
 
 #include <algorithm>
+#include <utility>
 
 namespace encounter_service::storage {
 
@@ -27,9 +28,11 @@ bool Matches(const domain::Encounter& encounter, const EncounterQueryFilters& fi
 
 }  // namespace
 
-domain::Encounter InMemoryEncounterRepository::Create(const domain::Encounter& encounter) {
-    encounters_[encounter.encounterId] = encounter;
-    return encounter;
+domain::Encounter InMemoryEncounterRepository::Create(domain::Encounter encounter) {
+    auto key = encounter.encounterId;
+    const auto it = encounters_.insert_or_assign(std::move(key), std::move(encounter)).first;
+    generation_.fetch_add(1, std::memory_order_release);
+    return it->second;
 }
 
 std::optional<domain::Encounter> InMemoryEncounterRepository::GetById(const std::string& encounterId) const {
@@ -40,18 +43,37 @@ std::optional<domain::Encounter> InMemoryEncounterRepository::GetById(const std:
     return it->second;
 }
 
-std::vector<domain::Encounter> InMemoryEncounterRepository::Query(const EncounterQueryFilters& filters) const {
+std::vector<std::optional<domain::Encounter>> InMemoryEncounterRepository::GetByIds(
+    const std::vector<std::string>& encounterIds) const {
+    std::vector<std::optional<domain::Encounter>> found;
+    found.reserve(encounterIds.size());
+    for (const auto& encounterId : encounterIds) {
+        const auto it = encounters_.find(encounterId);
+        if (it == encounters_.end()) {
+            found.emplace_back(std::nullopt);
+        } else {
+            found.emplace_back(it->second);
+        }
+    }
+    return found;
+}
+
+std::vector<domain::Encounter> InMemoryEncounterRepository::Query(const EncounterQueryFilters& filters,
+                                                                  const util::RequestContext& context) const {
+    util::CancellationCheckpoint checkpoint(context);
     std::vector<domain::Encounter> matches;
     matches.reserve(encounters_.size());
     for (const auto& [unused_id, encounter] : encounters_) {
         (void)unused_id;
+        checkpoint.Tick();
         if (Matches(encounter, filters)) {
             matches.push_back(encounter);
         }
     }
 
     // Preserve deterministic ordering across runs regardless of unordered_map iteration order.
-    std::sort(matches.begin(), matches.end(), [](const domain::Encounter& a, const domain::Encounter& b) {
+    std::sort(matches.begin(), matches.end(), [&checkpoint](const domain::Encounter& a, const domain::Encounter& b) {
+        checkpoint.Tick();
         if (a.encounterDate != b.encounterDate) {
             return a.encounterDate < b.encounterDate;
         }
@@ -66,4 +88,8 @@ std::vector<domain::Encounter> InMemoryEncounterRepository::Query(const Encounte
         matches.begin() + static_cast<std::ptrdiff_t>(end_index));
 }
 
+std::uint64_t InMemoryEncounterRepository::WriteGeneration() const {
+    return generation_.load(std::memory_order_acquire);
+}
+
 }  // namespace encounter_service::storage
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <unordered_map>
 
 #include "src/storage/encounter_repo.h"
@@ -8,13 +10,17 @@ namespace encounter_service::storage {
 
 class InMemoryEncounterRepository final : public EncounterRepository {
 public:
-    domain::Encounter Create(const domain::Encounter& encounter) override;
+    domain::Encounter Create(domain::Encounter encounter) override;
     std::optional<domain::Encounter> GetById(const std::string& encounterId) const override;
-    std::vector<domain::Encounter> Query(const EncounterQueryFilters& filters) const override;
+    std::vector<std::optional<domain::Encounter>> GetByIds(const std::vector<std::string>& encounterIds) const override;
+    std::vector<domain::Encounter> Query(const EncounterQueryFilters& filters,
+                                         const util::RequestContext& context) const override;
+    std::uint64_t WriteGeneration() const override;
 
 private:
     // Not thread-safe. Production should use synchronization or a database-backed repository.
     std::unordered_map<std::string, domain::Encounter> encounters_;
+    std::atomic<std::uint64_t> generation_{0};
 };
 
 }  // namespace encounter_service::storage
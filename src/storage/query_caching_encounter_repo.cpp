@@ -0,0 +1,162 @@
+#include "src/storage/query_caching_encounter_repo.h"
+
+#include <chrono>
+#include <iterator>
+#include <limits>
+#include <utility>
+
+#include "src/storage/caching_encounter_repo.h"
+#include "src/storage/coalescing_encounter_repo.h"
+
+namespace encounter_service::storage {
+
+namespace {
+
+std::int64_t UtcDay(std::chrono::system_clock::time_point at) {
+    return std::chrono::floor<std::chrono::days>(at).time_since_epoch().count();
+}
+
+}  // namespace
+
+QueryCachingEncounterRepository::QueryCachingEncounterRepository(EncounterRepository& backing,
+                                                                 QueryCacheOptions options)
+    : backing_(backing),
+      maxBytes_(options.maxBytes) {}
+
+domain::Encounter QueryCachingEncounterRepository::Create(domain::Encounter encounter) {
+    const auto day = UtcDay(encounter.encounterDate);
+    auto persisted = backing_.Create(std::move(encounter));
+
+    // Entries are invalidated lazily: lookups compare their generation against the written days.
+    std::lock_guard lock(mutex_);
+    ++generation_;
+    dayGenerations_[day] = generation_;
+    return persisted;
+}
+
+std::optional<domain::Encounter> QueryCachingEncounterRepository::GetById(const std::string& encounterId) const {
+    return backing_.GetById(encounterId);
+}
+
+std::vector<std::optional<domain::Encounter>> QueryCachingEncounterRepository::GetByIds(
+    const std::vector<std::string>& encounterIds) const {
+    return backing_.GetByIds(encounterIds);
+}
+
+std::vector<domain::Encounter> QueryCachingEncounterRepository::Query(const EncounterQueryFilters& filters,
+                                                                      const util::RequestContext& context) const {
+    return *QueryShared(filters, context);
+}
+
+SharedEncounters QueryCachingEncounterRepository::QueryShared(const EncounterQueryFilters& filters,
+                                                              const util::RequestContext& context) const {
+    auto key = NormalizeQueryFilters(filters);
+
+    SharedEncounters cached;
+    std::uint64_t generation = 0;
+    {
+        std::lock_guard lock(mutex_);
+        cached = LookupLocked(key);
+        if (cached) {
+            ++counters_.hits;
+        } else {
+            ++counters_.misses;
+            // Captured before the backing query so a create racing with it leaves the entry stale.
+            generation = generation_;
+        }
+    }
+    // Result sets are immutable once cached, so hits share them with the caller.
+    if (cached) {
+        return cached;
+    }
+
+    auto rows = backing_.QueryShared(filters, context);
+
+    Entry entry{
+        .key = std::move(key),
+        .result = nullptr,
+        .fromDay = filters.encounterDateFrom ? UtcDay(*filters.encounterDateFrom)
+                                             : std::numeric_limits<std::int64_t>::min(),
+        .toDay = filters.encounterDateTo ? UtcDay(*filters.encounterDateTo) : std::numeric_limits<std::int64_t>::max(),
+        .generation = generation,
+        .bytes = sizeof(Entry),
+    };
+    entry.bytes += entry.key.size();
+    for (const auto& row : *rows) {
+        entry.bytes += EstimateEncounterBytes(row);
+    }
+    // Result sets larger than the whole budget would only flush everything else.
+    if (entry.bytes > maxBytes_) {
+        return rows;
+    }
+    entry.result = rows;
+
+    std::lock_guard lock(mutex_);
+    InsertLocked(std::move(entry));
+    return rows;
+}
+
+// Counts this decorator's own generations: a write is only visible here once cached results that
+// it affects have been invalidated, which happens after the backing repository's generation moves.
+std::uint64_t QueryCachingEncounterRepository::WriteGeneration() const {
+    std::lock_guard lock(mutex_);
+    return generation_;
+}
+
+QueryCacheStats QueryCachingEncounterRepository::stats() const {
+    std::lock_guard lock(mutex_);
+    auto stats = counters_;
+    stats.entries = index_.size();
+    stats.bytes = bytes_;
+    return stats;
+}
+
+SharedEncounters QueryCachingEncounterRepository::LookupLocked(
+    const std::string& key) const {
+    const auto found = index_.find(key);
+    if (found == index_.end()) {
+        return nullptr;
+    }
+    const auto it = found->second;
+
+    if (it->generation != generation_) {
+        // Only days inside the entry's range matter; a write to any of them since the entry was
+        // filled could add, remove, or shift rows on its page.
+        for (auto day = dayGenerations_.lower_bound(it->fromDay);
+             day != dayGenerations_.end() && day->first <= it->toDay;
+             ++day) {
+            if (day->second > it->generation) {
+                ++counters_.invalidations;
+                EraseLocked(it);
+                return nullptr;
+            }
+        }
+        // Still current: later lookups take the single-comparison path until the next write.
+        it->generation = generation_;
+    }
+
+    lru_.splice(lru_.begin(), lru_, it);
+    return it->result;
+}
+
+void QueryCachingEncounterRepository::InsertLocked(Entry entry) const {
+    if (const auto existing = index_.find(entry.key); existing != index_.end()) {
+        EraseLocked(existing->second);
+    }
+    while (bytes_ + entry.bytes > maxBytes_ && !lru_.empty()) {
+        EraseLocked(std::prev(lru_.end()));
+        ++counters_.evictions;
+    }
+
+    bytes_ += entry.bytes;
+    lru_.push_front(std::move(entry));
+    index_.emplace(lru_.front().key, lru_.begin());
+}
+
+void QueryCachingEncounterRepository::EraseLocked(std::list<Entry>::iterator it) const {
+    bytes_ -= it->bytes;
+    index_.erase(it->key);
+    lru_.erase(it);
+}
+
+}  // namespace encounter_service::storage
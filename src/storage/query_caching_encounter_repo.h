@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "src/storage/encounter_repo.h"
+
+namespace encounter_service::storage {
+
+struct QueryCacheOptions {
+    // Upper bound on the estimated size of all cached result sets.
+    std::size_t maxBytes{std::size_t{32} << 20};
+};
+
+struct QueryCacheStats {
+    std::uint64_t hits{0};
+    // Lookups with no entry plus lookups whose entry had been invalidated by a write.
+    std::uint64_t misses{0};
+    // Entries dropped because a create landed in a UTC day they cover.
+    std::uint64_t invalidations{0};
+    std::uint64_t evictions{0};
+    std::size_t entries{0};
+    std::size_t bytes{0};
+};
+
+// Caches Query() result sets keyed by normalized filters plus pagination, bounded by estimated bytes
+// with LRU eviction. Writes are tracked as generations per UTC day of `encounterDate`: an entry is
+// only invalidated by creates dated inside its own date range, so results for historical ranges
+// survive ongoing writes. An entry whose generation still matches the repository's is served with
+// a single hash lookup; otherwise it is revalidated against the days written since it was filled.
+// Create() must be routed through this decorator for invalidation to see it.
+class QueryCachingEncounterRepository final : public EncounterRepository {
+public:
+    // Borrows `backing`, which must outlive the decorator.
+    explicit QueryCachingEncounterRepository(EncounterRepository& backing, QueryCacheOptions options = {});
+
+    QueryCachingEncounterRepository(const QueryCachingEncounterRepository&) = delete;
+    QueryCachingEncounterRepository& operator=(const QueryCachingEncounterRepository&) = delete;
+
+    domain::Encounter Create(domain::Encounter encounter) override;
+    std::optional<domain::Encounter> GetById(const std::string& encounterId) const override;
+    std::vector<std::optional<domain::Encounter>> GetByIds(const std::vector<std::string>& encounterIds) const override;
+    std::vector<domain::Encounter> Query(const EncounterQueryFilters& filters,
+                                         const util::RequestContext& context) const override;
+    // Hits return the cached result set itself, so serving one copies no rows.
+    SharedEncounters QueryShared(const EncounterQueryFilters& filters,
+                                 const util::RequestContext& context) const override;
+    std::uint64_t WriteGeneration() const override;
+
+    [[nodiscard]] QueryCacheStats stats() const;
+
+private:
+    struct Entry {
+        std::string key;
+        SharedEncounters result;
+        // Inclusive UTC day range the query can match; unbounded sides use the int64 limits.
+        std::int64_t fromDay{0};
+        std::int64_t toDay{0};
+        // Repository generation the entry is known to be current for.
+        std::uint64_t generation{0};
+        std::size_t bytes{0};
+    };
+
+    // Returns the cached rows for `key` or nullptr. Requires `mutex_`.
+    SharedEncounters LookupLocked(const std::string& key) const;
+    void InsertLocked(Entry entry) const;
+    void EraseLocked(std::list<Entry>::iterator it) const;
+
+    EncounterRepository& backing_;
+    std::size_t maxBytes_{0};
+
+    mutable std::mutex mutex_;
+    // Most recently used at the front.
+    mutable std::list<Entry> lru_;
+    mutable std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+    mutable std::size_t bytes_{0};
+    // Incremented by every create.
+    mutable std::uint64_t generation_{0};
+    // Generation of the latest create per UTC day of `encounterDate`.
+    mutable std::map<std::int64_t, std::uint64_t> dayGenerations_;
+
+    mutable QueryCacheStats counters_{};
+};
+
+}  // namespace encounter_service::storage
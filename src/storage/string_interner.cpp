@@ -0,0 +1,61 @@
+#include "src/storage/string_interner.h"
+
+#include <functional>
+#include <mutex>
+
+namespace encounter_service::storage {
+
+namespace {
+
+constexpr std::size_t kValuesPerSegment = 4096;
+// 2^16 segments of 4096 strings allow ~268M distinct values per interner.
+constexpr std::size_t kMaxValueSegments = std::size_t{1} << 16;
+
+}  // namespace
+
+StringInterner::StringInterner()
+    : values_(kValuesPerSegment, kMaxValueSegments) {}
+
+StringInterner::Shard& StringInterner::ShardFor(std::string_view value) const {
+    return shards_[std::hash<std::string_view>{}(value) % kShardCount];
+}
+
+StringInterner::Id StringInterner::Intern(std::string_view value) {
+    auto& shard = ShardFor(value);
+    {
+        std::shared_lock lock(shard.mutex);
+        if (const auto it = shard.ids.find(value); it != shard.ids.end()) {
+            return it->second;
+        }
+    }
+
+    std::unique_lock lock(shard.mutex);
+    if (const auto it = shard.ids.find(value); it != shard.ids.end()) {
+        return it->second;
+    }
+    const auto id = next_.fetch_add(1, std::memory_order_relaxed);
+    auto& stored = values_.Slot(id);
+    stored.assign(value);
+    shard.ids.emplace(std::string_view(stored), id);
+    return id;
+}
+
+std::optional<StringInterner::Id> StringInterner::Find(std::string_view value) const {
+    auto& shard = ShardFor(value);
+    std::shared_lock lock(shard.mutex);
+    const auto it = shard.ids.find(value);
+    if (it == shard.ids.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+const std::string& StringInterner::Resolve(Id id) const {
+    return values_[id];
+}
+
+std::size_t StringInterner::size() const {
+    return next_.load(std::memory_order_relaxed);
+}
+
+}  // namespace encounter_service::storage
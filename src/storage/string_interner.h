@@ -0,0 +1,51 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "src/util/segmented_array.h"
+
+namespace encounter_service::storage {
+
+// Maps repeated strings (actors, encounter IDs) to dense numeric IDs so compact
+// storage layouts can keep fixed-width keys instead of per-row heap strings.
+// Thread-safe: lookups of known strings take a shared lock on one of several shards,
+// and Resolve() is lock-free.
+class StringInterner {
+public:
+    using Id = std::uint32_t;
+
+    StringInterner();
+
+    // Returns the ID for `value`, assigning the next dense ID on first use.
+    Id Intern(std::string_view value);
+    // Returns the ID for `value`, or std::nullopt when it was never interned.
+    [[nodiscard]] std::optional<Id> Find(std::string_view value) const;
+    // Returns the string for an ID previously returned by Intern().
+    [[nodiscard]] const std::string& Resolve(Id id) const;
+    // Returns the number of distinct interned strings.
+    [[nodiscard]] std::size_t size() const;
+
+private:
+    static constexpr std::size_t kShardCount = 16;
+
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        // Keys view into `values_`, whose element addresses never change.
+        std::unordered_map<std::string_view, Id> ids;
+    };
+
+    [[nodiscard]] Shard& ShardFor(std::string_view value) const;
+
+    mutable std::array<Shard, kShardCount> shards_;
+    util::SegmentedArray<std::string> values_;
+    std::atomic<Id> next_{0};
+};
+
+}  // namespace encounter_service::storage
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <coroutine>
+#include <functional>
+
+namespace encounter_service::util {
+
+// Runs posted work items. Implementations decide where and when (inline, a thread pool, an I/O
+// loop); the async service uses one to choose where its coroutines resume.
+class Executor {
+public:
+    virtual ~Executor() = default;
+    // Schedules `work` to run exactly once.
+    virtual void Post(std::function<void()> work) = 0;
+};
+
+// Runs work immediately on the posting thread.
+class InlineExecutor final : public Executor {
+public:
+    void Post(std::function<void()> work) override {
+        work();
+    }
+};
+
+// Awaitable that resumes the awaiting coroutine on `executor`.
+class ScheduleAwaiter {
+public:
+    explicit ScheduleAwaiter(Executor& executor)
+        : executor_(executor) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> awaiting) {
+        executor_.Post([awaiting]() { awaiting.resume(); });
+    }
+
+    void await_resume() const noexcept {}
+
+private:
+    Executor& executor_;
+};
+
+// `co_await Schedule(executor)` continues the current coroutine on `executor`.
+inline ScheduleAwaiter Schedule(Executor& executor) {
+    return ScheduleAwaiter(executor);
+}
+
+}  // namespace encounter_service::util
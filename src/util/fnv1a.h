@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace encounter_service::util {
+
+// Incremental 64-bit FNV-1a. Fast and stable across builds, which is what ETags and rate-limit keys
+// need; not collision resistant against an adversary.
+class Fnv1a64 {
+public:
+    static constexpr std::uint64_t kOffsetBasis = 0xcbf29ce484222325ULL;
+    static constexpr std::uint64_t kPrime = 0x100000001b3ULL;
+
+    void Update(const char* data, std::size_t size) {
+        for (std::size_t i = 0; i < size; ++i) {
+            hash_ ^= static_cast<unsigned char>(data[i]);
+            hash_ *= kPrime;
+        }
+    }
+
+    void Update(std::string_view value) { Update(value.data(), value.size()); }
+
+    // Hashes the eight bytes of `value`, least significant first, so digests do not depend on the
+    // host's byte order.
+    void Update(std::uint64_t value) {
+        for (int shift = 0; shift < 64; shift += 8) {
+            hash_ ^= (value >> shift) & 0xff;
+            hash_ *= kPrime;
+        }
+    }
+
+    [[nodiscard]] std::uint64_t digest() const { return hash_; }
+
+private:
+    std::uint64_t hash_{kOffsetBasis};
+};
+
+}  // namespace encounter_service::util
@@ -19,7 +19,8 @@ public:
         Null,
         Object,
         Array,
-        String
+        String,
+        Number
     };
 
     json() = default;
@@ -30,6 +31,12 @@ public:
     json(std::string value)
         : kind_(Kind::String), string_value_(std::move(value)) {}
 
+    // Integers are stored pre-formatted; the compat layer only needs to serialize them.
+    template <typename T,
+              typename std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>, int> = 0>
+    json(T value)
+        : kind_(Kind::Number), string_value_(std::to_string(value)) {}
+
     static json object() {
         json j;
         j.kind_ = Kind::Object;
@@ -118,6 +125,8 @@ public:
                 return "null";
             case Kind::String:
                 return "\"" + Escape(string_value_) + "\"";
+            case Kind::Number:
+                return string_value_;
             case Kind::Object:
                 return DumpObject();
             case Kind::Array:
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "src/util/json_compat.h"
+
+// The one place that reaches into nlohmann internals (`detail::serializer` and
+// `detail::output_adapter_protocol`), which carry no stability promise across releases. They match
+// the vendored json.hpp 3.11.3; the assert below fails the build on any other version so this file
+// is re-checked when the dependency is upgraded.
+#if __has_include("vendor/json.hpp")
+static_assert(NLOHMANN_JSON_VERSION_MAJOR == 3 && NLOHMANN_JSON_VERSION_MINOR == 11 &&
+                  NLOHMANN_JSON_VERSION_PATCH == 3,
+              "src/util/json_dump.h relies on nlohmann::detail; re-check it against this json.hpp");
+#endif
+
+namespace encounter_service::util {
+
+// Appends exactly what `value.dump()` returns to `out`, without the temporary string.
+inline void AppendJsonDump(std::string& out, const nlohmann::json& value) {
+#if __has_include("vendor/json.hpp")
+    nlohmann::detail::serializer<nlohmann::json> serializer(
+        nlohmann::detail::output_adapter<char, std::string>(out), ' ');
+    serializer.dump(value, false, false, 0);
+#else
+    out += value.dump();
+#endif
+}
+
+// Streams the bytes of `value.dump()` to `write(const char* data, std::size_t size)` as the
+// serializer produces them, so nothing is buffered.
+template <typename Write>
+void StreamJsonDump(const nlohmann::json& value, Write write) {
+#if __has_include("vendor/json.hpp")
+    class CallbackOutput final : public nlohmann::detail::output_adapter_protocol<char> {
+    public:
+        explicit CallbackOutput(Write& write)
+            : write_(write) {}
+
+        void write_character(char c) override { write_(&c, 1); }
+        void write_characters(const char* s, std::size_t length) override { write_(s, length); }
+
+    private:
+        Write& write_;
+    };
+
+    nlohmann::detail::serializer<nlohmann::json> serializer(std::make_shared<CallbackOutput>(write), ' ');
+    serializer.dump(value, false, false, 0);
+#else
+    const auto text = value.dump();
+    write(text.data(), text.size());
+#endif
+}
+
+}  // namespace encounter_service::util
@@ -0,0 +1,71 @@
+#include "src/util/json_writer.h"
+
+#include "src/util/json_compat.h"
+#include "src/util/time.h"
+
+namespace encounter_service::util {
+
+void AppendJsonEscaped(std::string& out, std::string_view value) {
+    static constexpr char kHex[] = "0123456789abcdef";
+    const auto start = out.size();
+    std::size_t run = 0;
+    for (std::size_t i = 0; i < value.size(); ++i) {
+        const auto ch = static_cast<unsigned char>(value[i]);
+        if (ch >= 0x80) {
+            // Non-ASCII text goes through nlohmann so UTF-8 validation and its errors stay identical.
+            out.resize(start);
+            const auto quoted = nlohmann::json(std::string(value)).dump();
+            out.append(quoted, 1, quoted.size() - 2);
+            return;
+        }
+        if (ch >= 0x20 && ch != '"' && ch != '\\') {
+            continue;
+        }
+        out.append(value.data() + run, i - run);
+        run = i + 1;
+        out += '\\';
+        switch (ch) {
+            case '"':
+            case '\\':
+                out += static_cast<char>(ch);
+                break;
+            case '\b':
+                out += 'b';
+                break;
+            case '\f':
+                out += 'f';
+                break;
+            case '\n':
+                out += 'n';
+                break;
+            case '\r':
+                out += 'r';
+                break;
+            case '\t':
+                out += 't';
+                break;
+            default:
+                out += "u00";
+                out += kHex[ch >> 4];
+                out += kHex[ch & 0x0f];
+                break;
+        }
+    }
+    out.append(value.data() + run, value.size() - run);
+}
+
+void AppendJsonString(std::string& out, std::string_view value) {
+    out += '"';
+    AppendJsonEscaped(out, value);
+    out += '"';
+}
+
+void AppendJsonTimestamp(std::string& out, std::chrono::system_clock::time_point value) {
+    const auto start = out.size();
+    out.resize(start + kIso8601UtcLength + 2);
+    out[start] = '"';
+    FormatIso8601UtcTo(value, out.data() + start + 1);
+    out.back() = '"';
+}
+
+}  // namespace encounter_service::util
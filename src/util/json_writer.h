@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace encounter_service::util {
+
+// Direct-to-buffer JSON building blocks. Each function appends to `out` and produces the same bytes
+// as the equivalent nlohmann::json value's dump(): no whitespace, same escaping.
+
+// Appends `value` JSON-escaped, without the surrounding quotes. Non-ASCII text is validated as
+// UTF-8 by nlohmann, so invalid input throws exactly as dump() would.
+void AppendJsonEscaped(std::string& out, std::string_view value);
+
+// Appends `value` as a quoted JSON string.
+void AppendJsonString(std::string& out, std::string_view value);
+
+// Text that has already been through AppendJsonEscaped(), such as a stored string table entry.
+struct EscapedJsonString {
+    std::string_view text;
+};
+
+// Appends `value.text` between quotes without escaping it again.
+inline void AppendJsonString(std::string& out, EscapedJsonString value) {
+    out += '"';
+    out += value.text;
+    out += '"';
+}
+
+// Appends `value` as a quoted `YYYY-MM-DDTHH:MM:SSZ` string.
+void AppendJsonTimestamp(std::string& out, std::chrono::system_clock::time_point value);
+
+// One object member: `key` is the pre-escaped `"name":` prefix, `append` writes the value.
+template <typename T>
+struct JsonField {
+    std::string_view key;
+    void (*append)(std::string& out, const T& value);
+};
+
+// nlohmann::json objects are ordered maps, so dump() emits keys in sorted order; tables must match.
+template <typename T, std::size_t N>
+constexpr bool JsonKeysSorted(const std::array<JsonField<T>, N>& fields) {
+    for (std::size_t i = 1; i < N; ++i) {
+        if (!(fields[i - 1].key < fields[i].key)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T, std::size_t N>
+void AppendJsonObject(std::string& out, const T& value, const std::array<JsonField<T>, N>& fields) {
+    out += '{';
+    for (std::size_t i = 0; i < N; ++i) {
+        if (i > 0) {
+            out += ',';
+        }
+        out += fields[i].key;
+        fields[i].append(out, value);
+    }
+    out += '}';
+}
+
+}  // namespace encounter_service::util
@@ -0,0 +1,47 @@
+#include "src/util/request_context.h"
+
+#include <utility>
+
+namespace encounter_service::util {
+
+RequestCancelled::RequestCancelled(Reason reason)
+    : std::runtime_error(reason == Reason::DeadlineExceeded ? "request deadline exceeded" : "request cancelled"),
+      reason_(reason) {}
+
+RequestContext::RequestContext(std::optional<Clock::time_point> deadline, std::function<bool()> disconnected)
+    : deadline_(deadline),
+      state_(std::make_shared<State>()) {
+    state_->disconnected = std::move(disconnected);
+}
+
+void RequestContext::Cancel() const {
+    if (state_) {
+        state_->cancelled.store(true, std::memory_order_relaxed);
+    }
+}
+
+std::optional<RequestCancelled::Reason> RequestContext::DoneReason() const {
+    if (deadline_ && Clock::now() >= *deadline_) {
+        return RequestCancelled::Reason::DeadlineExceeded;
+    }
+    if (!state_) {
+        return std::nullopt;
+    }
+    if (state_->cancelled.load(std::memory_order_relaxed)) {
+        return RequestCancelled::Reason::Cancelled;
+    }
+    // A disconnect is sticky; remember it so later checks skip the probe.
+    if (state_->disconnected && state_->disconnected()) {
+        state_->cancelled.store(true, std::memory_order_relaxed);
+        return RequestCancelled::Reason::Cancelled;
+    }
+    return std::nullopt;
+}
+
+void RequestContext::ThrowIfDone() const {
+    if (const auto reason = DoneReason()) {
+        throw RequestCancelled(*reason);
+    }
+}
+
+}  // namespace encounter_service::util
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+
+namespace encounter_service::util {
+
+// Thrown from cooperative checkpoints once the request that owns the work no longer needs it.
+class RequestCancelled : public std::runtime_error {
+public:
+    enum class Reason {
+        DeadlineExceeded,
+        // Cancelled explicitly or the client disconnected.
+        Cancelled,
+    };
+
+    explicit RequestCancelled(Reason reason);
+
+    [[nodiscard]] Reason reason() const noexcept { return reason_; }
+
+private:
+    Reason reason_;
+};
+
+// Per-request deadline and cancellation state, passed by const reference from the HTTP layer
+// through the service into repository scans. Copies share cancellation state. A default-constructed
+// context has no deadline and is never cancelled.
+class RequestContext {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    RequestContext() = default;
+    // `disconnected`, when set, is polled by checkpoints to detect clients that went away.
+    explicit RequestContext(std::optional<Clock::time_point> deadline, std::function<bool()> disconnected = {});
+
+    [[nodiscard]] const std::optional<Clock::time_point>& deadline() const { return deadline_; }
+
+    // Cancels this context and every copy of it. No-op on a default-constructed context.
+    void Cancel() const;
+    // Returns why work should stop, or std::nullopt while it may continue.
+    [[nodiscard]] std::optional<RequestCancelled::Reason> DoneReason() const;
+    [[nodiscard]] bool IsDone() const { return DoneReason().has_value(); }
+    // Throws RequestCancelled when DoneReason() is set.
+    void ThrowIfDone() const;
+
+private:
+    struct State {
+        std::atomic<bool> cancelled{false};
+        std::function<bool()> disconnected;
+    };
+
+    std::optional<Clock::time_point> deadline_;
+    std::shared_ptr<State> state_;
+};
+
+// Amortizes RequestContext checks in tight loops: ThrowIfDone() runs on every `interval`th Tick().
+class CancellationCheckpoint {
+public:
+    explicit CancellationCheckpoint(const RequestContext& context, std::uint32_t interval = 1024)
+        : context_(context),
+          interval_(interval == 0 ? 1 : interval) {}
+
+    void Tick() {
+        if (++ticks_ % interval_ == 0) {
+            context_.ThrowIfDone();
+        }
+    }
+
+private:
+    const RequestContext& context_;
+    std::uint32_t interval_;
+    std::uint32_t ticks_{0};
+};
+
+}  // namespace encounter_service::util
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+
+namespace encounter_service::util {
+
+// Fixed-capacity array of lazily allocated segments with stable element addresses.
+// Segments are installed with a CAS, so concurrent writers to distinct indices never lock and
+// never move existing elements. Callers are responsible for publishing element writes to readers.
+template <typename T>
+class SegmentedArray {
+public:
+    SegmentedArray(std::size_t segmentSize, std::size_t maxSegments)
+        : segmentSize_(segmentSize == 0 ? 1 : segmentSize),
+          maxSegments_(maxSegments == 0 ? 1 : maxSegments),
+          segments_(std::make_unique<std::atomic<T*>[]>(maxSegments_)) {}
+
+    SegmentedArray(const SegmentedArray&) = delete;
+    SegmentedArray& operator=(const SegmentedArray&) = delete;
+
+    ~SegmentedArray() {
+        for (std::size_t i = 0; i < maxSegments_; ++i) {
+            delete[] segments_[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    // Returns the element at `index`, allocating its segment on first use.
+    T& Slot(std::size_t index) {
+        const auto segment = index / segmentSize_;
+        if (segment >= maxSegments_) {
+            throw std::length_error("segmented array capacity exceeded");
+        }
+        auto* data = segments_[segment].load(std::memory_order_acquire);
+        if (data == nullptr) {
+            auto* fresh = new T[segmentSize_]();
+            if (segments_[segment].compare_exchange_strong(data, fresh, std::memory_order_acq_rel)) {
+                data = fresh;
+            } else {
+                delete[] fresh;
+            }
+        }
+        return data[index % segmentSize_];
+    }
+
+    // Returns the element at `index`; its segment must already exist.
+    const T& operator[](std::size_t index) const {
+        return segments_[index / segmentSize_].load(std::memory_order_acquire)[index % segmentSize_];
+    }
+
+private:
+    std::size_t segmentSize_;
+    std::size_t maxSegments_;
+    std::unique_ptr<std::atomic<T*>[]> segments_;
+};
+
+}  // namespace encounter_service::util
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace encounter_service::util {
+
+template <typename T = void>
+class Task;
+
+namespace detail {
+
+template <typename T>
+class TaskPromiseBase {
+public:
+    struct FinalAwaiter {
+        bool await_ready() noexcept { return false; }
+
+        // Resumes whoever awaited the task (symmetric transfer) instead of growing the stack.
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> finished) noexcept {
+            const auto continuation = finished.promise().continuation_;
+            return continuation ? continuation : std::noop_coroutine();
+        }
+
+        void await_resume() noexcept {}
+    };
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    FinalAwaiter final_suspend() noexcept { return {}; }
+    void unhandled_exception() noexcept { error_ = std::current_exception(); }
+
+    void SetContinuation(std::coroutine_handle<> continuation) noexcept { continuation_ = continuation; }
+
+protected:
+    void RethrowIfFailed() const {
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+    }
+
+private:
+    std::coroutine_handle<> continuation_{};
+    std::exception_ptr error_{};
+};
+
+template <typename T>
+class TaskPromise final : public TaskPromiseBase<T> {
+public:
+    Task<T> get_return_object() noexcept;
+
+    template <typename U>
+    void return_value(U&& value) {
+        value_.emplace(std::forward<U>(value));
+    }
+
+    T TakeResult() {
+        this->RethrowIfFailed();
+        return std::move(*value_);
+    }
+
+private:
+    std::optional<T> value_;
+};
+
+template <>
+class TaskPromise<void> final : public TaskPromiseBase<void> {
+public:
+    Task<void> get_return_object() noexcept;
+
+    void return_void() noexcept {}
+
+    void TakeResult() { RethrowIfFailed(); }
+};
+
+}  // namespace detail
+
+// Lazily started coroutine returning `T`. The body runs when the task is first awaited, and the
+// awaiting coroutine is resumed on whatever thread completes it; use Schedule() (executor.h) to hop
+// to a specific executor. Tasks are move-only and own their coroutine frame.
+// Coroutine parameters should be taken by value: reference parameters may dangle once the caller's
+// full expression ends.
+template <typename T>
+class [[nodiscard]] Task {
+public:
+    using promise_type = detail::TaskPromise<T>;
+
+    explicit Task(std::coroutine_handle<promise_type> handle) noexcept
+        : handle_(handle) {}
+
+    Task(Task&& other) noexcept
+        : handle_(std::exchange(other.handle_, {})) {}
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle_) {
+                handle_.destroy();
+            }
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    // Awaiting a moved-from (empty) task is a logic error rather than an immediate, empty result.
+    bool await_ready() const {
+        if (!handle_) {
+            throw std::logic_error("awaited an empty Task");
+        }
+        return handle_.done();
+    }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        handle_.promise().SetContinuation(awaiting);
+        return handle_;
+    }
+
+    T await_resume() { return handle_.promise().TakeResult(); }
+
+private:
+    std::coroutine_handle<promise_type> handle_;
+};
+
+namespace detail {
+
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept {
+    return Task<T>{std::coroutine_handle<TaskPromise<T>>::from_promise(*this)};
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+    return Task<void>{std::coroutine_handle<TaskPromise<void>>::from_promise(*this)};
+}
+
+// Eagerly started, self-destroying coroutine used to drive a Task from synchronous code.
+struct DetachedCoroutine {
+    struct promise_type {
+        DetachedCoroutine get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+}  // namespace detail
+
+// Runs `task` to completion and blocks the calling thread until it finishes, returning its result
+// or rethrowing its exception. Bridges async code into synchronous callers (handlers, tests).
+// Must not be called from a thread the task needs in order to make progress.
+template <typename T>
+T SyncWait(Task<T> task) {
+    std::mutex mutex;
+    std::condition_variable finished;
+    bool done = false;
+    std::exception_ptr error;
+    std::optional<std::conditional_t<std::is_void_v<T>, bool, T>> result;
+
+    auto signal = [&]() {
+        std::lock_guard lock(mutex);
+        done = true;
+        finished.notify_one();
+    };
+    auto drive = [&](Task<T> awaited) -> detail::DetachedCoroutine {
+        try {
+            if constexpr (std::is_void_v<T>) {
+                co_await std::move(awaited);
+                result.emplace(true);
+            } else {
+                result.emplace(co_await std::move(awaited));
+            }
+        } catch (...) {
+            error = std::current_exception();
+        }
+        signal();
+    };
+    drive(std::move(task));
+
+    std::unique_lock lock(mutex);
+    finished.wait(lock, [&]() { return done; });
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    if constexpr (!std::is_void_v<T>) {
+        return std::move(*result);
+    }
+}
+
+}  // namespace encounter_service::util
@@ -76,6 +76,13 @@ std::optional<std::time_t> TimegmUtc(std::tm tm) {
     return t;
 }
 
+void WriteDigits(char* out, int value, int width) {
+    for (int i = width - 1; i >= 0; --i) {
+        out[i] = static_cast<char>('0' + (value % 10));
+        value /= 10;
+    }
+}
+
 }  // namespace
 
 std::optional<std::chrono::system_clock::time_point> ParseIso8601Utc(const std::string& value) {
@@ -105,4 +112,26 @@ std::string FormatIso8601Utc(std::chrono::system_clock::time_point value) {
     return oss.str();
 }
 
+void FormatIso8601UtcTo(std::chrono::system_clock::time_point value, char* out) {
+    using namespace std::chrono;
+    // Truncate like system_clock::to_time_t so output matches FormatIso8601Utc().
+    const auto secondsSinceEpoch = duration_cast<seconds>(value.time_since_epoch());
+    const auto day = floor<days>(sys_seconds{secondsSinceEpoch});
+    const year_month_day date{day};
+    const hh_mm_ss clock{sys_seconds{secondsSinceEpoch} - day};
+
+    WriteDigits(out, static_cast<int>(date.year()), 4);
+    out[4] = '-';
+    WriteDigits(out + 5, static_cast<int>(static_cast<unsigned>(date.month())), 2);
+    out[7] = '-';
+    WriteDigits(out + 8, static_cast<int>(static_cast<unsigned>(date.day())), 2);
+    out[10] = 'T';
+    WriteDigits(out + 11, static_cast<int>(clock.hours().count()), 2);
+    out[13] = ':';
+    WriteDigits(out + 14, static_cast<int>(clock.minutes().count()), 2);
+    out[16] = ':';
+    WriteDigits(out + 17, static_cast<int>(clock.seconds().count()), 2);
+    out[19] = 'Z';
+}
+
 }  // namespace encounter_service::util
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 #include <optional>
 #include <string>
 
@@ -12,4 +13,10 @@ std::optional<std::chrono::system_clock::time_point> ParseIso8601Utc(const std::
 // Formats `value` as `YYYY-MM-DDTHH:MM:SSZ` in UTC.
 std::string FormatIso8601Utc(std::chrono::system_clock::time_point value);
 
+// Length of a `YYYY-MM-DDTHH:MM:SSZ` timestamp.
+inline constexpr std::size_t kIso8601UtcLength = 20;
+// Writes the same text as FormatIso8601Utc() into `out[0..kIso8601UtcLength)` without allocating.
+// Years outside 0000-9999 are not supported.
+void FormatIso8601UtcTo(std::chrono::system_clock::time_point value, char* out);
+
 }  // namespace encounter_service::util
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace encounter_service::util {
+
+// Appends `value` as an unsigned LEB128 varint (7 bits per byte, high bit = continuation).
+inline void AppendVarint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+// Reads an unsigned LEB128 varint at `pos`, advancing `pos` past it.
+// Returns std::nullopt on truncated or overlong input.
+inline std::optional<std::uint64_t> ReadVarint(const std::uint8_t* data, std::size_t size, std::size_t& pos) {
+    std::uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        if (pos >= size) {
+            return std::nullopt;
+        }
+        const auto byte = data[pos++];
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+    return std::nullopt;
+}
+
+// Maps signed deltas onto unsigned values so small magnitudes stay small varints.
+inline std::uint64_t ZigZagEncode(std::int64_t value) {
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+inline std::int64_t ZigZagDecode(std::uint64_t value) {
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+}  // namespace encounter_service::util
@@ -0,0 +1,173 @@
+#include "src/util/work_stealing_scheduler.h"
+
+#include <algorithm>
+#include <utility>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace encounter_service::util {
+
+namespace {
+
+// Identifies the scheduler and worker running on the current thread, so nested submissions stay local.
+thread_local const WorkStealingScheduler* t_scheduler = nullptr;
+thread_local std::size_t t_workerIndex = 0;
+
+void PinToCpu(std::thread& thread, std::size_t index) {
+#if defined(__linux__)
+    const auto cpus = std::max(1u, std::thread::hardware_concurrency());
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(index % cpus, &set);
+    (void)pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+#else
+    (void)thread;
+    (void)index;
+#endif
+}
+
+}  // namespace
+
+WorkStealingScheduler::WorkStealingScheduler(WorkStealingOptions options) {
+    auto count = options.threadCount;
+    if (count == 0) {
+        count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers_.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    // Deques exist before any worker starts, so stealing never sees a partially built pool.
+    for (std::size_t i = 0; i < count; ++i) {
+        workers_[i]->thread = std::thread([this, i]() { Run(i); });
+        if (options.pinThreads) {
+            PinToCpu(workers_[i]->thread, i);
+        }
+    }
+}
+
+WorkStealingScheduler::~WorkStealingScheduler() {
+    Shutdown();
+}
+
+void WorkStealingScheduler::Post(std::function<void()> work) {
+    if (!Enqueue(work)) {
+        work();
+    }
+}
+
+bool WorkStealingScheduler::TrySubmit(std::function<void()> work) {
+    return Enqueue(work);
+}
+
+bool WorkStealingScheduler::Enqueue(std::function<void()>& work) {
+    // Counted before the stop check so Shutdown() cannot let workers exit while this task is in flight.
+    pending_.fetch_add(1);
+    if (stopping_.load()) {
+        pending_.fetch_sub(1);
+        return false;
+    }
+
+    const auto index = t_scheduler == this ? t_workerIndex : nextWorker_.fetch_add(1) % workers_.size();
+    {
+        std::lock_guard lock(workers_[index]->mutex);
+        workers_[index]->tasks.push_back(Task{.work = std::move(work), .submittedAt = std::chrono::steady_clock::now()});
+    }
+    if (sleeping_.load() > 0) {
+        // Taking the lock orders this wake after a sleeper's predicate check.
+        { std::lock_guard lock(sleepMutex_); }
+        wake_.notify_one();
+    }
+    return true;
+}
+
+void WorkStealingScheduler::Shutdown() {
+    std::lock_guard shutdownLock(shutdownMutex_);
+    if (joined_) {
+        return;
+    }
+    {
+        std::lock_guard lock(sleepMutex_);
+        stopping_.store(true);
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+        worker->thread.join();
+    }
+    joined_ = true;
+}
+
+WorkStealingStats WorkStealingScheduler::stats() const {
+    return WorkStealingStats{
+        .threads = workers_.size(),
+        .queueDepth = pending_.load(std::memory_order_relaxed),
+        .executed = executed_.load(std::memory_order_relaxed),
+        .stolen = stolen_.load(std::memory_order_relaxed),
+        .totalWait = std::chrono::nanoseconds{totalWaitNanos_.load(std::memory_order_relaxed)},
+        .maxWait = std::chrono::nanoseconds{maxWaitNanos_.load(std::memory_order_relaxed)},
+    };
+}
+
+void WorkStealingScheduler::Run(std::size_t index) {
+    t_scheduler = this;
+    t_workerIndex = index;
+    for (;;) {
+        Task task;
+        if (TakeLocal(index, task) || Steal(index, task)) {
+            Execute(task);
+            continue;
+        }
+
+        std::unique_lock lock(sleepMutex_);
+        sleeping_.fetch_add(1);
+        wake_.wait(lock, [this]() { return pending_.load() > 0 || stopping_.load(); });
+        sleeping_.fetch_sub(1);
+        if (stopping_.load() && pending_.load() == 0) {
+            return;
+        }
+    }
+}
+
+bool WorkStealingScheduler::TakeLocal(std::size_t index, Task& task) {
+    auto& worker = *workers_[index];
+    std::lock_guard lock(worker.mutex);
+    if (worker.tasks.empty()) {
+        return false;
+    }
+    task = std::move(worker.tasks.front());
+    worker.tasks.pop_front();
+    pending_.fetch_sub(1);
+    return true;
+}
+
+bool WorkStealingScheduler::Steal(std::size_t index, Task& task) {
+    for (std::size_t offset = 1; offset < workers_.size(); ++offset) {
+        auto& victim = *workers_[(index + offset) % workers_.size()];
+        std::unique_lock lock(victim.mutex, std::try_to_lock);
+        if (!lock.owns_lock() || victim.tasks.empty()) {
+            continue;
+        }
+        task = std::move(victim.tasks.back());
+        victim.tasks.pop_back();
+        pending_.fetch_sub(1);
+        stolen_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingScheduler::Execute(Task& task) {
+    const auto wait = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - task.submittedAt).count();
+    totalWaitNanos_.fetch_add(wait, std::memory_order_relaxed);
+    auto max = maxWaitNanos_.load(std::memory_order_relaxed);
+    while (wait > max && !maxWaitNanos_.compare_exchange_weak(max, wait, std::memory_order_relaxed)) {
+    }
+    task.work();
+    executed_.fetch_add(1, std::memory_order_relaxed);
+}
+
+}  // namespace encounter_service::util
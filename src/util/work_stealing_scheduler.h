@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "src/util/executor.h"
+
+namespace encounter_service::util {
+
+struct WorkStealingOptions {
+    // Worker threads; 0 uses std::thread::hardware_concurrency().
+    std::size_t threadCount{0};
+    // Pins worker i to CPU i modulo the CPU count (Linux only; ignored elsewhere).
+    bool pinThreads{false};
+};
+
+struct WorkStealingStats {
+    std::size_t threads{0};
+    // Tasks submitted but not yet started, across all workers.
+    std::size_t queueDepth{0};
+    std::uint64_t executed{0};
+    // Tasks a worker took from another worker's deque.
+    std::uint64_t stolen{0};
+    // Time from submission to start, summed over executed tasks, and the longest single wait.
+    std::chrono::nanoseconds totalWait{0};
+    std::chrono::nanoseconds maxWait{0};
+};
+
+// Fixed pool of workers, each with its own task deque. Work submitted from a worker stays on that
+// worker's deque; work from other threads is spread round-robin. An idle worker steals from the
+// other end of its peers' deques before sleeping, so there is no single queue lock that every
+// submission and every worker contends on.
+class WorkStealingScheduler final : public Executor {
+public:
+    explicit WorkStealingScheduler(WorkStealingOptions options = {});
+    ~WorkStealingScheduler() override;
+
+    WorkStealingScheduler(const WorkStealingScheduler&) = delete;
+    WorkStealingScheduler& operator=(const WorkStealingScheduler&) = delete;
+
+    // Runs `work` on the calling thread once the scheduler has been shut down.
+    void Post(std::function<void()> work) override;
+    // Returns false, without running `work`, once the scheduler has been shut down.
+    [[nodiscard]] bool TrySubmit(std::function<void()> work);
+    // Runs every task already submitted, then joins the workers. Must not be called from a worker.
+    void Shutdown();
+
+    [[nodiscard]] std::size_t threadCount() const { return workers_.size(); }
+    [[nodiscard]] WorkStealingStats stats() const;
+
+private:
+    struct Task {
+        std::function<void()> work;
+        std::chrono::steady_clock::time_point submittedAt;
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        // The owner takes the oldest task from the front; thieves take from the back.
+        std::deque<Task> tasks;
+        std::thread thread;
+    };
+
+    // Moves `work` into a deque and returns true, or leaves it untouched once stopping.
+    bool Enqueue(std::function<void()>& work);
+    void Run(std::size_t index);
+    bool TakeLocal(std::size_t index, Task& task);
+    bool Steal(std::size_t index, Task& task);
+    void Execute(Task& task);
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<std::size_t> nextWorker_{0};
+    // Submitted and not yet taken; workers only sleep while this is zero.
+    std::atomic<std::size_t> pending_{0};
+    std::atomic<std::size_t> sleeping_{0};
+    std::atomic<bool> stopping_{false};
+    std::mutex sleepMutex_;
+    std::condition_variable wake_;
+    std::mutex shutdownMutex_;
+    bool joined_{false};
+
+    std::atomic<std::uint64_t> executed_{0};
+    std::atomic<std::uint64_t> stolen_{0};
+    std::atomic<std::int64_t> totalWaitNanos_{0};
+    std::atomic<std::int64_t> maxWaitNanos_{0};
+};
+
+}  // namespace encounter_service::util
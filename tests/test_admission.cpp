@@ -0,0 +1,87 @@
+#include "tests/catch_compat.h"
+
+#include <chrono>
+#include <thread>
+
+#include "src/http/admission.h"
+
+using encounter_service::http::AdaptiveConcurrencyLimiter;
+using encounter_service::http::ConcurrencyLimitOptions;
+
+TEST_CASE("AdaptiveConcurrencyLimiter grows additively on fast completions and backs off on slow ones") {
+    ConcurrencyLimitOptions options{};
+    options.initialLimit = 4;
+    options.maxLimit = 5;
+    options.targetLatency = std::chrono::milliseconds{10};
+    options.backoffRatio = 0.5;
+    AdaptiveConcurrencyLimiter limiter(options);
+
+    for (int i = 0; i < 8; ++i) {
+        REQUIRE(limiter.TryAcquire());
+        limiter.Release(std::chrono::milliseconds{1});
+    }
+    REQUIRE(limiter.stats().limit > 5.0 - 1e-9);
+
+    REQUIRE(limiter.TryAcquire());
+    limiter.Release(std::chrono::milliseconds{50});
+    REQUIRE(limiter.stats().limit < 2.5 + 1e-9);
+
+    for (int i = 0; i < 4; ++i) {
+        REQUIRE(limiter.TryAcquire());
+        limiter.Release(std::chrono::seconds{1});
+    }
+    REQUIRE(limiter.stats().limit == options.minLimit);
+}
+
+TEST_CASE("AdaptiveConcurrencyLimiter sheds once the queue is full or the wait deadline passes") {
+    ConcurrencyLimitOptions options{};
+    options.initialLimit = 1;
+    options.maxQueue = 1;
+    options.maxQueueWait = std::chrono::milliseconds{20};
+    AdaptiveConcurrencyLimiter limiter(options);
+
+    REQUIRE(limiter.TryAcquire());
+    // The only queue slot times out because nothing releases in time.
+    REQUIRE(!limiter.TryAcquire());
+
+    // A queued caller is admitted as soon as the holder releases.
+    bool queuedAdmitted = false;
+    ConcurrencyLimitOptions slow = options;
+    slow.maxQueueWait = std::chrono::seconds{5};
+    AdaptiveConcurrencyLimiter waiting(slow);
+    REQUIRE(waiting.TryAcquire());
+    std::thread queued([&]() { queuedAdmitted = waiting.TryAcquire(); });
+    while (waiting.stats().queued == 0) {
+        std::this_thread::yield();
+    }
+    // Queue is full: a third caller is shed immediately instead of waiting.
+    REQUIRE(!waiting.TryAcquire());
+    waiting.Release(std::chrono::milliseconds{1});
+    queued.join();
+    REQUIRE(queuedAdmitted);
+
+    const auto stats = waiting.stats();
+    REQUIRE(stats.inFlight == 1);
+    REQUIRE(stats.admitted == 2);
+    REQUIRE(stats.shed == 1);
+}
+
+TEST_CASE("AdmissionController tracks route classes independently and releases tickets on scope exit") {
+    encounter_service::http::AdmissionOptions options{};
+    for (auto& limit : options.limits) {
+        limit.initialLimit = 1;
+        limit.maxQueue = 0;
+    }
+    encounter_service::http::AdmissionController admission(options);
+    using encounter_service::http::RouteClass;
+
+    {
+        auto write = admission.TryAdmit(RouteClass::Write);
+        REQUIRE(write.has_value());
+        REQUIRE(!admission.TryAdmit(RouteClass::Write).has_value());
+        REQUIRE(admission.TryAdmit(RouteClass::Read).has_value());
+        REQUIRE(admission.stats(RouteClass::Write).inFlight == 1);
+    }
+    REQUIRE(admission.stats(RouteClass::Write).inFlight == 0);
+    REQUIRE(admission.TryAdmit(RouteClass::Write).has_value());
+}
@@ -0,0 +1,126 @@
+#include "tests/catch_compat.h"
+
+#include <chrono>
+#include <functional>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "src/domain/async_encounter_service.h"
+#include "src/storage/async_audit_repo.h"
+#include "src/storage/async_encounter_repo.h"
+#include "src/storage/in_memory_audit_repo.h"
+#include "src/storage/in_memory_encounter_repo.h"
+#include "src/util/executor.h"
+#include "src/util/task.h"
+
+namespace {
+
+class FixedClock final : public encounter_service::util::Clock {
+public:
+    TimePoint Now() const override {
+        return TimePoint{std::chrono::seconds{1700000000}};
+    }
+};
+
+class CountingIdGenerator final : public encounter_service::util::IdGenerator {
+public:
+    std::string NextId() override {
+        return "enc-" + std::to_string(++next_);
+    }
+
+private:
+    int next_{0};
+};
+
+// Runs each posted item on its own thread; joined on destruction.
+class ThreadPerTaskExecutor final : public encounter_service::util::Executor {
+public:
+    ~ThreadPerTaskExecutor() override {
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    void Post(std::function<void()> work) override {
+        threads_.emplace_back(std::move(work));
+    }
+
+private:
+    std::vector<std::thread> threads_;
+};
+
+encounter_service::domain::CreateEncounterInput MakeInput() {
+    encounter_service::domain::CreateEncounterInput input{};
+    input.patientId = "patient-1";
+    input.providerId = "provider-1";
+    input.encounterDate = std::chrono::system_clock::time_point{std::chrono::seconds{1700000000}};
+    input.encounterType = "visit";
+    input.clinicalData = nlohmann::json::object();
+    return input;
+}
+
+}  // namespace
+
+TEST_CASE("DefaultAsyncEncounterService creates, reads and audits through ready repositories") {
+    using encounter_service::util::SyncWait;
+    encounter_service::storage::InMemoryEncounterRepository encounterRepo;
+    encounter_service::storage::InMemoryAuditRepository auditRepo;
+    encounter_service::storage::ReadyEncounterRepository asyncEncounterRepo(encounterRepo);
+    encounter_service::storage::ReadyAuditRepository asyncAuditRepo(auditRepo);
+    FixedClock clock;
+    CountingIdGenerator idGenerator;
+    encounter_service::util::InlineExecutor executor;
+    encounter_service::domain::DefaultAsyncEncounterService service(
+        asyncEncounterRepo, asyncAuditRepo, clock, idGenerator, executor);
+
+    const auto created = SyncWait(service.CreateEncounterAsync(MakeInput(), "clinician-a"));
+    REQUIRE(created.index() == 0);
+    REQUIRE(std::get<encounter_service::domain::Encounter>(created).encounterId == "enc-1");
+
+    const auto read = SyncWait(service.GetEncounterAsync("enc-1", "reader-a"));
+    REQUIRE(read.index() == 0);
+    REQUIRE(std::get<encounter_service::domain::Encounter>(read).metadata.createdBy == "clinician-a");
+
+    const auto missing = SyncWait(service.GetEncounterAsync("missing", "reader-a"));
+    REQUIRE(std::get<encounter_service::domain::DomainError>(missing).code ==
+            encounter_service::domain::DomainErrorCode::NotFound);
+
+    const auto unauthorized = SyncWait(service.QueryEncountersAsync({}, "", {}));
+    REQUIRE(std::get<encounter_service::domain::DomainError>(unauthorized).code ==
+            encounter_service::domain::DomainErrorCode::Unauthorized);
+
+    const auto audits = SyncWait(service.QueryAuditAsync({}));
+    const auto& entries = std::get<std::vector<encounter_service::domain::AuditEntry>>(audits);
+    REQUIRE(entries.size() == 2);
+    REQUIRE(entries[0].action == encounter_service::domain::AuditAction::CREATE_ENCOUNTER);
+    REQUIRE(entries[1].action == encounter_service::domain::AuditAction::READ_ENCOUNTER);
+    REQUIRE(entries[1].actor == "reader-a");
+}
+
+TEST_CASE("DefaultAsyncEncounterService runs operations on the configured executor") {
+    using encounter_service::util::SyncWait;
+    encounter_service::storage::InMemoryEncounterRepository encounterRepo;
+    encounter_service::storage::InMemoryAuditRepository auditRepo;
+    encounter_service::storage::ReadyEncounterRepository asyncEncounterRepo(encounterRepo);
+    encounter_service::storage::ReadyAuditRepository asyncAuditRepo(auditRepo);
+    FixedClock clock;
+    CountingIdGenerator idGenerator;
+    ThreadPerTaskExecutor executor;
+    encounter_service::domain::DefaultAsyncEncounterService service(
+        asyncEncounterRepo, asyncAuditRepo, clock, idGenerator, executor);
+
+    REQUIRE(SyncWait(service.CreateEncounterAsync(MakeInput(), "clinician-a")).index() == 0);
+    REQUIRE(SyncWait(service.CreateEncounterAsync(MakeInput(), "clinician-a")).index() == 0);
+
+    const auto batch = SyncWait(service.BatchGetEncountersAsync({"enc-2", "missing", "enc-1"}, "reader-a"));
+    const auto& slots = std::get<std::vector<std::optional<encounter_service::domain::Encounter>>>(batch);
+    REQUIRE(slots.size() == 3);
+    REQUIRE(slots[0]->encounterId == "enc-2");
+    REQUIRE(!slots[1].has_value());
+    REQUIRE(slots[2]->encounterId == "enc-1");
+    REQUIRE(auditRepo.Query({}).size() == 4);
+}
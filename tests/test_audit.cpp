@@ -3,8 +3,12 @@
 
 #include <chrono>
 #include <deque>
+#include <optional>
+#include <string>
 #include <variant>
+#include <vector>
 
+#include "src/domain/encounter_etag.h"
 #include "src/domain/encounter_service.h"
 #include "src/storage/in_memory_encounter_repo.h"
 #include "src/storage/in_memory_audit_repo.h"
@@ -113,6 +117,40 @@ TEST_CASE("CreateEncounter sets metadata and appends CREATE audit entry") {
     REQUIRE(audits[0].timestamp == clock.Now());
 }
 
+TEST_CASE("CreateEncounter assigns a content ETag and bumps the write generation") {
+    using namespace std::chrono;
+
+    encounter_service::storage::InMemoryEncounterRepository encounterRepo;
+    encounter_service::storage::InMemoryAuditRepository auditRepo;
+    FixedClock clock(system_clock::time_point{seconds{1700000000}});
+    FixedIdGenerator idGenerator({"enc-1", "enc-2"});
+    encounter_service::domain::DefaultEncounterService service(encounterRepo, auditRepo, clock, idGenerator);
+
+    encounter_service::domain::CreateEncounterInput input{};
+    input.patientId = "patient-1";
+    input.providerId = "provider-1";
+    input.encounterDate = system_clock::time_point{seconds{1700000100}};
+    input.encounterType = "visit";
+    input.clinicalData = nlohmann::json::object();
+    input.clinicalData["notes"] = "stable";
+
+    REQUIRE(service.EncounterWriteGeneration() == 0);
+    const auto first = std::get<encounter_service::domain::Encounter>(service.CreateEncounter(input, "actor"));
+    input.clinicalData["notes"] = "improving";
+    const auto second = std::get<encounter_service::domain::Encounter>(service.CreateEncounter(input, "actor"));
+    REQUIRE(service.EncounterWriteGeneration() == 2);
+
+    REQUIRE(first.etag.size() == 18);
+    REQUIRE(first.etag.front() == '"');
+    REQUIRE(first.etag.back() == '"');
+    REQUIRE(first.etag != second.etag);
+    REQUIRE(first.etag == encounter_service::domain::ComputeEncounterEtag(first));
+
+    // The tag is stored with the record, so reads return it without recomputing.
+    const auto read = std::get<encounter_service::domain::Encounter>(service.GetEncounter("enc-1", "actor"));
+    REQUIRE(read.etag == first.etag);
+}
+
 TEST_CASE("CreateEncounter sets createdAt and updatedAt to same value") {
     using namespace std::chrono;
 
@@ -321,10 +359,10 @@ TEST_CASE("QueryEncounters filters by patientId") {
 
     encounter_service::storage::EncounterQueryFilters filters{};
     filters.patientId = "patient-1";
-    const auto result = service.QueryEncounters(filters);
+    const auto result = service.QueryEncounters(filters, "reader-a", {});
     REQUIRE(result.index() == 0);
 
-    const auto encounters = std::get<std::vector<encounter_service::domain::Encounter>>(result);
+    const auto& encounters = *std::get<encounter_service::storage::SharedEncounters>(result);
     REQUIRE(encounters.size() == 1);
     REQUIRE(encounters[0].encounterId == "enc-1");
 }
@@ -361,10 +399,10 @@ TEST_CASE("QueryEncounters filters by providerId") {
 
     encounter_service::storage::EncounterQueryFilters filters{};
     filters.providerId = "provider-2";
-    const auto result = service.QueryEncounters(filters);
+    const auto result = service.QueryEncounters(filters, "reader-a", {});
     REQUIRE(result.index() == 0);
 
-    const auto encounters = std::get<std::vector<encounter_service::domain::Encounter>>(result);
+    const auto& encounters = *std::get<encounter_service::storage::SharedEncounters>(result);
     REQUIRE(encounters.size() == 1);
     REQUIRE(encounters[0].encounterId == "enc-2");
 }
@@ -424,10 +462,10 @@ TEST_CASE("QueryEncounters filters by from and to inclusive") {
     filters.encounterDateFrom = t1;
     filters.encounterDateTo = t2;
 
-    const auto result = service.QueryEncounters(filters);
+    const auto result = service.QueryEncounters(filters, "reader-a", {});
     REQUIRE(result.index() == 0);
 
-    const auto encounters = std::get<std::vector<encounter_service::domain::Encounter>>(result);
+    const auto& encounters = *std::get<encounter_service::storage::SharedEncounters>(result);
     REQUIRE(encounters.size() == 2);
     REQUIRE(encounters[0].encounterId == "enc-1");
     REQUIRE(encounters[1].encounterId == "enc-2");
@@ -474,12 +512,193 @@ TEST_CASE("QueryEncounters returns deterministic order by encounterDate then enc
     encounterRepo.Create(e3);
 
     encounter_service::storage::EncounterQueryFilters filters{};
-    const auto result = service.QueryEncounters(filters);
+    const auto result = service.QueryEncounters(filters, "reader-a", {});
     REQUIRE(result.index() == 0);
 
-    const auto encounters = std::get<std::vector<encounter_service::domain::Encounter>>(result);
+    const auto& encounters = *std::get<encounter_service::storage::SharedEncounters>(result);
     REQUIRE(encounters.size() == 3);
     REQUIRE(encounters[0].encounterId == "enc-c");
     REQUIRE(encounters[1].encounterId == "enc-a");
     REQUIRE(encounters[2].encounterId == "enc-b");
 }
+
+TEST_CASE("QueryEncounters appends one bulk LIST audit record expanded per encounter on query") {
+    using namespace std::chrono;
+
+    encounter_service::storage::InMemoryEncounterRepository encounterRepo;
+    encounter_service::storage::InMemoryAuditRepository auditRepo;
+    FixedClock clock(system_clock::time_point{seconds{1700000500}});
+    FixedIdGenerator idGenerator({"unused-id"});
+
+    encounter_service::domain::DefaultEncounterService service(encounterRepo, auditRepo, clock, idGenerator);
+
+    for (const auto* id : {"enc-2", "enc-1", "enc-3"}) {
+        encounter_service::domain::Encounter e{};
+        e.encounterId = id;
+        e.patientId = "patient-1";
+        e.providerId = "provider-1";
+        e.encounterDate = system_clock::time_point{seconds{1700000000}};
+        e.encounterType = "visit";
+        e.clinicalData = nlohmann::json::object();
+        encounterRepo.Create(e);
+    }
+
+    const auto result = service.QueryEncounters({}, "lister-a", {});
+    REQUIRE(result.index() == 0);
+    REQUIRE(auditRepo.stats().hotEntries == 1);
+
+    const auto audits = auditRepo.Query({});
+    REQUIRE(audits.size() == 3);
+    REQUIRE(audits[0].encounterId == "enc-1");
+    REQUIRE(audits[1].encounterId == "enc-2");
+    REQUIRE(audits[2].encounterId == "enc-3");
+    for (const auto& audit : audits) {
+        REQUIRE(audit.action == encounter_service::domain::AuditAction::LIST_ENCOUNTERS);
+        REQUIRE(audit.actor == "lister-a");
+        REQUIRE(audit.timestamp == clock.Now());
+    }
+
+    const auto rollups = auditRepo.QueryRollups({});
+    REQUIRE(rollups.size() == 1);
+    REQUIRE(rollups[0].count == 1);
+}
+
+TEST_CASE("BatchGetEncounters rolls up one read per encounter like single reads") {
+    using namespace std::chrono;
+
+    encounter_service::storage::InMemoryEncounterRepository encounterRepo;
+    encounter_service::storage::InMemoryAuditRepository batchAudit;
+    encounter_service::storage::InMemoryAuditRepository singleAudit;
+    FixedClock clock(system_clock::time_point{seconds{1700000500}});
+    FixedIdGenerator idGenerator({"unused-id"});
+    encounter_service::domain::DefaultEncounterService batchService(encounterRepo, batchAudit, clock, idGenerator);
+    encounter_service::domain::DefaultEncounterService singleService(encounterRepo, singleAudit, clock, idGenerator);
+
+    std::vector<std::string> ids;
+    for (int i = 0; i < 50; ++i) {
+        encounter_service::domain::Encounter e{};
+        e.encounterId = "enc-" + std::to_string(i);
+        e.clinicalData = nlohmann::json::object();
+        encounterRepo.Create(e);
+        ids.push_back(e.encounterId);
+    }
+
+    REQUIRE(batchService.BatchGetEncounters(ids, "reader").index() == 0);
+    for (const auto& id : ids) {
+        REQUIRE(singleService.GetEncounter(id, "reader").index() == 0);
+    }
+
+    const auto batchRollups = batchAudit.QueryRollups({});
+    const auto singleRollups = singleAudit.QueryRollups({});
+    REQUIRE(batchRollups.size() == 1);
+    REQUIRE(singleRollups.size() == 1);
+    REQUIRE(batchRollups[0].action == encounter_service::domain::AuditAction::READ_ENCOUNTER);
+    REQUIRE(batchRollups[0].count == 50);
+    REQUIRE(batchRollups[0].count == singleRollups[0].count);
+    REQUIRE(batchAudit.Query({}).size() == batchRollups[0].count);
+}
+
+TEST_CASE("QueryEncounters with no results does not append audit entry") {
+    using namespace std::chrono;
+
+    encounter_service::storage::InMemoryEncounterRepository encounterRepo;
+    encounter_service::storage::InMemoryAuditRepository auditRepo;
+    FixedClock clock(system_clock::time_point{seconds{1700000500}});
+    FixedIdGenerator idGenerator({"unused-id"});
+
+    encounter_service::domain::DefaultEncounterService service(encounterRepo, auditRepo, clock, idGenerator);
+
+    const auto result = service.QueryEncounters({}, "lister-a", {});
+    REQUIRE(result.index() == 0);
+    REQUIRE(auditRepo.Query({}).empty());
+}
+
+TEST_CASE("QueryEncounters stops a scan past its deadline and records no audit entry") {
+    using namespace std::chrono;
+
+    encounter_service::storage::InMemoryEncounterRepository encounterRepo;
+    encounter_service::storage::InMemoryAuditRepository auditRepo;
+    FixedClock clock(system_clock::time_point{seconds{1700000500}});
+    FixedIdGenerator idGenerator({"unused-id"});
+
+    for (int i = 0; i < 5000; ++i) {
+        encounter_service::domain::Encounter e{};
+        e.encounterId = "enc-" + std::to_string(i);
+        e.patientId = "patient-1";
+        e.encounterDate = system_clock::time_point{seconds{1700000000 + i}};
+        encounterRepo.Create(e);
+    }
+
+    encounter_service::domain::DefaultEncounterService service(encounterRepo, auditRepo, clock, idGenerator);
+
+    const encounter_service::util::RequestContext expired(steady_clock::now() - milliseconds{1});
+    const auto result = service.QueryEncounters({}, "lister-a", expired);
+    REQUIRE(result.index() == 1);
+    const auto& error = std::get<encounter_service::domain::DomainError>(result);
+    REQUIRE(error.code == encounter_service::domain::DomainErrorCode::DeadlineExceeded);
+    REQUIRE(error.message == "Request deadline exceeded");
+    REQUIRE(auditRepo.Query({}).empty());
+
+    const encounter_service::util::RequestContext cancelled(std::nullopt);
+    cancelled.Cancel();
+    const auto cancelledResult = service.QueryEncounters({}, "lister-a", cancelled);
+    REQUIRE(std::get<encounter_service::domain::DomainError>(cancelledResult).message == "Request cancelled");
+}
+
+TEST_CASE("BatchGetEncounters returns request-ordered slots and one bulk READ audit record") {
+    using namespace std::chrono;
+
+    encounter_service::storage::InMemoryEncounterRepository encounterRepo;
+    encounter_service::storage::InMemoryAuditRepository auditRepo;
+    FixedClock clock(system_clock::time_point{seconds{1700000500}});
+    FixedIdGenerator idGenerator({"unused-id"});
+
+    encounter_service::domain::DefaultEncounterService service(encounterRepo, auditRepo, clock, idGenerator);
+
+    for (const auto* id : {"enc-1", "enc-2"}) {
+        encounter_service::domain::Encounter e{};
+        e.encounterId = id;
+        e.patientId = "patient-1";
+        e.providerId = "provider-1";
+        e.encounterDate = system_clock::time_point{seconds{1700000000}};
+        e.encounterType = "visit";
+        e.clinicalData = nlohmann::json::object();
+        encounterRepo.Create(e);
+    }
+
+    const auto result = service.BatchGetEncounters({"enc-2", "missing", "enc-1", "enc-2"}, "reader-a");
+    REQUIRE(result.index() == 0);
+    const auto& slots = std::get<std::vector<std::optional<encounter_service::domain::Encounter>>>(result);
+    REQUIRE(slots.size() == 4);
+    REQUIRE(slots[0]->encounterId == "enc-2");
+    REQUIRE(!slots[1].has_value());
+    REQUIRE(slots[2]->encounterId == "enc-1");
+    REQUIRE(slots[3]->encounterId == "enc-2");
+    REQUIRE(auditRepo.stats().hotEntries == 1);
+
+    const auto audits = auditRepo.Query({});
+    REQUIRE(audits.size() == 2);
+    REQUIRE(audits[0].encounterId == "enc-1");
+    REQUIRE(audits[1].encounterId == "enc-2");
+    for (const auto& audit : audits) {
+        REQUIRE(audit.action == encounter_service::domain::AuditAction::READ_ENCOUNTER);
+        REQUIRE(audit.actor == "reader-a");
+        REQUIRE(audit.timestamp == clock.Now());
+    }
+}
+
+TEST_CASE("BatchGetEncounters with only unknown IDs does not append audit entry") {
+    using namespace std::chrono;
+
+    encounter_service::storage::InMemoryEncounterRepository encounterRepo;
+    encounter_service::storage::InMemoryAuditRepository auditRepo;
+    FixedClock clock(system_clock::time_point{seconds{1700000500}});
+    FixedIdGenerator idGenerator({"unused-id"});
+
+    encounter_service::domain::DefaultEncounterService service(encounterRepo, auditRepo, clock, idGenerator);
+
+    const auto result = service.BatchGetEncounters({"missing"}, "reader-a");
+    REQUIRE(result.index() == 0);
+    REQUIRE(auditRepo.Query({}).empty());
+    REQUIRE(service.BatchGetEncounters({"missing"}, "").index() == 1);
+}
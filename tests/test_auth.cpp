@@ -42,6 +42,21 @@ TEST_CASE("Authenticate returns actor when API key is present") {
     REQUIRE(std::get<std::string>(result) == "api-key-actor");
 }
 
+TEST_CASE("RateLimitKey separates API keys without retaining them") {
+    httplib::Request first{};
+    SetHeader(first, "x-api-key", "first-key");
+    httplib::Request again{};
+    SetHeader(again, "X-API-Key", "first-key");
+    httplib::Request second{};
+    SetHeader(second, "x-api-key", "second-key");
+
+    const auto key = encounter_service::http::RateLimitKey(first);
+    REQUIRE(key == encounter_service::http::RateLimitKey(again));
+    REQUIRE(key != encounter_service::http::RateLimitKey(second));
+    REQUIRE(key.size() == 20);
+    REQUIRE(key.find("first-key") == std::string::npos);
+}
+
 TEST_CASE("Request header lookup is case-insensitive in httplib compat") {
     httplib::Request req{};
     SetHeader(req, "x-api-key", "test-key");
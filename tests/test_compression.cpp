@@ -0,0 +1,102 @@
+#include "tests/catch_compat.h"
+
+#include <string>
+
+#include <zlib.h>
+
+#include "src/http/compression.h"
+
+namespace {
+
+std::string Gunzip(const std::string& compressed) {
+    z_stream z{};
+    REQUIRE(inflateInit2(&z, 15 + 16) == Z_OK);
+    z.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(compressed.data()));
+    z.avail_in = static_cast<uInt>(compressed.size());
+    std::string out;
+    int ret = Z_OK;
+    while (ret == Z_OK) {
+        char buffer[4096];
+        z.next_out = reinterpret_cast<Bytef*>(buffer);
+        z.avail_out = sizeof(buffer);
+        ret = inflate(&z, Z_NO_FLUSH);
+        out.append(buffer, sizeof(buffer) - z.avail_out);
+    }
+    inflateEnd(&z);
+    REQUIRE(ret == Z_STREAM_END);
+    return out;
+}
+
+std::string SampleJson(int records) {
+    std::string json = "[";
+    for (int i = 0; i < records; ++i) {
+        if (i > 0) {
+            json += ',';
+        }
+        json += "{\"encounterId\":\"enc-" + std::to_string(i) +
+                "\",\"patientId\":\"patient-1\",\"encounterType\":\"visit\"}";
+    }
+    json += ']';
+    return json;
+}
+
+}  // namespace
+
+TEST_CASE("AcceptsGzip honors tokens, q-values and wildcards") {
+    using encounter_service::http::AcceptsGzip;
+    REQUIRE(AcceptsGzip("gzip"));
+    REQUIRE(AcceptsGzip("deflate, GZIP;q=0.5, br"));
+    REQUIRE(AcceptsGzip("x-gzip"));
+    REQUIRE(AcceptsGzip("*"));
+    REQUIRE(AcceptsGzip("br, *;q=0.1"));
+    REQUIRE(!AcceptsGzip(""));
+    REQUIRE(!AcceptsGzip("identity"));
+    REQUIRE(!AcceptsGzip("deflate, br"));
+    REQUIRE(!AcceptsGzip("gzip;q=0"));
+    REQUIRE(!AcceptsGzip("gzip; q=0.000"));
+    // An explicit gzip entry wins over the wildcard either way.
+    REQUIRE(!AcceptsGzip("*, gzip;q=0"));
+    REQUIRE(AcceptsGzip("*;q=0, gzip"));
+}
+
+TEST_CASE("GzipCompress round-trips and shrinks repetitive JSON") {
+    const auto json = SampleJson(2000);
+    const auto compressed = encounter_service::http::GzipCompress(json, 6);
+    REQUIRE(compressed.size() * 10 < json.size());
+    REQUIRE(Gunzip(compressed) == json);
+    const auto empty = encounter_service::http::GzipCompress("", 6);
+    REQUIRE(Gunzip(empty).empty());
+}
+
+TEST_CASE("GzipEncoder streams batches into one gzip member") {
+    const auto json = SampleJson(5000);
+    encounter_service::http::GzipEncoder encoder(1);
+    std::string compressed;
+    for (std::size_t offset = 0; offset < json.size(); offset += 7000) {
+        encoder.Write(std::string_view(json).substr(offset, 7000), compressed);
+    }
+    encoder.Finish(compressed);
+    REQUIRE(Gunzip(compressed) == json);
+}
+
+TEST_CASE("CompressedResponseCache evicts least recently used bodies past its byte budget") {
+    encounter_service::http::CompressedResponseCache cache(100);
+    cache.Insert("a", std::make_shared<const std::string>(40, 'a'));
+    cache.Insert("b", std::make_shared<const std::string>(40, 'b'));
+    REQUIRE(cache.Find("a") != nullptr);
+    cache.Insert("c", std::make_shared<const std::string>(40, 'c'));
+    // `b` was least recently used once `a` was read.
+    REQUIRE(cache.Find("b") == nullptr);
+    const std::string expected(40, 'a');
+    REQUIRE(*cache.Find("a") == expected);
+    REQUIRE(cache.Find("c") != nullptr);
+    cache.Insert("huge", std::make_shared<const std::string>(101, 'h'));
+    REQUIRE(cache.Find("huge") == nullptr);
+
+    const auto stats = cache.stats();
+    REQUIRE(stats.entries == 2);
+    REQUIRE(stats.bytes == 80);
+    REQUIRE(stats.evictions == 1);
+    REQUIRE(stats.hits == 3);
+    REQUIRE(stats.misses == 2);
+}
@@ -0,0 +1,122 @@
+#include "tests/catch_compat.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <utility>
+#include <variant>
+
+#include "src/domain/encounter_service.h"
+#include "src/http/validation.h"
+#include "src/storage/caching_encounter_repo.h"
+#include "src/storage/in_memory_audit_repo.h"
+#include "src/storage/in_memory_encounter_repo.h"
+#include "src/util/clock.h"
+#include "src/util/id_generator.h"
+
+// Counts heap bytes requested by the current thread while `t_countAllocations` is set.
+// Replacing the global operators affects the whole test binary but only records when enabled.
+namespace {
+
+thread_local bool t_countAllocations = false;
+thread_local std::size_t t_allocatedBytes = 0;
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+    if (t_countAllocations) {
+        t_allocatedBytes += size;
+    }
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace {
+
+class FixedClock final : public encounter_service::util::Clock {
+public:
+    TimePoint Now() const override {
+        return TimePoint{std::chrono::seconds{1700000000}};
+    }
+};
+
+class FixedIdGenerator final : public encounter_service::util::IdGenerator {
+public:
+    std::string NextId() override {
+        return "enc-1";
+    }
+};
+
+}  // namespace
+
+TEST_CASE("Create pipeline copies a large clinicalData payload exactly once") {
+    constexpr std::size_t kPayloadBytes = std::size_t{1} << 20;
+
+    encounter_service::storage::InMemoryEncounterRepository encounterRepo;
+    encounter_service::storage::InMemoryAuditRepository auditRepo;
+    FixedClock clock;
+    FixedIdGenerator idGenerator;
+    encounter_service::domain::DefaultEncounterService service(encounterRepo, auditRepo, clock, idGenerator);
+    // Warm up lazily allocated audit/interner state so it is not attributed to the payload.
+    REQUIRE(service.BatchGetEncounters({"warm-up"}, "clinician-a").index() == 0);
+
+    nlohmann::json body = nlohmann::json::object();
+    body["patientId"] = "patient-1";
+    body["providerId"] = "provider-1";
+    body["encounterType"] = "visit";
+    body["encounterDate"] = "2026-02-25T00:00:00Z";
+    body["clinicalData"] = nlohmann::json::object();
+    body["clinicalData"]["notes"] = std::string(kPayloadBytes, 'x');
+
+    // Parsing materializes clinicalData once; the count covers what the service does with it.
+    auto validation = encounter_service::http::ParseCreateEncounterRequest(
+        body.dump(), encounter_service::http::CreateRequestLimits{.maxBodyBytes = 2 * kPayloadBytes});
+    REQUIRE(validation.index() == 0);
+
+    t_allocatedBytes = 0;
+    t_countAllocations = true;
+    auto result = service.CreateEncounter(
+        std::get<encounter_service::domain::CreateEncounterInput>(std::move(validation)), "clinician-a");
+    t_countAllocations = false;
+
+    REQUIRE(result.index() == 0);
+    REQUIRE(std::get<encounter_service::domain::Encounter>(result).clinicalData["notes"].get<std::string>().size() ==
+            kPayloadBytes);
+    // One copy: the repository keeps the stored encounter and returns its own copy to the caller.
+    REQUIRE(t_allocatedBytes >= kPayloadBytes);
+    REQUIRE(t_allocatedBytes < 2 * kPayloadBytes);
+}
+
+TEST_CASE("EstimateEncounterBytes sizes clinicalData without allocating") {
+    encounter_service::domain::Encounter encounter;
+    encounter.encounterId = "enc-1";
+    encounter.clinicalData = nlohmann::json::object();
+    encounter.clinicalData["notes"] = std::string(4096, 'x');
+    encounter.clinicalData["vitals"] = nlohmann::json::object();
+    encounter.clinicalData["vitals"]["heartRate"] = 72;
+    encounter.clinicalData["tags"] = nlohmann::json::array();
+    encounter.clinicalData["tags"].push_back("follow-up");
+
+    t_allocatedBytes = 0;
+    t_countAllocations = true;
+    const auto bytes = encounter_service::storage::EstimateEncounterBytes(encounter);
+    t_countAllocations = false;
+
+    REQUIRE(t_allocatedBytes == 0);
+    // The walk tracks the serialized size closely for string-heavy payloads.
+    const auto serialized = encounter.clinicalData.dump().size();
+    REQUIRE(bytes >= sizeof(encounter_service::domain::Encounter) + serialized);
+    REQUIRE(bytes < sizeof(encounter_service::domain::Encounter) + serialized + 64);
+}
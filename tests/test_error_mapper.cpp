@@ -91,3 +91,51 @@ TEST_CASE("MapDomainError maps internal to 500") {
     REQUIRE(mapped.status == 500);
     REQUIRE(mapped.body.dump().find("\"code\":\"internal_error\"") != std::string::npos);
 }
+
+TEST_CASE("MapDomainError maps unavailable to 503") {
+    encounter_service::domain::DomainError error{
+        .code = encounter_service::domain::DomainErrorCode::Unavailable,
+        .message = "Service overloaded, retry later",
+        .details = std::nullopt
+    };
+
+    const auto mapped = encounter_service::http::MapDomainError(error);
+    REQUIRE(mapped.status == 503);
+    REQUIRE(mapped.body.dump().find("\"code\":\"service_unavailable\"") != std::string::npos);
+}
+
+TEST_CASE("MapDomainError maps rate limited to 429") {
+    encounter_service::domain::DomainError error{
+        .code = encounter_service::domain::DomainErrorCode::RateLimited,
+        .message = "Rate limit exceeded, retry later",
+        .details = std::nullopt
+    };
+
+    const auto mapped = encounter_service::http::MapDomainError(error);
+    REQUIRE(mapped.status == 429);
+    REQUIRE(mapped.body.dump().find("\"code\":\"rate_limited\"") != std::string::npos);
+}
+
+TEST_CASE("MapDomainError maps deadline exceeded to 504") {
+    encounter_service::domain::DomainError error{
+        .code = encounter_service::domain::DomainErrorCode::DeadlineExceeded,
+        .message = "Request deadline exceeded",
+        .details = std::nullopt
+    };
+
+    const auto mapped = encounter_service::http::MapDomainError(error);
+    REQUIRE(mapped.status == 504);
+    REQUIRE(mapped.body.dump().find("\"code\":\"deadline_exceeded\"") != std::string::npos);
+}
+
+TEST_CASE("MapDomainError maps payload too large to 413") {
+    encounter_service::domain::DomainError error{
+        .code = encounter_service::domain::DomainErrorCode::PayloadTooLarge,
+        .message = "Request body too large",
+        .details = std::nullopt
+    };
+
+    const auto mapped = encounter_service::http::MapDomainError(error);
+    REQUIRE(mapped.status == 413);
+    REQUIRE(mapped.body.dump().find("\"code\":\"payload_too_large\"") != std::string::npos);
+}
@@ -0,0 +1,26 @@
+#include "tests/catch_compat.h"
+
+#include <string>
+
+#include "src/http/etag.h"
+
+TEST_CASE("IfNoneMatchHits compares entity-tags weakly") {
+    using encounter_service::http::IfNoneMatchHits;
+    REQUIRE(IfNoneMatchHits("\"abc\"", "\"abc\""));
+    REQUIRE(IfNoneMatchHits("W/\"abc\"", "\"abc\""));
+    REQUIRE(IfNoneMatchHits("\"abc\"", "W/\"abc\""));
+    REQUIRE(IfNoneMatchHits("\"x\", W/\"y\" ,\"abc\"", "\"abc\""));
+    REQUIRE(IfNoneMatchHits("*", "\"abc\""));
+    REQUIRE(!IfNoneMatchHits("", "\"abc\""));
+    REQUIRE(!IfNoneMatchHits("\"abcd\"", "\"abc\""));
+    REQUIRE(!IfNoneMatchHits("abc", "\"abc\""));
+    REQUIRE(!IfNoneMatchHits("\"abc", "\"abc\""));
+    // A malformed entry ends matching; the remaining list is not trusted.
+    REQUIRE(!IfNoneMatchHits("bogus, \"abc\"", "\"abc\""));
+}
+
+TEST_CASE("EncodedVariantEtag and WeakGenerationEtag format entity-tags") {
+    REQUIRE(encounter_service::http::EncodedVariantEtag("\"0123abcd\"", "gzip") == "\"0123abcd-gzip\"");
+    REQUIRE(encounter_service::http::WeakGenerationEtag(0x1f, 0) == "W/\"1f-0\"");
+    REQUIRE(encounter_service::http::WeakGenerationEtag(10, 255) == "W/\"a-ff\"");
+}
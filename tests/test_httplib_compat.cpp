@@ -0,0 +1,513 @@
+#include "tests/catch_compat.h"
+
+#include "src/http/httplib_compat.h"
+
+// Only the fallback server (built when vendor/httplib.h is absent) has its own request parser.
+#if !__has_include("vendor/httplib.h")
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace {
+
+// Runs `server` on `port` until the fixture is destroyed.
+class RunningServer {
+public:
+    RunningServer(httplib::Server& server, int port)
+        : server_(server),
+          thread_([this, port]() { (void)server_.listen("127.0.0.1", port); }) {}
+
+    ~RunningServer() {
+        server_.stop();
+        thread_.join();
+    }
+
+private:
+    httplib::Server& server_;
+    std::thread thread_;
+};
+
+// Connects to the local `port`, retrying while the server starts; receives time out after 50ms.
+int Connect(int port) {
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+    ::inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    for (int attempt = 0; attempt < 100; ++attempt) {
+        const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        REQUIRE(fd >= 0);
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0) {
+            timeval timeout{.tv_sec = 0, .tv_usec = 50000};
+            ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+            return fd;
+        }
+        ::close(fd);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    REQUIRE(false);
+    return -1;
+}
+
+void SendAll(int fd, std::string_view bytes) {
+    REQUIRE(::send(fd, bytes.data(), bytes.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(bytes.size()));
+}
+
+// Counts the complete Content-Length framed responses at the front of `raw`.
+std::size_t CompleteResponses(const std::string& raw) {
+    std::size_t count = 0;
+    std::size_t offset = 0;
+    for (;;) {
+        const auto header_end = raw.find("\r\n\r\n", offset);
+        if (header_end == std::string::npos) {
+            return count;
+        }
+        std::size_t length = 0;
+        const auto field = raw.find("Content-Length: ", offset);
+        if (field != std::string::npos && field < header_end) {
+            length = std::stoul(raw.substr(field + 16));
+        }
+        if (raw.size() < header_end + 4 + length) {
+            return count;
+        }
+        offset = header_end + 4 + length;
+        ++count;
+    }
+}
+
+struct Received {
+    std::string raw;
+    // The server closed the connection.
+    bool closed{false};
+};
+
+// Reads until `responses` complete responses arrived (or, with 0, until the server closes), the
+// server closes the connection, or `timeout` passes.
+Received Receive(int fd, std::size_t responses, std::chrono::milliseconds timeout) {
+    Received received;
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    char buffer[4096];
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (responses > 0 && CompleteResponses(received.raw) >= responses) {
+            break;
+        }
+        const auto n = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (n > 0) {
+            received.raw.append(buffer, static_cast<std::size_t>(n));
+        } else if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+            received.closed = true;
+            break;
+        }
+    }
+    return received;
+}
+
+void RegisterTextRoutes(httplib::Server& server) {
+    server.Get("/slow", [](const httplib::Request&, httplib::Response& res) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        res.set_content("slow", "text/plain");
+    });
+    server.Get("/fast", [](const httplib::Request&, httplib::Response& res) {
+        res.set_content("fast", "text/plain");
+    });
+}
+
+}  // namespace
+
+TEST_CASE("parse_request views the receive buffer and leaves pipelined bytes unconsumed") {
+    const std::string first =
+        "GET /encounters?patientId=p-1&limit=5 HTTP/1.1\r\n"
+        "X-Api-Key:  key-1 \r\n"
+        "Content-Length: 4\r\n"
+        "\r\n"
+        "abcd";
+    const std::string raw = first + "GET /health HTTP/1.1\r\n\r\n";
+
+    httplib::Request req;
+    const auto consumed = httplib::detail::parse_request(raw, req);
+    REQUIRE(consumed.has_value());
+    REQUIRE(*consumed == first.size());
+    REQUIRE(req.method == "GET");
+    REQUIRE(req.version == "HTTP/1.1");
+    REQUIRE(req.path == "/encounters");
+    REQUIRE(req.body == "abcd");
+    REQUIRE(req.get_header_value("x-api-key") == "key-1");
+    REQUIRE(req.has_header("CONTENT-LENGTH"));
+    REQUIRE(req.get_param_value("patientId") == "p-1");
+    REQUIRE(req.get_param_value("limit") == "5");
+    REQUIRE(!req.has_param("PatientId"));
+    REQUIRE(req.path.data() >= raw.data());
+    REQUIRE(req.path.data() < raw.data() + raw.size());
+
+    httplib::Request next;
+    const auto rest = std::string_view(raw).substr(*consumed);
+    REQUIRE(httplib::detail::parse_request(rest, next) == rest.size());
+    REQUIRE(next.path == "/health");
+}
+
+TEST_CASE("parse_request waits for the full header block and body") {
+    httplib::Request req;
+    REQUIRE(!httplib::detail::parse_request("GET / HTTP/1.1\r\nHost: x\r\n", req).has_value());
+
+    httplib::Request partial;
+    REQUIRE(!httplib::detail::parse_request("POST /encounters HTTP/1.1\r\nContent-Length: 10\r\n\r\n{}", partial)
+                 .has_value());
+}
+
+TEST_CASE("frame_request resumes where the previous read stopped") {
+    const std::string raw =
+        "POST /encounters HTTP/1.1\r\n"
+        "content-length: 5\r\n"
+        "\r\n"
+        "hello"
+        "GET /next HTTP/1.1\r\n\r\n";
+    const auto request_size = raw.find("GET /next");
+
+    // Bytes arrive one at a time, as from a client trickling in its request.
+    httplib::detail::RequestFrame frame;
+    std::optional<std::size_t> framed;
+    std::size_t received = 0;
+    while (!framed && received < raw.size()) {
+        ++received;
+        framed = httplib::detail::frame_request(std::string_view(raw).substr(0, received), frame);
+        if (frame.body_start == 0) {
+            REQUIRE(frame.scanned == received);
+        }
+    }
+    REQUIRE(framed == request_size);
+    REQUIRE(received == request_size);
+    REQUIRE(frame.content_length == 5);
+
+    httplib::Request req;
+    httplib::detail::parse_framed_request(raw, frame, req);
+    REQUIRE(req.path == "/encounters");
+    REQUIRE(req.body == "hello");
+
+    httplib::Request bare;
+    REQUIRE(httplib::detail::parse_request("GET /bare HTTP/1.1\nHost: x\n\n", bare).has_value());
+    REQUIRE(bare.get_header_value("host") == "x");
+}
+
+TEST_CASE("frame_request refuses requests whose body length is ambiguous") {
+    const auto status_of = [](std::string_view raw) {
+        httplib::detail::RequestFrame frame;
+        const auto framed = httplib::detail::frame_request(raw, frame);
+        REQUIRE(framed == raw.find("\r\n\r\n") + 4);
+        return frame.error_status;
+    };
+
+    // Repeating the same length is allowed.
+    httplib::Request repeated;
+    REQUIRE(httplib::detail::parse_request("POST / HTTP/1.1\r\nContent-Length: 3\r\ncontent-length: 3\r\n\r\nabc",
+                                           repeated)
+                .has_value());
+    REQUIRE(repeated.body == "abc");
+
+    REQUIRE(status_of("POST / HTTP/1.1\r\nContent-Length: abc\r\n\r\n") == 400);
+    REQUIRE(status_of("POST / HTTP/1.1\r\nContent-Length: -1\r\n\r\n") == 400);
+    REQUIRE(status_of("POST / HTTP/1.1\r\nContent-Length:\r\n\r\n") == 400);
+    REQUIRE(status_of("POST / HTTP/1.1\r\nContent-Length: 3, 3\r\n\r\n") == 400);
+    REQUIRE(status_of("POST / HTTP/1.1\r\nContent-Length: 3\r\nContent-Length: 4\r\n\r\n") == 400);
+    REQUIRE(status_of("POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n") == 501);
+    REQUIRE(status_of("POST / HTTP/1.1\r\nContent-Length: 0\r\ntransfer-encoding: identity\r\n\r\n") == 501);
+
+    httplib::Request req;
+    REQUIRE(!httplib::detail::parse_request("POST / HTTP/1.1\r\nContent-Length: x\r\n\r\n", req).has_value());
+}
+
+TEST_CASE("Request fields built by hand own their bytes and spill past the inline capacity") {
+    httplib::Request req;
+    for (int i = 0; i < 40; ++i) {
+        req.headers.emplace("X-Header-" + std::to_string(i), "value-" + std::to_string(i));
+    }
+    REQUIRE(req.headers.size() == 40);
+    REQUIRE(req.get_header_value("x-header-0") == "value-0");
+    REQUIRE(req.get_header_value("X-HEADER-39") == "value-39");
+}
+
+TEST_CASE("Fallback server keeps serving others while a client trickles in its request") {
+    httplib::Server server;
+    RegisterTextRoutes(server);
+    RunningServer running(server, 18204);
+
+    // Half a request line that never completes; a blocking per-connection read would wait on it.
+    const int stalled = Connect(18204);
+    SendAll(stalled, "GET /fast HTTP/1.1\r\nHost: loc");
+
+    const auto started = std::chrono::steady_clock::now();
+    const int other = Connect(18204);
+    SendAll(other, "GET /fast HTTP/1.1\r\n\r\n");
+    const auto answered = Receive(other, 1, std::chrono::seconds{5});
+    const auto elapsed = std::chrono::steady_clock::now() - started;
+    ::close(other);
+
+    // The stalled client still gets its answer once the rest of the request arrives.
+    SendAll(stalled, "alhost\r\n\r\n");
+    const auto late = Receive(stalled, 1, std::chrono::seconds{5});
+    ::close(stalled);
+
+    REQUIRE(CompleteResponses(answered.raw) == 1);
+    REQUIRE(elapsed < std::chrono::seconds{1});
+    REQUIRE(CompleteResponses(late.raw) == 1);
+}
+
+TEST_CASE("Fallback server answers pipelined requests in request order") {
+    httplib::Server server;
+    RegisterTextRoutes(server);
+    RunningServer running(server, 18200);
+
+    const int fd = Connect(18200);
+    SendAll(fd, "GET /slow HTTP/1.1\r\n\r\nGET /fast HTTP/1.1\r\n\r\nGET /slow HTTP/1.1\r\n\r\n");
+    const auto received = Receive(fd, 3, std::chrono::seconds{5});
+    ::close(fd);
+
+    REQUIRE(CompleteResponses(received.raw) == 3);
+    REQUIRE(!received.closed);
+    const auto first = received.raw.find("\r\n\r\nslow");
+    const auto second = received.raw.find("\r\n\r\nfast");
+    REQUIRE(first != std::string::npos);
+    REQUIRE(second != std::string::npos);
+    REQUIRE(first < second);
+    REQUIRE(received.raw.find("\r\n\r\nslow", second) != std::string::npos);
+}
+
+TEST_CASE("Fallback server closes a connection after keep_alive_max_count requests") {
+    httplib::Server server;
+    RegisterTextRoutes(server);
+    server.set_keep_alive_max_count(2);
+    RunningServer running(server, 18201);
+
+    const int fd = Connect(18201);
+    SendAll(fd, "GET /fast HTTP/1.1\r\n\r\n");
+    const auto first = Receive(fd, 1, std::chrono::seconds{5});
+    SendAll(fd, "GET /fast HTTP/1.1\r\n\r\n");
+    const auto last = Receive(fd, 0, std::chrono::seconds{5});
+    ::close(fd);
+
+    REQUIRE(first.raw.find("Connection: keep-alive\r\n") != std::string::npos);
+    REQUIRE(first.raw.find("max=2") != std::string::npos);
+    REQUIRE(CompleteResponses(last.raw) == 1);
+    REQUIRE(last.raw.find("Connection: close\r\n") != std::string::npos);
+    REQUIRE(last.closed);
+}
+
+TEST_CASE("Fallback server closes keep-alive connections idle past the timeout") {
+    httplib::Server server;
+    RegisterTextRoutes(server);
+    server.set_keep_alive_timeout(1);
+    RunningServer running(server, 18202);
+
+    const int fd = Connect(18202);
+    SendAll(fd, "GET /fast HTTP/1.1\r\n\r\n");
+    const auto response = Receive(fd, 1, std::chrono::seconds{5});
+    const auto answered = std::chrono::steady_clock::now();
+    const auto idle = Receive(fd, 0, std::chrono::seconds{5});
+    const auto waited = std::chrono::steady_clock::now() - answered;
+    ::close(fd);
+
+    REQUIRE(CompleteResponses(response.raw) == 1);
+    REQUIRE(idle.closed);
+    REQUIRE(idle.raw.empty());
+    REQUIRE(waited >= std::chrono::milliseconds{900});
+}
+
+TEST_CASE("Fallback server answers 400 and closes on a malformed Content-Length") {
+    httplib::Server server;
+    RegisterTextRoutes(server);
+    RunningServer running(server, 18205);
+
+    // Were the length read as 0, the body would be served as a second, smuggled request.
+    const int fd = Connect(18205);
+    SendAll(fd, "GET /fast HTTP/1.1\r\nContent-Length: 2x\r\n\r\nGET /slow HTTP/1.1\r\n\r\n");
+    const auto received = Receive(fd, 0, std::chrono::seconds{5});
+    ::close(fd);
+
+    REQUIRE(received.raw.rfind("HTTP/1.1 400 Bad Request\r\n", 0) == 0);
+    REQUIRE(received.raw.find("Connection: close\r\n") != std::string::npos);
+    REQUIRE(CompleteResponses(received.raw) == 1);
+    REQUIRE(received.raw.find("slow") == std::string::npos);
+    REQUIRE(received.closed);
+}
+
+TEST_CASE("Fallback server answers 400 and closes on conflicting Content-Length headers") {
+    httplib::Server server;
+    RegisterTextRoutes(server);
+    RunningServer running(server, 18206);
+
+    const int fd = Connect(18206);
+    SendAll(fd,
+            "GET /fast HTTP/1.1\r\nContent-Length: 0\r\nContent-Length: 23\r\n\r\n"
+            "GET /slow HTTP/1.1\r\n\r\n");
+    const auto received = Receive(fd, 0, std::chrono::seconds{5});
+    ::close(fd);
+
+    REQUIRE(received.raw.rfind("HTTP/1.1 400 Bad Request\r\n", 0) == 0);
+    REQUIRE(CompleteResponses(received.raw) == 1);
+    REQUIRE(received.raw.find("slow") == std::string::npos);
+    REQUIRE(received.closed);
+}
+
+TEST_CASE("Fallback server answers 501 and closes on a request Transfer-Encoding") {
+    httplib::Server server;
+    RegisterTextRoutes(server);
+    RunningServer running(server, 18207);
+
+    const int fd = Connect(18207);
+    SendAll(fd,
+            "GET /fast HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n"
+            "17\r\nGET /slow HTTP/1.1\r\n\r\n\r\n0\r\n\r\n");
+    const auto received = Receive(fd, 0, std::chrono::seconds{5});
+    ::close(fd);
+
+    REQUIRE(received.raw.rfind("HTTP/1.1 501 Not Implemented\r\n", 0) == 0);
+    REQUIRE(received.raw.find("Connection: close\r\n") != std::string::npos);
+    REQUIRE(CompleteResponses(received.raw) == 1);
+    REQUIRE(received.raw.find("slow") == std::string::npos);
+    REQUIRE(received.closed);
+}
+
+TEST_CASE("Fallback server answers 413 from Content-Length before the body arrives") {
+    httplib::Server server;
+    RegisterTextRoutes(server);
+    server.set_payload_max_length(16);
+    RunningServer running(server, 18208);
+
+    // Only the headers are sent; the server must not wait for a gigabyte it will refuse anyway.
+    const int fd = Connect(18208);
+    SendAll(fd, "POST /fast HTTP/1.1\r\nContent-Length: 1000000000\r\n\r\n");
+    const auto refused = Receive(fd, 0, std::chrono::seconds{5});
+    ::close(fd);
+
+    // Bodies within the limit are still served.
+    const int small = Connect(18208);
+    SendAll(small, "GET /fast HTTP/1.1\r\nContent-Length: 16\r\n\r\n0123456789abcdef");
+    const auto served = Receive(small, 1, std::chrono::seconds{5});
+    ::close(small);
+
+    REQUIRE(refused.raw.rfind("HTTP/1.1 413 Payload Too Large\r\n", 0) == 0);
+    REQUIRE(refused.raw.find("Connection: close\r\n") != std::string::npos);
+    REQUIRE(refused.closed);
+    REQUIRE(served.raw.rfind("HTTP/1.1 200 OK\r\n", 0) == 0);
+}
+
+TEST_CASE("Fallback server honors Connection: close and HTTP/1.0 keep-alive rules") {
+    httplib::Server server;
+    RegisterTextRoutes(server);
+    RunningServer running(server, 18203);
+
+    const int explicit_close = Connect(18203);
+    SendAll(explicit_close, "GET /fast HTTP/1.1\r\nConnection: close\r\n\r\n");
+    const auto closed = Receive(explicit_close, 0, std::chrono::seconds{5});
+    ::close(explicit_close);
+
+    // HTTP/1.0 connections close unless the client asks to keep them.
+    const int legacy = Connect(18203);
+    SendAll(legacy, "GET /fast HTTP/1.0\r\n\r\n");
+    const auto legacy_closed = Receive(legacy, 0, std::chrono::seconds{5});
+    ::close(legacy);
+
+    const int legacy_keep = Connect(18203);
+    SendAll(legacy_keep, "GET /fast HTTP/1.0\r\nConnection: keep-alive\r\n\r\n");
+    const auto kept = Receive(legacy_keep, 1, std::chrono::seconds{5});
+    SendAll(legacy_keep, "GET /fast HTTP/1.0\r\nConnection: keep-alive\r\n\r\n");
+    const auto reused = Receive(legacy_keep, 1, std::chrono::seconds{5});
+    ::close(legacy_keep);
+
+    REQUIRE(CompleteResponses(closed.raw) == 1);
+    REQUIRE(closed.raw.find("Connection: close\r\n") != std::string::npos);
+    REQUIRE(closed.closed);
+    REQUIRE(CompleteResponses(legacy_closed.raw) == 1);
+    REQUIRE(legacy_closed.raw.find("Connection: close\r\n") != std::string::npos);
+    REQUIRE(legacy_closed.closed);
+    REQUIRE(kept.raw.find("Connection: keep-alive\r\n") != std::string::npos);
+    REQUIRE(!kept.closed);
+    REQUIRE(CompleteResponses(reused.raw) == 1);
+}
+
+TEST_CASE("Fallback server reports a closed client, but not one that half-closed after pipelining") {
+    httplib::Server server;
+    std::atomic<int> closed_seen{-1};
+    server.Get("/watch", [&closed_seen](const httplib::Request& req, httplib::Response& res) {
+        bool closed = false;
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
+        while (!closed && std::chrono::steady_clock::now() < deadline) {
+            closed = req.is_connection_closed();
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        closed_seen.store(closed ? 1 : 0);
+        res.set_content("watched", "text/plain");
+    });
+    RegisterTextRoutes(server);
+    RunningServer running(server, 18209);
+
+    const int gone = Connect(18209);
+    SendAll(gone, "GET /watch HTTP/1.1\r\n\r\n");
+    ::close(gone);
+    for (int i = 0; i < 200 && closed_seen.load() < 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    REQUIRE(closed_seen.load() == 1);
+
+    closed_seen.store(-1);
+    const int pipelining = Connect(18209);
+    SendAll(pipelining, "GET /watch HTTP/1.1\r\n\r\nGET /fast HTTP/1.1\r\nConnection: close\r\n\r\n");
+    ::shutdown(pipelining, SHUT_WR);
+    const auto received = Receive(pipelining, 2, std::chrono::seconds{5});
+    ::close(pipelining);
+    REQUIRE(closed_seen.load() == 0);
+    REQUIRE(CompleteResponses(received.raw) == 2);
+}
+
+TEST_CASE("Fallback server sends a chunked body while its provider is still producing it") {
+    httplib::Server server;
+    std::atomic<bool> released{false};
+    server.Get("/stream", [&released](const httplib::Request&, httplib::Response& res) {
+        res.set_chunked_content_provider("text/plain", [&released](std::size_t offset, httplib::DataSink& sink) {
+            if (offset == 0) {
+                const std::string first(64 * 1024, 'a');
+                return sink.write(first.data(), first.size());
+            }
+            // Waits for the client to see the first part (up to 5s, past its 2s of looking), which a
+            // buffered body would not send until this returns.
+            for (int i = 0; i < 500 && !released.load(); ++i) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            sink.write("tail", 4);
+            sink.done();
+            return true;
+        });
+    });
+    RunningServer running(server, 18210);
+
+    const int fd = Connect(18210);
+    SendAll(fd, "GET /stream HTTP/1.1\r\nConnection: close\r\n\r\n");
+    std::string early;
+    char buffer[4096];
+    for (int i = 0; i < 40 && early.find("aaaa") == std::string::npos; ++i) {
+        const auto n = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (n > 0) {
+            early.append(buffer, static_cast<std::size_t>(n));
+        }
+    }
+    const bool streamed = !released.load() && early.find("aaaa") != std::string::npos;
+    released.store(true);
+    const auto rest = Receive(fd, 0, std::chrono::seconds{5});
+    ::close(fd);
+
+    REQUIRE(streamed);
+    REQUIRE(early.find("Transfer-Encoding: chunked\r\n") != std::string::npos);
+    REQUIRE(rest.closed);
+    REQUIRE((early + rest.raw).find("\r\ntail\r\n0\r\n\r\n") != std::string::npos);
+}
+
+#endif
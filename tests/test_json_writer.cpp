@@ -0,0 +1,134 @@
+#include "tests/catch_compat.h"
+
+#include <chrono>
+#include <string>
+
+#include "src/http/json_writer.h"
+#include "src/util/json_writer.h"
+#include "src/util/time.h"
+
+namespace {
+
+using encounter_service::domain::AuditAction;
+using encounter_service::domain::AuditEntry;
+using encounter_service::domain::Encounter;
+using encounter_service::util::FormatIso8601Utc;
+
+// The DOM-based serialization the writer replaces; its dump() is the compatibility reference.
+nlohmann::json EncounterDom(const Encounter& encounter) {
+    nlohmann::json json = nlohmann::json::object();
+    json["encounterId"] = encounter.encounterId;
+    json["patientId"] = encounter.patientId;
+    json["providerId"] = encounter.providerId;
+    json["encounterDate"] = FormatIso8601Utc(encounter.encounterDate);
+    json["encounterType"] = encounter.encounterType;
+    json["clinicalData"] = encounter.clinicalData;
+
+    nlohmann::json metadata = nlohmann::json::object();
+    metadata["createdAt"] = FormatIso8601Utc(encounter.metadata.createdAt);
+    metadata["updatedAt"] = FormatIso8601Utc(encounter.metadata.updatedAt);
+    metadata["createdBy"] = encounter.metadata.createdBy;
+    json["metadata"] = metadata;
+    return json;
+}
+
+nlohmann::json AuditEntryDom(const AuditEntry& entry) {
+    nlohmann::json json = nlohmann::json::object();
+    json["timestamp"] = FormatIso8601Utc(entry.timestamp);
+    json["actor"] = entry.actor;
+    json["encounterId"] = entry.encounterId;
+    json["action"] = encounter_service::domain::AuditActionName(entry.action);
+    return json;
+}
+
+Encounter MakeEncounter(std::string id, std::string patientId) {
+    using namespace std::chrono;
+    Encounter encounter;
+    encounter.encounterId = std::move(id);
+    encounter.patientId = std::move(patientId);
+    encounter.providerId = "provider-1";
+    encounter.encounterDate = system_clock::time_point{seconds{1772064000}};
+    encounter.encounterType = "visit";
+    encounter.clinicalData = nlohmann::json::object();
+    encounter.clinicalData["notes"] = "stable";
+    encounter.clinicalData["heartRate"] = 72;
+    nlohmann::json vitals = nlohmann::json::object();
+    vitals["bp"] = "120/80";
+    encounter.clinicalData["vitals"] = vitals;
+    encounter.metadata.createdAt = system_clock::time_point{seconds{1772064123}};
+    encounter.metadata.updatedAt = system_clock::time_point{seconds{1772067723}};
+    encounter.metadata.createdBy = "api-key-actor";
+    return encounter;
+}
+
+std::string WriteEncounter(const Encounter& encounter) {
+    std::string out;
+    encounter_service::http::AppendEncounterJson(out, encounter);
+    return out;
+}
+
+std::string WriteString(const std::string& value) {
+    std::string out;
+    encounter_service::util::AppendJsonString(out, value);
+    return out;
+}
+
+}  // namespace
+
+TEST_CASE("AppendEncounterJson matches the nlohmann DOM dump byte for byte") {
+    const auto encounter = MakeEncounter("enc-1", "patient-1");
+    const auto written = WriteEncounter(encounter);
+    REQUIRE(written == EncounterDom(encounter).dump());
+    REQUIRE(written.rfind("{\"clinicalData\":{", 0) == 0);
+
+    Encounter empty;
+    empty.clinicalData = nlohmann::json::object();
+    REQUIRE(WriteEncounter(empty) == EncounterDom(empty).dump());
+}
+
+TEST_CASE("AppendEncounterJson escapes quotes and backslashes like nlohmann") {
+    const auto encounter = MakeEncounter("enc-\"quoted\"", "patient\\with\\slashes");
+    REQUIRE(WriteEncounter(encounter) == EncounterDom(encounter).dump());
+}
+
+TEST_CASE("AppendJsonString matches nlohmann for control and non-ASCII characters") {
+    REQUIRE(WriteString("") == "\"\"");
+    REQUIRE(WriteString("plain") == "\"plain\"");
+    REQUIRE(WriteString("caf\xc3\xa9") == nlohmann::json(std::string("caf\xc3\xa9")).dump());
+#if __has_include("vendor/json.hpp")
+    const std::string controls = std::string("a\nb\tc\rd\be\ff") + '\x01' + '\x1f' + '\x7f' + std::string(1, '\0');
+    REQUIRE(WriteString(controls) == nlohmann::json(controls).dump());
+    REQUIRE(WriteString("\x01") == "\"\\u0001\"");
+#endif
+}
+
+TEST_CASE("AppendJsonEscaped matches AppendJsonString without the quotes") {
+    for (const std::string value : {"plain", "quote\"back\\slash\nline\x01", "caf\xc3\xa9"}) {
+        std::string escaped;
+        encounter_service::util::AppendJsonEscaped(escaped, value);
+        REQUIRE(WriteString(value) == "\"" + escaped + "\"");
+    }
+}
+
+TEST_CASE("AppendJsonString appends to existing buffer contents") {
+    std::string out = "[";
+    encounter_service::util::AppendJsonString(out, "a");
+    out += ',';
+    encounter_service::util::AppendJsonString(out, "caf\xc3\xa9");
+    REQUIRE(out == "[\"a\",\"caf\xc3\xa9\"");
+}
+
+TEST_CASE("AppendAuditEntryJson matches the nlohmann DOM dump byte for byte") {
+    using namespace std::chrono;
+    const AuditEntry entry{
+        .timestamp = system_clock::time_point{seconds{1700000000}},
+        .actor = "actor-\"1\"",
+        .action = AuditAction::LIST_ENCOUNTERS,
+        .encounterId = "enc-1"
+    };
+    std::string out;
+    encounter_service::http::AppendAuditEntryJson(out, entry);
+    REQUIRE(out == AuditEntryDom(entry).dump());
+    REQUIRE(out == "{\"action\":\"LIST_ENCOUNTERS\",\"actor\":\"actor-\\\"1\\\"\",\"encounterId\":\"enc-1\","
+                   "\"timestamp\":\"2023-11-14T22:13:20Z\"}");
+}
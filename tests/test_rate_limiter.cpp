@@ -0,0 +1,110 @@
+#include "tests/catch_compat.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "src/http/rate_limiter.h"
+
+using encounter_service::http::RateLimiter;
+using encounter_service::http::RateLimitOptions;
+using encounter_service::http::RouteClass;
+
+namespace {
+
+RateLimitOptions ListLimit(double ratePerSecond, double burst) {
+    RateLimitOptions options{};
+    options.limits[static_cast<std::size_t>(RouteClass::List)] = {.ratePerSecond = ratePerSecond, .burst = burst};
+    return options;
+}
+
+}  // namespace
+
+TEST_CASE("RateLimiter allows a burst, then refills at the configured rate") {
+    RateLimiter limiter(ListLimit(10.0, 3.0));
+    const auto start = std::chrono::steady_clock::time_point{std::chrono::hours{1}};
+
+    REQUIRE(limiter.AllowAt("actor-a", RouteClass::List, start).allowed);
+    REQUIRE(limiter.AllowAt("actor-a", RouteClass::List, start).allowed);
+    REQUIRE(limiter.AllowAt("actor-a", RouteClass::List, start).allowed);
+    const auto rejected = limiter.AllowAt("actor-a", RouteClass::List, start);
+    REQUIRE(!rejected.allowed);
+    REQUIRE(rejected.retryAfter == std::chrono::milliseconds{100});
+
+    // One token per 100ms at 10/s.
+    REQUIRE(limiter.AllowAt("actor-a", RouteClass::List, start + std::chrono::milliseconds{100}).allowed);
+    REQUIRE(!limiter.AllowAt("actor-a", RouteClass::List, start + std::chrono::milliseconds{150}).allowed);
+
+    // After a long idle period the bucket is full again, but no fuller.
+    const auto later = start + std::chrono::seconds{10};
+    for (int i = 0; i < 3; ++i) {
+        REQUIRE(limiter.AllowAt("actor-a", RouteClass::List, later).allowed);
+    }
+    REQUIRE(!limiter.AllowAt("actor-a", RouteClass::List, later).allowed);
+}
+
+TEST_CASE("RateLimiter keeps budgets per actor and per route class") {
+    RateLimiter limiter(ListLimit(1.0, 1.0));
+    const auto now = std::chrono::steady_clock::time_point{std::chrono::hours{1}};
+
+    REQUIRE(limiter.AllowAt("actor-a", RouteClass::List, now).allowed);
+    REQUIRE(!limiter.AllowAt("actor-a", RouteClass::List, now).allowed);
+    REQUIRE(limiter.AllowAt("actor-b", RouteClass::List, now).allowed);
+    // Point reads have their own (default) budget.
+    REQUIRE(limiter.AllowAt("actor-a", RouteClass::Read, now).allowed);
+}
+
+TEST_CASE("RateLimiter never over-admits under concurrent use") {
+    RateLimiter limiter(ListLimit(0.001, 100.0));
+    std::atomic<int> allowed{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < 100; ++i) {
+                if (limiter.Allow("shared-actor", RouteClass::List).allowed) {
+                    allowed.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    REQUIRE(allowed.load() == 100);
+}
+
+TEST_CASE("RateLimiter treats a non-positive rate as unlimited") {
+    RateLimiter limiter(ListLimit(0.0, 1.0));
+    for (int i = 0; i < 1000; ++i) {
+        REQUIRE(limiter.Allow("actor-a", RouteClass::List).allowed);
+    }
+}
+
+TEST_CASE("RateLimiter reclaims buckets of keys that went idle") {
+    RateLimitOptions options = ListLimit(10.0, 2.0);
+    options.shardCount = 1;
+    RateLimiter limiter(options);
+    const auto start = std::chrono::steady_clock::time_point{std::chrono::hours{1}};
+
+    // A still-limited key survives the sweeps its neighbors trigger.
+    REQUIRE(limiter.AllowAt("busy", RouteClass::List, start).allowed);
+    REQUIRE(limiter.AllowAt("busy", RouteClass::List, start).allowed);
+    for (int i = 0; i < 1000; ++i) {
+        REQUIRE(limiter.AllowAt("once-" + std::to_string(i), RouteClass::List, start).allowed);
+    }
+    REQUIRE(limiter.trackedActors() == 1001);
+    REQUIRE(!limiter.AllowAt("busy", RouteClass::List, start).allowed);
+
+    // Once their buckets have refilled, new keys push the one-off keys out.
+    const auto later = start + std::chrono::seconds{10};
+    for (int i = 0; i < 100; ++i) {
+        REQUIRE(limiter.AllowAt("later-" + std::to_string(i), RouteClass::List, later).allowed);
+    }
+    REQUIRE(limiter.trackedActors() < 200);
+    // A reclaimed key starts over with exactly the burst it had earned back.
+    REQUIRE(limiter.AllowAt("once-0", RouteClass::List, later).allowed);
+    REQUIRE(limiter.AllowAt("once-0", RouteClass::List, later).allowed);
+    REQUIRE(!limiter.AllowAt("once-0", RouteClass::List, later).allowed);
+}
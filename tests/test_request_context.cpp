@@ -0,0 +1,59 @@
+#include "tests/catch_compat.h"
+
+#include <chrono>
+#include <optional>
+
+#include "src/util/request_context.h"
+
+using encounter_service::util::CancellationCheckpoint;
+using encounter_service::util::RequestCancelled;
+using encounter_service::util::RequestContext;
+
+TEST_CASE("RequestContext reports deadline expiry and shared cancellation") {
+    const RequestContext background;
+    REQUIRE(!background.IsDone());
+    background.Cancel();
+    REQUIRE(!background.IsDone());
+
+    const RequestContext expired(RequestContext::Clock::now() - std::chrono::milliseconds{1});
+    REQUIRE(expired.DoneReason() == RequestCancelled::Reason::DeadlineExceeded);
+
+    const RequestContext live(RequestContext::Clock::now() + std::chrono::hours{1});
+    const RequestContext copy = live;
+    REQUIRE(!copy.IsDone());
+    live.Cancel();
+    REQUIRE(copy.DoneReason() == RequestCancelled::Reason::Cancelled);
+}
+
+TEST_CASE("RequestContext treats a client disconnect as a sticky cancellation") {
+    int probes = 0;
+    bool disconnected = false;
+    const RequestContext context(std::nullopt, [&]() {
+        ++probes;
+        return disconnected;
+    });
+
+    REQUIRE(!context.IsDone());
+    disconnected = true;
+    REQUIRE(context.DoneReason() == RequestCancelled::Reason::Cancelled);
+    disconnected = false;
+    REQUIRE(context.IsDone());
+    REQUIRE(probes == 2);
+}
+
+TEST_CASE("CancellationCheckpoint only checks the context every interval ticks") {
+    const RequestContext cancelled(std::nullopt);
+    cancelled.Cancel();
+    CancellationCheckpoint checkpoint(cancelled, 4);
+
+    checkpoint.Tick();
+    checkpoint.Tick();
+    checkpoint.Tick();
+    bool threw = false;
+    try {
+        checkpoint.Tick();
+    } catch (const RequestCancelled& error) {
+        threw = error.reason() == RequestCancelled::Reason::Cancelled;
+    }
+    REQUIRE(threw);
+}
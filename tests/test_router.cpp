@@ -0,0 +1,109 @@
+#include "tests/catch_compat.h"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "src/http/router.h"
+
+namespace {
+
+httplib::Request MakeRequest(const char* method, const char* path) {
+    httplib::Request req;
+    req.method = method;
+    req.path = path;
+    return req;
+}
+
+// Returns the name of the route that handled the request, or "" when none matched.
+std::string Route(const encounter_service::http::Router& router, const char* method, const char* path) {
+    const auto req = MakeRequest(method, path);
+    httplib::Response res;
+    if (!router.Dispatch(req, res)) {
+        return "";
+    }
+    return res.body;
+}
+
+}  // namespace
+
+TEST_CASE("Router dispatches literal and typed parameter routes by method") {
+    encounter_service::http::Router router;
+    router.Get("/encounters", [](const httplib::Request&, httplib::Response& res) { res.body = "list"; });
+    router.Post("/encounters", [](const httplib::Request&, httplib::Response& res) { res.body = "create"; });
+    router.Post("/encounters:batchGet", [](const httplib::Request&, httplib::Response& res) { res.body = "batch"; });
+    router.Get("/encounters/{encounterId:slug}",
+               [](const httplib::Request&, httplib::Response& res, const encounter_service::http::PathParams& params) {
+                   res.body = "get:" + std::string(params.Get("encounterId"));
+               });
+    router.Get("/audit/encounters/rollups", [](const httplib::Request&, httplib::Response& res) {
+        res.body = "rollups";
+    });
+    router.Get("/pages/{page:int}/{name}",
+               [](const httplib::Request&, httplib::Response& res, const encounter_service::http::PathParams& params) {
+                   res.body = std::string(params.Get("page")) + "/" + std::string(params.Get("name"));
+               });
+
+    REQUIRE(Route(router, "GET", "/encounters") == "list");
+    REQUIRE(Route(router, "POST", "/encounters") == "create");
+    REQUIRE(Route(router, "POST", "/encounters:batchGet") == "batch");
+    REQUIRE(Route(router, "GET", "/encounters/enc_1-A") == "get:enc_1-A");
+    REQUIRE(Route(router, "GET", "/audit/encounters/rollups") == "rollups");
+    REQUIRE(Route(router, "GET", "/pages/12/a.b") == "12/a.b");
+
+    REQUIRE(Route(router, "GET", "/encounters/bad.id").empty());
+    REQUIRE(Route(router, "GET", "/encounters/").empty());
+    REQUIRE(Route(router, "GET", "/encounters/a/b").empty());
+    REQUIRE(Route(router, "GET", "/pages/x/y").empty());
+    REQUIRE(Route(router, "GET", "/audit/encounters").empty());
+    REQUIRE(Route(router, "POST", "/encounters/enc-1").empty());
+    REQUIRE(Route(router, "GET", "encounters").empty());
+}
+
+TEST_CASE("Router answers HEAD with the GET route and reports segment counts per method") {
+    encounter_service::http::Router router;
+    router.Get("/encounters", [](const httplib::Request&, httplib::Response& res) { res.body = "list"; });
+    router.Post("/encounters", [](const httplib::Request&, httplib::Response& res) { res.body = "create"; });
+    router.Post("/encounters:batchGet", [](const httplib::Request&, httplib::Response& res) { res.body = "batch"; });
+    router.Post("/audit/{kind}/notes", [](const httplib::Request&, httplib::Response&) {});
+
+    REQUIRE(Route(router, "HEAD", "/encounters") == "list");
+    REQUIRE(Route(router, "HEAD", "/encounters:batchGet").empty());
+
+    REQUIRE((router.SegmentCounts("POST") == std::vector<std::size_t>{1, 3}));
+    REQUIRE((router.SegmentCounts("GET") == std::vector<std::size_t>{1}));
+    REQUIRE(router.SegmentCounts("PUT").empty());
+}
+
+TEST_CASE("Router prefers literal segments and backtracks into parameters") {
+    encounter_service::http::Router router;
+    router.Get("/audit/{kind}/rollups", [](const httplib::Request&, httplib::Response& res) { res.body = "param"; });
+    router.Get("/audit/encounters/history", [](const httplib::Request&, httplib::Response& res) {
+        res.body = "literal";
+    });
+
+    REQUIRE(Route(router, "GET", "/audit/encounters/history") == "literal");
+    // The literal `encounters` branch has no `rollups` child, so matching falls back to `{kind}`.
+    REQUIRE(Route(router, "GET", "/audit/encounters/rollups") == "param");
+}
+
+TEST_CASE("Router rejects malformed and conflicting patterns") {
+    encounter_service::http::Router router;
+    router.Get("/encounters/{id:slug}", [](const httplib::Request&, httplib::Response&) {});
+
+    const auto throws = [&router](const char* method, const char* pattern) {
+        try {
+            router.Add(method, pattern, [](const httplib::Request&, httplib::Response&,
+                                           const encounter_service::http::PathParams&) {});
+        } catch (const std::invalid_argument&) {
+            return true;
+        }
+        return false;
+    };
+    REQUIRE(throws("GET", "/encounters/{id:slug}"));
+    REQUIRE(throws("GET", "/encounters/{encounterId:slug}/notes"));
+    REQUIRE(throws("GET", "/encounters/{id:int}/notes"));
+    REQUIRE(throws("GET", "/things/{id:uuid}"));
+    REQUIRE(throws("GET", "no-leading-slash"));
+    REQUIRE(!throws("POST", "/encounters/{id:slug}"));
+}
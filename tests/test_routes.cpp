@@ -1,8 +1,12 @@
 #include "tests/catch_compat.h"
 
+#include <cctype>
 #include <chrono>
+#include <cstdint>
 #include <cstring>
+#include <filesystem>
 #include <map>
+#include <memory>
 #include <optional>
 #include <sstream>
 #include <string>
@@ -14,6 +18,7 @@
 #include <netinet/in.h>
 #include <sys/socket.h>
 #include <unistd.h>
+#include <zlib.h>
 
 #include "src/domain/encounter_service.h"
 #include "src/http/routes.h"
@@ -39,7 +44,7 @@ public:
 class FakeEncounterService final : public encounter_service::domain::EncounterService {
 public:
     encounter_service::domain::ServiceResult<encounter_service::domain::Encounter>
-    CreateEncounter(const encounter_service::domain::CreateEncounterInput& input,
+    CreateEncounter(encounter_service::domain::CreateEncounterInput input,
                     const std::string& actor) override {
         create_called = true;
         last_create_actor = actor;
@@ -55,11 +60,27 @@ public:
         return get_result;
     }
 
-    encounter_service::domain::ServiceResult<std::vector<encounter_service::domain::Encounter>> QueryEncounters(
-        const encounter_service::storage::EncounterQueryFilters& filters) override {
+    encounter_service::domain::ServiceResult<std::vector<std::optional<encounter_service::domain::Encounter>>>
+    BatchGetEncounters(const std::vector<std::string>& ids, const std::string& actor) override {
+        batch_get_called = true;
+        last_batch_get_ids = ids;
+        last_batch_get_actor = actor;
+        return batch_get_result;
+    }
+
+    encounter_service::domain::ServiceResult<encounter_service::storage::SharedEncounters> QueryEncounters(
+        const encounter_service::storage::EncounterQueryFilters& filters,
+        const std::string& actor,
+        const encounter_service::util::RequestContext& context) override {
         query_called = true;
         last_query_filters = filters;
-        return query_result;
+        last_query_actor = actor;
+        last_query_deadline = context.deadline();
+        if (std::holds_alternative<encounter_service::domain::DomainError>(query_result)) {
+            return std::get<encounter_service::domain::DomainError>(query_result);
+        }
+        return std::make_shared<const std::vector<encounter_service::domain::Encounter>>(
+            std::get<std::vector<encounter_service::domain::Encounter>>(query_result));
     }
 
     encounter_service::domain::ServiceResult<std::vector<encounter_service::domain::AuditEntry>> QueryAudit(
@@ -69,17 +90,36 @@ public:
         return audit_result;
     }
 
+    encounter_service::domain::ServiceResult<std::vector<encounter_service::domain::AuditRollup>> QueryAuditRollups(
+        const encounter_service::storage::AuditDateRange& range) override {
+        rollup_query_called = true;
+        last_rollup_range = range;
+        return rollup_result;
+    }
+
+    std::uint64_t EncounterWriteGeneration() const override {
+        return write_generation;
+    }
+
     bool create_called{false};
     bool get_called{false};
+    bool batch_get_called{false};
     bool query_called{false};
     bool audit_query_called{false};
+    bool rollup_query_called{false};
 
     std::string last_create_actor;
     std::optional<encounter_service::domain::CreateEncounterInput> last_create_input;
     std::string last_get_id;
     std::string last_get_actor;
+    std::vector<std::string> last_batch_get_ids;
+    std::string last_batch_get_actor;
     encounter_service::storage::EncounterQueryFilters last_query_filters{};
+    std::string last_query_actor;
+    std::optional<std::chrono::steady_clock::time_point> last_query_deadline;
     encounter_service::storage::AuditDateRange last_audit_range{};
+    encounter_service::storage::AuditDateRange last_rollup_range{};
+    std::uint64_t write_generation{0};
 
     encounter_service::domain::ServiceResult<encounter_service::domain::Encounter> create_result{
         encounter_service::domain::Encounter{}
@@ -87,19 +127,33 @@ public:
     encounter_service::domain::ServiceResult<encounter_service::domain::Encounter> get_result{
         encounter_service::domain::Encounter{}
     };
+    encounter_service::domain::ServiceResult<std::vector<std::optional<encounter_service::domain::Encounter>>>
+        batch_get_result{std::vector<std::optional<encounter_service::domain::Encounter>>{}};
     encounter_service::domain::ServiceResult<std::vector<encounter_service::domain::Encounter>> query_result{
         std::vector<encounter_service::domain::Encounter>{}
     };
     encounter_service::domain::ServiceResult<std::vector<encounter_service::domain::AuditEntry>> audit_result{
         std::vector<encounter_service::domain::AuditEntry>{}
     };
+    encounter_service::domain::ServiceResult<std::vector<encounter_service::domain::AuditRollup>> rollup_result{
+        std::vector<encounter_service::domain::AuditRollup>{}
+    };
 };
 
 struct RawHttpResponse {
     int status{0};
     std::string body;
+    // Response headers keyed by lower-cased name.
+    std::map<std::string, std::string> headers;
 };
 
+std::string LowerAscii(std::string value) {
+    for (char& ch : value) {
+        ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+    }
+    return value;
+}
+
 struct TestHttpRequest {
     std::string method;
     std::string path;
@@ -122,6 +176,57 @@ std::string BuildRawHttpRequest(const TestHttpRequest& request) {
     return out.str();
 }
 
+#if !__has_include("vendor/httplib.h")
+// Joins the data of a `Transfer-Encoding: chunked` body; a truncated body keeps what arrived.
+std::string DecodeChunkedBody(const std::string& chunked) {
+    std::string body;
+    std::size_t pos = 0;
+    while (pos < chunked.size()) {
+        const auto line_end = chunked.find("\r\n", pos);
+        if (line_end == std::string::npos) {
+            break;
+        }
+        const auto size = std::stoul(chunked.substr(pos, line_end - pos), nullptr, 16);
+        if (size == 0) {
+            break;
+        }
+        body.append(chunked, line_end + 2, size);
+        pos = line_end + 2 + size + 2;
+    }
+    return body;
+}
+
+// Whether `raw` holds a whole response. The client then closes first, without half-closing earlier
+// (which the server takes for a client that went away), and the server's port is not left in
+// TIME_WAIT for the next test binary to trip over.
+bool ResponseComplete(const std::string& raw, bool head) {
+    const auto header_end = raw.find("\r\n\r\n");
+    if (header_end == std::string::npos) {
+        return false;
+    }
+    const auto headers = LowerAscii(raw.substr(0, header_end));
+    if (head || headers.rfind("http/1.1 304", 0) == 0) {
+        return true;
+    }
+    const auto body = header_end + 4;
+    if (headers.find("transfer-encoding: chunked") != std::string::npos) {
+        for (auto pos = body;;) {
+            const auto line_end = raw.find("\r\n", pos);
+            if (line_end == std::string::npos) {
+                return false;
+            }
+            const auto size = std::stoul(raw.substr(pos, line_end - pos), nullptr, 16);
+            if (size == 0) {
+                return raw.size() >= line_end + 4;
+            }
+            pos = line_end + 2 + size + 2;
+        }
+    }
+    const auto field = headers.find("content-length: ");
+    return field != std::string::npos && raw.size() >= body + std::stoul(headers.substr(field + 16));
+}
+#endif
+
 RawHttpResponse SendHttpRequest(int port, const std::string& raw) {
 #if __has_include("vendor/httplib.h")
     std::istringstream stream(raw);
@@ -166,11 +271,15 @@ RawHttpResponse SendHttpRequest(int port, const std::string& raw) {
     client.set_connection_timeout(1, 0);
     client.set_read_timeout(1, 0);
     client.set_write_timeout(1, 0);
+    // Tests inspect encoded bodies themselves.
+    client.set_decompress(false);
 
     for (int attempt = 0; attempt < 20; ++attempt) {
         decltype(client.Get(path.c_str(), headers)) res;
         if (method == "GET") {
             res = client.Get(path.c_str(), headers);
+        } else if (method == "HEAD") {
+            res = client.Head(path.c_str(), headers);
         } else if (method == "POST") {
             auto content_type = std::string("application/json");
             if (const auto it = headers.find("Content-Type"); it != headers.end()) {
@@ -182,10 +291,15 @@ RawHttpResponse SendHttpRequest(int port, const std::string& raw) {
         }
 
         if (res) {
-            return RawHttpResponse{
+            RawHttpResponse out{
                 .status = res->status,
-                .body = res->body
+                .body = res->body,
+                .headers = {}
             };
+            for (const auto& [key, value] : res->headers) {
+                out.headers[LowerAscii(key)] = value;
+            }
+            return out;
         }
         std::this_thread::sleep_for(std::chrono::milliseconds(10));
     }
@@ -213,11 +327,11 @@ RawHttpResponse SendHttpRequest(int port, const std::string& raw) {
         }
         REQUIRE(connected);
         REQUIRE(::send(sock, raw.data(), raw.size(), 0) >= 0);
-        ::shutdown(sock, SHUT_WR);
 
+        const bool head = raw.rfind("HEAD ", 0) == 0;
         std::string response;
         char buffer[4096];
-        for (;;) {
+        while (!ResponseComplete(response, head)) {
             const auto n = ::recv(sock, buffer, sizeof(buffer), 0);
             if (n <= 0) {
                 break;
@@ -241,6 +355,25 @@ RawHttpResponse SendHttpRequest(int port, const std::string& raw) {
         if (body_pos != std::string::npos) {
             out.body = response.substr(body_pos + 4);
         }
+        std::istringstream header_stream(response.substr(0, body_pos));
+        std::string header_line;
+        std::getline(header_stream, header_line);
+        while (std::getline(header_stream, header_line)) {
+            if (!header_line.empty() && header_line.back() == '\r') {
+                header_line.pop_back();
+            }
+            if (const auto colon = header_line.find(':'); colon != std::string::npos) {
+                auto value = header_line.substr(colon + 1);
+                while (!value.empty() && value.front() == ' ') {
+                    value.erase(value.begin());
+                }
+                out.headers[LowerAscii(header_line.substr(0, colon))] = value;
+            }
+        }
+        if (const auto it = out.headers.find("transfer-encoding");
+            it != out.headers.end() && LowerAscii(it->second) == "chunked") {
+            out.body = DecodeChunkedBody(out.body);
+        }
         return out;
     }
 
@@ -262,8 +395,11 @@ public:
         stop();
     }
 
-    void start(FakeEncounterService& service, FakeLogger& logger, FakeRedactor& redactor) {
-        encounter_service::http::RegisterRoutes(server_, service, logger, redactor);
+    void start(FakeEncounterService& service,
+               FakeLogger& logger,
+               FakeRedactor& redactor,
+               const encounter_service::http::RouteOptions& options = {}) {
+        encounter_service::http::RegisterRoutes(server_, service, logger, redactor, options);
         thread_ = std::thread([this]() {
             (void)server_.listen("127.0.0.1", port_);
         });
@@ -285,6 +421,25 @@ private:
     std::thread thread_{};
 };
 
+std::string Gunzip(const std::string& compressed) {
+    z_stream z{};
+    REQUIRE(inflateInit2(&z, 15 + 16) == Z_OK);
+    z.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(compressed.data()));
+    z.avail_in = static_cast<uInt>(compressed.size());
+    std::string out;
+    int ret = Z_OK;
+    while (ret == Z_OK) {
+        char buffer[4096];
+        z.next_out = reinterpret_cast<Bytef*>(buffer);
+        z.avail_out = sizeof(buffer);
+        ret = inflate(&z, Z_NO_FLUSH);
+        out.append(buffer, sizeof(buffer) - z.avail_out);
+    }
+    inflateEnd(&z);
+    REQUIRE(ret == Z_STREAM_END);
+    return out;
+}
+
 encounter_service::domain::Encounter MakeEncounter(std::string id, std::chrono::system_clock::time_point ts) {
     encounter_service::domain::Encounter encounter{};
     encounter.encounterId = std::move(id);
@@ -310,13 +465,67 @@ TEST_CASE("Routes health endpoint returns 200") {
 
     const auto resp = SendHttpRequest(server.port(), TestHttpRequest{
         .method = "GET",
-        .path = "/health"
+        .path = "/health",
+        .headers = {},
+        .body = {}
     });
 
     REQUIRE(resp.status == 200);
     REQUIRE(resp.body.find("\"status\":\"ok\"") != std::string::npos);
 }
 
+TEST_CASE("Routes answer HEAD with the GET route's headers and no body") {
+    FakeEncounterService service;
+    FakeLogger logger;
+    FakeRedactor redactor;
+    TestServer server(18080);
+    server.start(service, logger, redactor);
+
+    const auto resp = SendHttpRequest(server.port(), TestHttpRequest{
+        .method = "HEAD",
+        .path = "/health",
+        .headers = {},
+        .body = {}
+    });
+
+    REQUIRE(resp.status == 200);
+    REQUIRE(resp.body.empty());
+    REQUIRE(resp.headers.count("content-length") == 1);
+    REQUIRE(resp.headers.at("content-length") != "0");
+}
+
+TEST_CASE("Routes health endpoint reports scheduler stats when configured") {
+    FakeEncounterService service;
+    FakeLogger logger;
+    FakeRedactor redactor;
+
+    encounter_service::util::WorkStealingScheduler scheduler(encounter_service::util::WorkStealingOptions{
+        .threadCount = 2,
+        .pinThreads = false
+    });
+    encounter_service::http::RouteOptions options;
+    options.scheduler = &scheduler;
+
+    TestServer server(18100);
+    server.start(service, logger, redactor, options);
+    const auto resp = SendHttpRequest(server.port(), TestHttpRequest{
+        .method = "GET",
+        .path = "/health",
+        .headers = {},
+        .body = {}
+    });
+    server.stop();
+
+    REQUIRE(resp.status == 200);
+    const auto body = nlohmann::json::parse(resp.body);
+    REQUIRE(body["status"] == "ok");
+    REQUIRE(body["scheduler"]["threads"] == 2);
+    REQUIRE(body["scheduler"].contains("queueDepth"));
+    REQUIRE(body["scheduler"].contains("stolen"));
+    REQUIRE(body["scheduler"].contains("meanWaitMicros"));
+    REQUIRE(body["scheduler"].contains("maxWaitMicros"));
+}
+
 TEST_CASE("Routes enforce auth on non-health endpoints") {
     FakeEncounterService service;
     FakeLogger logger;
@@ -326,7 +535,9 @@ TEST_CASE("Routes enforce auth on non-health endpoints") {
 
     const auto resp = SendHttpRequest(server.port(), TestHttpRequest{
         .method = "GET",
-        .path = "/encounters"
+        .path = "/encounters",
+        .headers = {},
+        .body = {}
     });
 
     REQUIRE(resp.status == 401);
@@ -346,7 +557,8 @@ TEST_CASE("Routes GET encounter by id uses regex route and calls service") {
     const auto resp = SendHttpRequest(server.port(), TestHttpRequest{
         .method = "GET",
         .path = "/encounters/enc-abc_123",
-        .headers = {{"X-API-Key", "key"}}
+        .headers = {{"X-API-Key", "key"}},
+        .body = {}
     });
 
     REQUIRE(resp.status == 200);
@@ -371,15 +583,176 @@ TEST_CASE("Routes GET encounters returns serialized encounter array") {
     const auto resp = SendHttpRequest(server.port(), TestHttpRequest{
         .method = "GET",
         .path = "/encounters",
-        .headers = {{"X-API-Key", "key"}}
+        .headers = {{"X-API-Key", "key"}},
+        .body = {}
     });
 
     REQUIRE(resp.status == 200);
     REQUIRE(service.query_called == true);
+    REQUIRE(service.last_query_actor == "api-key-actor");
     REQUIRE(resp.body.find("\"encounterId\":\"enc-1\"") != std::string::npos);
     REQUIRE(resp.body.find("\"encounterId\":\"enc-2\"") != std::string::npos);
 }
 
+TEST_CASE("Routes GET encounters streams large pages as chunked JSON") {
+    using namespace std::chrono;
+    FakeEncounterService service;
+    std::vector<encounter_service::domain::Encounter> encounters;
+    for (int i = 0; i < 500; ++i) {
+        const auto ts = system_clock::time_point{seconds{1700000000 + i}};
+        encounters.push_back(MakeEncounter("enc-" + std::to_string(i), ts));
+    }
+    service.query_result = encounters;
+    FakeLogger logger;
+    FakeRedactor redactor;
+    TestServer server(18096);
+    server.start(service, logger, redactor);
+
+    const auto resp = SendHttpRequest(server.port(), TestHttpRequest{
+        .method = "GET",
+        .path = "/encounters",
+        .headers = {{"X-API-Key", "key"}},
+        .body = {}
+    });
+    const auto empty = [&] {
+        service.query_result = std::vector<encounter_service::domain::Encounter>{};
+        return SendHttpRequest(server.port(), TestHttpRequest{
+            .method = "GET",
+            .path = "/encounters",
+            .headers = {{"X-API-Key", "key"}},
+            .body = {}
+        });
+    }();
+    server.stop();
+
+    REQUIRE(resp.status == 200);
+    REQUIRE(resp.headers.count("transfer-encoding") == 1);
+    REQUIRE(LowerAscii(resp.headers.at("transfer-encoding")) == "chunked");
+    // Spans several chunks, yet reads back as one array in repository order.
+    REQUIRE(resp.body.size() > 16 * 1024);
+    const auto body = nlohmann::json::parse(resp.body);
+    REQUIRE(body.is_array());
+    REQUIRE(body.size() == 500);
+    REQUIRE(body[0]["encounterId"] == "enc-0");
+    REQUIRE(body[499]["encounterId"] == "enc-499");
+    REQUIRE(empty.status == 200);
+    REQUIRE(empty.body == "[]");
+}
+
+TEST_CASE("Routes gzip-encode large bodies when the client accepts gzip") {
+    using namespace std::chrono;
+    FakeEncounterService service;
+    std::vector<encounter_service::domain::Encounter> encounters;
+    for (int i = 0; i < 500; ++i) {
+        const auto ts = system_clock::time_point{seconds{1700000000 + i}};
+        encounters.push_back(MakeEncounter("enc-" + std::to_string(i), ts));
+    }
+    service.query_result = encounters;
+    auto single = MakeEncounter("enc-big", system_clock::time_point{seconds{1700000000}});
+    single.clinicalData["notes"] = std::string(4096, 'n');
+    service.get_result = single;
+    FakeLogger logger;
+    FakeRedactor redactor;
+    encounter_service::http::CompressedResponseCache cache(1 << 20);
+    encounter_service::http::RouteOptions options;
+    options.compressedEncounters = &cache;
+    TestServer server(18097);
+    server.start(service, logger, redactor, options);
+
+    const std::map<std::string, std::string> gzipHeaders{{"X-API-Key", "key"}, {"Accept-Encoding", "gzip, br"}};
+    const auto list = SendHttpRequest(server.port(), TestHttpRequest{
+        .method = "GET", .path = "/encounters", .headers = gzipHeaders, .body = {}});
+    const auto first = SendHttpRequest(server.port(), TestHttpRequest{
+        .method = "GET", .path = "/encounters/enc-big", .headers = gzipHeaders, .body = {}});
+    const auto second = SendHttpRequest(server.port(), TestHttpRequest{
+        .method = "GET", .path = "/encounters/enc-big", .headers = gzipHeaders, .body = {}});
+    const auto identity = SendHttpRequest(server.port(), TestHttpRequest{
+        .method = "GET", .path = "/encounters/enc-big", .headers = {{"X-API-Key", "key"}}, .body = {}});
+    service.query_result = std::vector<encounter_service::domain::Encounter>{encounters.front()};
+    const auto small = SendHttpRequest(server.port(), TestHttpRequest{
+        .method = "GET", .path = "/encounters", .headers = gzipHeaders, .body = {}});
+    server.stop();
+
+    // The streamed list is compressed incrementally into one gzip member.
+    REQUIRE(list.status == 200);
+    REQUIRE(list.headers.count("content-encoding") == 1);
+    REQUIRE(list.headers.at("content-encoding") == "gzip");
+    REQUIRE(list.headers.at("vary") == "Accept-Encoding");
+    const auto listJson = Gunzip(list.body);
+    REQUIRE(list.body.size() * 5 < listJson.size());
+    REQUIRE(nlohmann::json::parse(listJson).size() == 500);
+
+    // The single encounter is compressed once and then served from the cache.
+    REQUIRE(first.headers.at("content-encoding") == "gzip");
+    REQUIRE(second.body == first.body);
+    REQUIRE(cache.stats().hits == 1);
+    // Cached bodies are served from the shared buffer with their length, not chunked.
+    REQUIRE(second.headers.count("transfer-encoding") == 0);
+    REQUIRE(second.headers.at("content-length") == std::to_string(first.body.size()));
+    REQUIRE(identity.headers.count("content-encoding") == 0);
+    REQUIRE(Gunzip(first.body) == identity.body);
+
+    // Bodies under the threshold go out as-is.
+    REQUIRE(small.status == 200);
+    REQUIRE(small.headers.count("content-encoding") == 0);
+    REQUIRE(nlohmann::json::parse(small.body).size() == 1);
+}
+
+TEST_CASE("Routes answer matching If-None-Match with 304 for encounters and lists") {
+    using namespace std::chrono;
+    FakeEncounterService service;
+    auto encounter = MakeEncounter("enc-1", system_clock::time_point{seconds{1700000000}});
+    encounter.etag = "\"00112233aabbccdd\"";
+    service.get_result = encounter;
+    service.query_result = std::vector<encounter_service::domain::Encounter>{encounter};
+    service.write_generation = 7;
+    FakeLogger logger;
+    FakeRedactor redactor;
+    TestServer server(18098);
+    server.start(service, logger, redactor);
+
+    const auto full = SendHttpRequest(server.port(), TestHttpRequest{
+        .method = "GET", .path = "/encounters/enc-1", .headers = {{"X-API-Key", "key"}}, .body = {}});
+    const auto cached = SendHttpRequest(server.port(), TestHttpRequest{
+        .method = "GET",
+        .path = "/encounters/enc-1",
+        .headers = {{"X-API-Key", "key"}, {"If-None-Match", "W/\"other\", \"00112233aabbccdd\""}}, .body = {}});
+    const auto stale = SendHttpRequest(server.port(), TestHttpRequest{
+        .method = "GET", .path = "/encounters/enc-1", .headers = {{"X-API-Key", "key"}, {"If-None-Match", "\"old\""}}, .body = {}});
+
+    const auto list = SendHttpRequest(server.port(), TestHttpRequest{
+        .method = "GET", .path = "/encounters", .headers = {{"X-API-Key", "key"}}, .body = {}});
+    REQUIRE(list.headers.count("etag") == 1);
+    const auto listEtag = list.headers.at("etag");
+    service.query_called = false;
+    const auto listCached = SendHttpRequest(server.port(), TestHttpRequest{
+        .method = "GET", .path = "/encounters", .headers = {{"X-API-Key", "key"}, {"If-None-Match", listEtag}}, .body = {}});
+    const bool queriedForCachedList = service.query_called;
+    service.write_generation = 8;
+    const auto listChanged = SendHttpRequest(server.port(), TestHttpRequest{
+        .method = "GET", .path = "/encounters", .headers = {{"X-API-Key", "key"}, {"If-None-Match", listEtag}}, .body = {}});
+    server.stop();
+
+    REQUIRE(full.status == 200);
+    REQUIRE(full.headers.at("etag") == "\"00112233aabbccdd\"");
+    REQUIRE(cached.status == 304);
+    REQUIRE(cached.body.empty());
+    REQUIRE(cached.headers.at("etag") == "\"00112233aabbccdd\"");
+    REQUIRE(stale.status == 200);
+    REQUIRE(stale.body == full.body);
+
+    REQUIRE(list.status == 200);
+    REQUIRE(listEtag.rfind("W/\"", 0) == 0);
+    REQUIRE(listCached.status == 304);
+    REQUIRE(listCached.body.empty());
+    // The list query still runs on a 304 so the access is audited.
+    REQUIRE(queriedForCachedList);
+    REQUIRE(listChanged.status == 200);
+    REQUIRE(service.query_called);
+    REQUIRE(listChanged.headers.at("etag") != listEtag);
+    REQUIRE(nlohmann::json::parse(listChanged.body).size() == 1);
+}
+
 TEST_CASE("Routes POST encounters returns 201 on success when real json parser is available") {
 #if __has_include("vendor/json.hpp")
     using namespace std::chrono;
@@ -430,9 +803,366 @@ TEST_CASE("Routes GET audit encounters returns serialized audit array") {
     const auto resp = SendHttpRequest(server.port(), TestHttpRequest{
         .method = "GET",
         .path = "/audit/encounters?from=2026-02-25",
-        .headers = {{"X-API-Key", "key"}}
+        .headers = {{"X-API-Key", "key"}},
+        .body = {}
     });
 
     REQUIRE(resp.status == 200);
     REQUIRE(service.audit_query_called == true);
 }
+
+TEST_CASE("Routes GET audit rollups returns per-day counts") {
+    using namespace std::chrono;
+    FakeEncounterService service;
+    service.rollup_result = std::vector<encounter_service::domain::AuditRollup>{
+        encounter_service::domain::AuditRollup{
+            .day = system_clock::time_point{seconds{1772064000}},
+            .actor = "actor-1",
+            .action = encounter_service::domain::AuditAction::READ_ENCOUNTER,
+            .count = 42
+        }
+    };
+    FakeLogger logger;
+    FakeRedactor redactor;
+    TestServer server(18090);
+    server.start(service, logger, redactor);
+
+    const auto resp = SendHttpRequest(server.port(), TestHttpRequest{
+        .method = "GET",
+        .path = "/audit/encounters/rollups?from=2026-02-01&to=2026-02-28",
+        .headers = {{"X-API-Key", "key"}},
+        .body = {}
+    });
+
+    REQUIRE(resp.status == 200);
+    REQUIRE(service.rollup_query_called == true);
+    REQUIRE(service.last_rollup_range.from.has_value());
+    REQUIRE(resp.body.find("\"day\":\"2026-02-26\"") != std::string::npos);
+    REQUIRE(resp.body.find("\"count\":42") != std::string::npos);
+    REQUIRE(resp.body.find("\"action\":\"READ_ENCOUNTER\"") != std::string::npos);
+}
+
+TEST_CASE("Routes GET audit history serves mapped segment files") {
+    using namespace std::chrono;
+    const auto dir = std::filesystem::temp_directory_path() / "encounter_service_routes_history";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    REQUIRE(encounter_service::storage::WriteAuditSegmentFile((dir / "a.audseg").string(), {
+        encounter_service::domain::AuditEntry{
+            .timestamp = system_clock::time_point{seconds{1700000000}},
+            .actor = "actor-1",
+            .action = encounter_service::domain::AuditAction::READ_ENCOUNTER,
+            .encounterId = "enc-1"
+        }
+    }));
+    encounter_service::storage::MappedAuditHistory history;
+    REQUIRE(history.AddDirectory(dir.string()) == 1);
+
+    FakeEncounterService service;
+    FakeLogger logger;
+    FakeRedactor redactor;
+    TestServer server(18091);
+    server.start(service, logger, redactor, encounter_service::http::RouteOptions{.auditHistory = &history});
+
+    const auto resp = SendHttpRequest(server.port(), TestHttpRequest{
+        .method = "GET",
+        .path = "/audit/encounters/history?from=2023-11-14&to=2023-11-15",
+        .headers = {{"X-API-Key", "key"}},
+        .body = {}
+    });
+    const auto unauthorized = SendHttpRequest(server.port(), TestHttpRequest{
+        .method = "GET",
+        .path = "/audit/encounters/history",
+        .headers = {},
+        .body = {}
+    });
+    server.stop();
+    std::filesystem::remove_all(dir);
+
+    REQUIRE(resp.status == 200);
+    REQUIRE(resp.body ==
+            "[{\"action\":\"READ_ENCOUNTER\",\"actor\":\"actor-1\",\"encounterId\":\"enc-1\","
+            "\"timestamp\":\"2023-11-14T22:13:20Z\"}]");
+    REQUIRE(unauthorized.status == 401);
+    REQUIRE(service.audit_query_called == false);
+}
+
+TEST_CASE("Routes GET audit history streams large ranges as chunked, gzip-negotiated JSON") {
+    using namespace std::chrono;
+    const auto dir = std::filesystem::temp_directory_path() / "encounter_service_routes_history_stream";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    std::vector<encounter_service::domain::AuditEntry> earlier;
+    std::vector<encounter_service::domain::AuditEntry> later;
+    for (int i = 0; i < 300; ++i) {
+        auto& entries = i < 150 ? earlier : later;
+        entries.push_back(encounter_service::domain::AuditEntry{
+            .timestamp = system_clock::time_point{seconds{1700000000 + i}},
+            .actor = "actor-1",
+            .action = encounter_service::domain::AuditAction::READ_ENCOUNTER,
+            .encounterId = "enc-" + std::to_string(i)
+        });
+    }
+    REQUIRE(encounter_service::storage::WriteAuditSegmentFile((dir / "b.audseg").string(), later));
+    REQUIRE(encounter_service::storage::WriteAuditSegmentFile((dir / "a.audseg").string(), earlier));
+    encounter_service::storage::MappedAuditHistory history;
+    REQUIRE(history.AddDirectory(dir.string()) == 2);
+
+    FakeEncounterService service;
+    FakeLogger logger;
+    FakeRedactor redactor;
+    TestServer server(18101);
+    server.start(service, logger, redactor, encounter_service::http::RouteOptions{.auditHistory = &history});
+
+    const auto plain = SendHttpRequest(server.port(), TestHttpRequest{
+        .method = "GET", .path = "/audit/encounters/history", .headers = {{"X-API-Key", "key"}}, .body = {}});
+    const auto gzip = SendHttpRequest(server.port(), TestHttpRequest{
+        .method = "GET",
+        .path = "/audit/encounters/history",
+        .headers = {{"X-API-Key", "key"}, {"Accept-Encoding", "gzip"}}, .body = {}});
+    const auto empty = SendHttpRequest(server.port(), TestHttpRequest{
+        .method = "GET", .path = "/audit/encounters/history?from=2030-01-01", .headers = {{"X-API-Key", "key"}}, .body = {}});
+    server.stop();
+    std::filesystem::remove_all(dir);
+
+    // Spans several chunks across both segments, yet reads back as one array in time order.
+    REQUIRE(plain.status == 200);
+    REQUIRE(LowerAscii(plain.headers.at("transfer-encoding")) == "chunked");
+    REQUIRE(plain.headers.at("vary") == "Accept-Encoding");
+    REQUIRE(plain.body.size() > 16 * 1024);
+    const auto body = nlohmann::json::parse(plain.body);
+    REQUIRE(body.size() == 300);
+    REQUIRE(body[0]["encounterId"] == "enc-0");
+    REQUIRE(body[299]["encounterId"] == "enc-299");
+
+    REQUIRE(gzip.status == 200);
+    REQUIRE(gzip.headers.at("content-encoding") == "gzip");
+    REQUIRE(Gunzip(gzip.body) == plain.body);
+
+    REQUIRE(empty.status == 200);
+    REQUIRE(empty.body == "[]");
+    REQUIRE(empty.headers.at("vary") == "Accept-Encoding");
+}
+
+TEST_CASE("Routes POST encounters batchGet reports missing IDs per item") {
+    using namespace std::chrono;
+    FakeEncounterService service;
+    service.batch_get_result = std::vector<std::optional<encounter_service::domain::Encounter>>{
+        MakeEncounter("enc-1", system_clock::time_point{seconds{1700000000}}),
+        std::nullopt
+    };
+    FakeLogger logger;
+    FakeRedactor redactor;
+    TestServer server(18092);
+    server.start(service, logger, redactor);
+
+    const auto resp = SendHttpRequest(server.port(), TestHttpRequest{
+        .method = "POST",
+        .path = "/encounters:batchGet",
+        .headers = {{"X-API-Key", "key"}, {"Content-Type", "application/json"}},
+        .body = R"({"ids":["enc-1","enc-missing"]})"
+    });
+    const auto invalid = SendHttpRequest(server.port(), TestHttpRequest{
+        .method = "POST",
+        .path = "/encounters:batchGet",
+        .headers = {{"X-API-Key", "key"}, {"Content-Type", "application/json"}},
+        .body = R"({"ids":[]})"
+    });
+    server.stop();
+
+    REQUIRE(resp.status == 200);
+    REQUIRE(service.batch_get_called == true);
+    REQUIRE(service.last_batch_get_actor == "api-key-actor");
+    REQUIRE(service.last_batch_get_ids.size() == 2);
+    const auto body = nlohmann::json::parse(resp.body);
+    REQUIRE(body["results"].size() == 2);
+    REQUIRE(body["results"][0]["encounter"]["encounterId"] == "enc-1");
+    REQUIRE(body["results"][1]["encounterId"] == "enc-missing");
+    REQUIRE(body["results"][1]["error"]["code"] == "not_found");
+    REQUIRE(invalid.status == 400);
+}
+
+TEST_CASE("Routes shed requests over the admission limit with 503 and Retry-After") {
+    FakeEncounterService service;
+    service.get_result = MakeEncounter("enc-1", std::chrono::system_clock::time_point{std::chrono::seconds{1700000000}});
+    FakeLogger logger;
+    FakeRedactor redactor;
+
+    encounter_service::http::AdmissionOptions admission_options{};
+    auto& reads = admission_options.limits[static_cast<std::size_t>(encounter_service::http::RouteClass::Read)];
+    reads.initialLimit = 1;
+    reads.maxQueue = 0;
+    admission_options.retryAfter = std::chrono::seconds{3};
+    encounter_service::http::AdmissionController admission(admission_options);
+    encounter_service::http::RouteOptions options;
+    options.admission = &admission;
+
+    // Hold the only read slot so the next read is shed; other route classes stay open.
+    auto held = admission.TryAdmit(encounter_service::http::RouteClass::Read);
+    REQUIRE(held.has_value());
+
+    TestServer server(18093);
+    server.start(service, logger, redactor, options);
+    const auto shed = SendHttpRequest(server.port(), TestHttpRequest{
+        .method = "GET",
+        .path = "/encounters/enc-1",
+        .headers = {{"X-API-Key", "key"}, {"X-Request-Id", "req-shed"}},
+        .body = {}
+    });
+    const auto health = SendHttpRequest(server.port(), TestHttpRequest{
+        .method = "GET",
+        .path = "/health",
+        .headers = {},
+        .body = {}
+    });
+    const auto audit = SendHttpRequest(server.port(), TestHttpRequest{
+        .method = "GET",
+        .path = "/audit/encounters",
+        .headers = {{"X-API-Key", "key"}},
+        .body = {}
+    });
+    held.reset();
+    const auto admitted = SendHttpRequest(server.port(), TestHttpRequest{
+        .method = "GET",
+        .path = "/encounters/enc-1",
+        .headers = {{"X-API-Key", "key"}},
+        .body = {}
+    });
+    server.stop();
+
+    REQUIRE(shed.status == 503);
+    REQUIRE(shed.headers.at("retry-after") == "3");
+    const auto body = nlohmann::json::parse(shed.body);
+    REQUIRE(body["error"]["code"] == "service_unavailable");
+    REQUIRE(body["requestId"] == "req-shed");
+    REQUIRE(health.status == 200);
+    REQUIRE(audit.status == 200);
+    REQUIRE(admitted.status == 200);
+    REQUIRE(admission.stats(encounter_service::http::RouteClass::Read).shed == 1);
+}
+
+TEST_CASE("Routes reject actors over their rate limit with 429 and Retry-After") {
+    FakeEncounterService service;
+    FakeLogger logger;
+    FakeRedactor redactor;
+
+    encounter_service::http::RateLimitOptions limit_options{};
+    limit_options.limits[static_cast<std::size_t>(encounter_service::http::RouteClass::List)] = {
+        .ratePerSecond = 0.5,
+        .burst = 1.0
+    };
+    encounter_service::http::RateLimiter limiter(limit_options);
+    encounter_service::http::RouteOptions options;
+    options.rateLimiter = &limiter;
+
+    TestServer server(18094);
+    server.start(service, logger, redactor, options);
+    const TestHttpRequest list{
+        .method = "GET",
+        .path = "/encounters",
+        .headers = {{"X-API-Key", "key"}, {"X-Request-Id", "req-limited"}},
+        .body = {}
+    };
+    const auto first = SendHttpRequest(server.port(), list);
+    const auto second = SendHttpRequest(server.port(), list);
+    // Budgets are per API key even though every key currently authenticates as the same actor.
+    const auto other_key = SendHttpRequest(server.port(), TestHttpRequest{
+        .method = "GET",
+        .path = "/encounters",
+        .headers = {{"X-API-Key", "other-key"}},
+        .body = {}
+    });
+    // Point reads are budgeted separately from list scans.
+    const auto read = SendHttpRequest(server.port(), TestHttpRequest{
+        .method = "GET",
+        .path = "/encounters/enc-1",
+        .headers = {{"X-API-Key", "key"}},
+        .body = {}
+    });
+    server.stop();
+
+    REQUIRE(first.status == 200);
+    REQUIRE(second.status == 429);
+    REQUIRE(second.headers.at("retry-after") == "2");
+    const auto body = nlohmann::json::parse(second.body);
+    REQUIRE(body["error"]["code"] == "rate_limited");
+    REQUIRE(body["requestId"] == "req-limited");
+    REQUIRE(other_key.status == 200);
+    REQUIRE(read.status != 429);
+}
+
+TEST_CASE("Routes GET encounters applies the request deadline and maps expiry to 504") {
+    FakeEncounterService service;
+    FakeLogger logger;
+    FakeRedactor redactor;
+
+    encounter_service::http::RouteOptions options;
+    options.requestTimeouts[static_cast<std::size_t>(encounter_service::http::RouteClass::List)] =
+        std::chrono::milliseconds{60000};
+
+    TestServer server(18095);
+    server.start(service, logger, redactor, options);
+    const auto before = std::chrono::steady_clock::now();
+    const auto ok = SendHttpRequest(server.port(), TestHttpRequest{
+        .method = "GET",
+        .path = "/encounters",
+        .headers = {{"X-API-Key", "key"}, {"X-Request-Timeout-Ms", "2000"}},
+        .body = {}
+    });
+    const auto headerDeadline = service.last_query_deadline;
+
+    (void)SendHttpRequest(server.port(), TestHttpRequest{
+        .method = "GET",
+        .path = "/encounters",
+        .headers = {{"X-API-Key", "key"}, {"X-Request-Timeout-Ms", "not-a-number"}},
+        .body = {}
+    });
+    const auto defaultDeadline = service.last_query_deadline;
+
+    service.query_result = encounter_service::domain::DomainError{
+        .code = encounter_service::domain::DomainErrorCode::DeadlineExceeded,
+        .message = "Request deadline exceeded",
+        .details = std::nullopt
+    };
+    const auto expired = SendHttpRequest(server.port(), TestHttpRequest{
+        .method = "GET",
+        .path = "/encounters",
+        .headers = {{"X-API-Key", "key"}, {"X-Request-Timeout-Ms", "1"}},
+        .body = {}
+    });
+    server.stop();
+
+    REQUIRE(ok.status == 200);
+    // The client's shorter timeout wins over the route default; malformed values fall back to it.
+    REQUIRE(headerDeadline.has_value());
+    REQUIRE(*headerDeadline <= before + std::chrono::milliseconds{2000} + std::chrono::seconds{5});
+    REQUIRE(*headerDeadline < before + std::chrono::seconds{30});
+    REQUIRE(defaultDeadline.has_value());
+    REQUIRE(*defaultDeadline >= before + std::chrono::seconds{59});
+    REQUIRE(expired.status == 504);
+    REQUIRE(nlohmann::json::parse(expired.body)["error"]["code"] == "deadline_exceeded");
+}
+
+TEST_CASE("Routes GET encounters clamps oversized request timeouts instead of overflowing") {
+    FakeEncounterService service;
+    FakeLogger logger;
+    FakeRedactor redactor;
+
+    TestServer server(18099);
+    server.start(service, logger, redactor);
+    const auto before = std::chrono::steady_clock::now();
+    const auto response = SendHttpRequest(server.port(), TestHttpRequest{
+        .method = "GET",
+        .path = "/encounters",
+        .headers = {{"X-API-Key", "key"}, {"X-Request-Timeout-Ms", "9223372036854775807"}},
+        .body = {}
+    });
+    const auto deadline = service.last_query_deadline;
+    server.stop();
+
+    // An overflowed deadline would land in the past and fail the request with 504.
+    REQUIRE(response.status == 200);
+    REQUIRE(deadline.has_value());
+    REQUIRE(*deadline > before + std::chrono::hours{23});
+    REQUIRE(*deadline <= before + std::chrono::hours{25});
+}
@@ -0,0 +1,147 @@
+#include "tests/catch_compat.h"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <thread>
+
+#include "src/storage/audit_archiver.h"
+#include "src/storage/audit_segment_file.h"
+#include "src/storage/in_memory_audit_repo.h"
+#include "src/util/clock.h"
+
+namespace {
+
+// Clock the test moves forward while the archiver thread reads it.
+class ManualClock final : public encounter_service::util::Clock {
+public:
+    explicit ManualClock(TimePoint now)
+        : ticks_(now.time_since_epoch().count()) {}
+
+    TimePoint Now() const override {
+        return TimePoint(TimePoint::duration(ticks_.load()));
+    }
+
+    void Set(TimePoint now) {
+        ticks_.store(now.time_since_epoch().count());
+    }
+
+private:
+    std::atomic<TimePoint::rep> ticks_;
+};
+
+encounter_service::domain::AuditEntry MakeAudit(std::chrono::system_clock::time_point ts, std::string encounterId) {
+    return encounter_service::domain::AuditEntry{
+        .timestamp = ts,
+        .actor = "actor",
+        .action = encounter_service::domain::AuditAction::READ_ENCOUNTER,
+        .encounterId = std::move(encounterId)
+    };
+}
+
+// Polls until `archivedSegments` reaches `expected` or `timeout` passes.
+bool WaitForArchivedSegments(const encounter_service::storage::InMemoryAuditRepository& repo,
+                             std::size_t expected,
+                             std::chrono::milliseconds timeout) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (repo.stats().archivedSegments < expected) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+}  // namespace
+
+TEST_CASE("AuditArchiver archives segments once the clock passes the archive threshold") {
+    using namespace std::chrono;
+    encounter_service::storage::CompactAuditLogOptions options{};
+    options.segmentCapacity = 2;
+    options.archiveAfter = hours{1};
+    encounter_service::storage::InMemoryAuditRepository repo(options);
+    const auto t0 = system_clock::time_point{hours{1000}};
+    repo.Append(MakeAudit(t0, "enc-1"));
+    repo.Append(MakeAudit(t0 + seconds{1}, "enc-2"));
+    repo.Append(MakeAudit(t0 + seconds{2}, "enc-3"));
+
+    ManualClock clock(t0 + minutes{30});
+    encounter_service::storage::AuditArchiver archiver(repo, clock, milliseconds{1});
+    archiver.Start();
+    archiver.Start();
+
+    // Several passes run while the sealed segment is still younger than the threshold.
+    REQUIRE(!WaitForArchivedSegments(repo, 1, milliseconds{50}));
+
+    clock.Set(t0 + hours{2});
+    REQUIRE(WaitForArchivedSegments(repo, 1, seconds{5}));
+    archiver.Stop();
+    archiver.Stop();
+
+    const auto stats = repo.stats();
+    REQUIRE(stats.archivedSegments == 1);
+    REQUIRE(stats.archivedEntries == 2);
+    // The unsealed segment stays hot; archived entries still answer queries.
+    REQUIRE(stats.hotEntries == 1);
+    REQUIRE(repo.Query({}).size() == 3);
+}
+
+TEST_CASE("AuditArchiver can be restarted after Stop") {
+    using namespace std::chrono;
+    encounter_service::storage::CompactAuditLogOptions options{};
+    options.segmentCapacity = 1;
+    options.archiveAfter = hours{1};
+    encounter_service::storage::InMemoryAuditRepository repo(options);
+    const auto t0 = system_clock::time_point{hours{1000}};
+    repo.Append(MakeAudit(t0, "enc-1"));
+
+    ManualClock clock(t0 + hours{2});
+    encounter_service::storage::AuditArchiver archiver(repo, clock, milliseconds{1});
+    archiver.Start();
+    REQUIRE(WaitForArchivedSegments(repo, 1, seconds{5}));
+    archiver.Stop();
+
+    repo.Append(MakeAudit(t0 + seconds{1}, "enc-2"));
+    archiver.Start();
+    REQUIRE(WaitForArchivedSegments(repo, 2, seconds{5}));
+}
+
+TEST_CASE("AuditArchiver seals archived segments into history files") {
+    using namespace std::chrono;
+    const auto dir = std::filesystem::temp_directory_path() / "encounter_service_archiver_history";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    encounter_service::storage::CompactAuditLogOptions options{};
+    options.segmentCapacity = 2;
+    options.archiveAfter = hours{1};
+    encounter_service::storage::InMemoryAuditRepository repo(options);
+    const auto t0 = system_clock::time_point{hours{1000}};
+    repo.Append(MakeAudit(t0, "enc-1"));
+    repo.Append(MakeAudit(t0 + seconds{1}, "enc-2"));
+    repo.Append(MakeAudit(t0 + seconds{2}, "enc-3"));
+
+    encounter_service::storage::MappedAuditHistory history;
+    ManualClock clock(t0 + hours{2});
+    encounter_service::storage::AuditArchiver archiver(
+        repo, clock, milliseconds{1},
+        encounter_service::storage::AuditHistorySink{.directory = dir.string(), .history = &history});
+    archiver.Start();
+    REQUIRE(WaitForArchivedSegments(repo, 1, seconds{5}));
+    archiver.Stop();
+
+    REQUIRE(history.segmentCount() == 1);
+    std::string out;
+    history.WriteJsonArray({}, out);
+    REQUIRE(out.find("\"encounterId\":\"enc-1\"") != std::string::npos);
+    REQUIRE(out.find("\"encounterId\":\"enc-2\"") != std::string::npos);
+    REQUIRE(out.find("enc-3") == std::string::npos);
+
+    // A restart maps what the previous run sealed.
+    encounter_service::storage::MappedAuditHistory reopened;
+    REQUIRE(reopened.AddDirectory(dir.string()) == 1);
+
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,128 @@
+#include "tests/catch_compat.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <thread>
+
+#include "src/storage/audit_rollups.h"
+#include "src/storage/in_memory_audit_repo.h"
+
+namespace {
+
+encounter_service::domain::AuditEntry MakeAudit(std::chrono::system_clock::time_point ts,
+                                                std::string actor,
+                                                encounter_service::domain::AuditAction action = encounter_service::domain::AuditAction::READ_ENCOUNTER) {
+    return encounter_service::domain::AuditEntry{
+        .timestamp = ts,
+        .actor = std::move(actor),
+        .action = action,
+        .encounterId = "enc-1"
+    };
+}
+
+}  // namespace
+
+TEST_CASE("AuditRollupTable counts entries per day, actor and action") {
+    using namespace std::chrono;
+    encounter_service::storage::AuditRollupTable table;
+    const auto day1 = system_clock::time_point{seconds{1700006400}};  // 2023-11-15T00:00:00Z
+    const auto day2 = day1 + hours{24};
+
+    table.Add(MakeAudit(day1 + hours{1}, "b-actor"));
+    table.Add(MakeAudit(day1 + hours{2}, "b-actor"));
+    table.Add(MakeAudit(day1 + hours{3}, "a-actor"));
+    table.Add(MakeAudit(day1 + hours{4}, "a-actor", encounter_service::domain::AuditAction::CREATE_ENCOUNTER));
+    table.Add(MakeAudit(day2 + hours{5}, "b-actor"));
+
+    const auto rollups = table.Query({});
+    REQUIRE(rollups.size() == 4);
+    REQUIRE(rollups[0].day == day1);
+    REQUIRE(rollups[0].actor == "a-actor");
+    REQUIRE(rollups[0].action == encounter_service::domain::AuditAction::READ_ENCOUNTER);
+    REQUIRE(rollups[0].count == 1);
+    REQUIRE(rollups[1].actor == "a-actor");
+    REQUIRE(rollups[1].action == encounter_service::domain::AuditAction::CREATE_ENCOUNTER);
+    REQUIRE(rollups[2].actor == "b-actor");
+    REQUIRE(rollups[2].count == 2);
+    REQUIRE(rollups[3].day == day2);
+    REQUIRE(rollups[3].count == 1);
+}
+
+TEST_CASE("AuditRollupTable range bounds are day-granular") {
+    using namespace std::chrono;
+    encounter_service::storage::AuditRollupTable table;
+    const auto day1 = system_clock::time_point{seconds{1700006400}};
+    table.Add(MakeAudit(day1 + hours{1}, "a"));
+    table.Add(MakeAudit(day1 + hours{25}, "a"));
+    table.Add(MakeAudit(day1 + hours{49}, "a"));
+
+    encounter_service::storage::AuditDateRange range{};
+    range.from = day1 + hours{30};
+    range.to = day1 + hours{30};
+    const auto rollups = table.Query(range);
+    REQUIRE(rollups.size() == 1);
+    REQUIRE(rollups[0].day == day1 + hours{24});
+}
+
+TEST_CASE("InMemoryAuditRepository maintains rollups on append") {
+    using namespace std::chrono;
+    encounter_service::storage::InMemoryAuditRepository repo;
+    const auto day1 = system_clock::time_point{seconds{1700006400}};
+    repo.Append(MakeAudit(day1, "a"));
+    repo.Append(MakeAudit(day1 + minutes{1}, "a"));
+
+    const auto rollups = repo.QueryRollups({});
+    REQUIRE(rollups.size() == 1);
+    REQUIRE(rollups[0].count == 2);
+}
+
+TEST_CASE("InMemoryAuditRepository rollups survive archival of counted segments") {
+    using namespace std::chrono;
+    encounter_service::storage::CompactAuditLogOptions options{};
+    options.segmentCapacity = 2;
+    encounter_service::storage::InMemoryAuditRepository repo(options);
+    const auto day1 = system_clock::time_point{seconds{1700006400}};
+    repo.Append(MakeAudit(day1, "a"));
+    repo.Append(MakeAudit(day1 + minutes{1}, "a"));
+    repo.Append(MakeAudit(day1 + hours{48}, "a"));
+
+    REQUIRE(repo.ArchiveSegmentsOlderThan(day1 + hours{1}) == 1);
+    const auto rollups = repo.QueryRollups({});
+    REQUIRE(rollups.size() == 2);
+    REQUIRE(rollups[0].count == 2);
+    REQUIRE(rollups[1].count == 1);
+    REQUIRE(repo.stats().archivedEntries == 2);
+}
+
+TEST_CASE("InMemoryAuditRepository archives only folded segments while appends continue") {
+    using namespace std::chrono;
+    encounter_service::storage::CompactAuditLogOptions options{};
+    options.segmentCapacity = 2;
+    encounter_service::storage::InMemoryAuditRepository repo(options);
+    const auto day1 = system_clock::time_point{seconds{1700006400}};
+
+    constexpr int kEntries = 4000;
+    std::atomic<bool> done{false};
+    std::thread writer([&]() {
+        for (int i = 0; i < kEntries; ++i) {
+            repo.Append(MakeAudit(day1 + seconds{i % 60}, "a"));
+        }
+        done.store(true);
+    });
+
+    // Every segment is cold, so archival races the appends that seal it; none may be archived
+    // before the rollups have counted it.
+    while (!done.load()) {
+        repo.ArchiveSegmentsOlderThan(day1 + hours{1});
+        (void)repo.QueryRollups({});
+    }
+    writer.join();
+    repo.ArchiveSegmentsOlderThan(day1 + hours{1});
+
+    const auto rollups = repo.QueryRollups({});
+    REQUIRE(rollups.size() == 1);
+    REQUIRE(rollups[0].count == static_cast<std::size_t>(kEntries));
+    REQUIRE(repo.stats().archivedEntries == static_cast<std::size_t>(kEntries));
+}
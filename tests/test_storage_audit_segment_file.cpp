@@ -0,0 +1,228 @@
+#include "tests/catch_compat.h"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "src/http/json_writer.h"
+#include "src/storage/audit_segment_file.h"
+#include "src/util/json_compat.h"
+
+namespace {
+
+encounter_service::domain::AuditEntry MakeAudit(std::chrono::system_clock::time_point ts,
+                                                std::string actor,
+                                                std::string encounterId,
+                                                encounter_service::domain::AuditAction action = encounter_service::domain::AuditAction::READ_ENCOUNTER) {
+    return encounter_service::domain::AuditEntry{
+        .timestamp = ts,
+        .actor = std::move(actor),
+        .action = action,
+        .encounterId = std::move(encounterId)
+    };
+}
+
+std::filesystem::path MakeTempDir(const std::string& name) {
+    const auto dir = std::filesystem::temp_directory_path() / name;
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+}  // namespace
+
+TEST_CASE("MappedAuditSegment serializes range matches like the audit list JSON") {
+    using namespace std::chrono;
+    const auto dir = MakeTempDir("encounter_service_audseg_range");
+    const auto path = (dir / "a.audseg").string();
+    const auto base = system_clock::time_point{seconds{1700000000}};
+
+    REQUIRE(encounter_service::storage::WriteAuditSegmentFile(path, {
+        MakeAudit(base + seconds{30}, "actor-b", "enc-2", encounter_service::domain::AuditAction::CREATE_ENCOUNTER),
+        MakeAudit(base + seconds{10}, "actor-a", "enc-1"),
+        MakeAudit(base + seconds{20}, "actor-a", "enc-2"),
+        MakeAudit(base + seconds{40}, "actor-a", "enc-3")
+    }));
+
+    auto segment = encounter_service::storage::MappedAuditSegment::Open(path);
+    REQUIRE(segment.has_value());
+    REQUIRE(segment->size() == 4);
+
+    encounter_service::storage::AuditDateRange range{};
+    range.from = base + seconds{20};
+    range.to = base + seconds{30};
+    std::string out;
+    bool first = true;
+    REQUIRE(segment->AppendJsonRange(range, out, first) == 2);
+
+    const auto parsed = nlohmann::json::parse("[" + out + "]");
+    REQUIRE(parsed.size() == 2);
+    REQUIRE(parsed[0]["encounterId"] == "enc-2");
+    REQUIRE(parsed[0]["action"] == "READ_ENCOUNTER");
+    REQUIRE(parsed[1]["actor"] == "actor-b");
+    REQUIRE(parsed[1]["action"] == "CREATE_ENCOUNTER");
+    REQUIRE(parsed[1]["timestamp"] == "2023-11-14T22:13:50Z");
+
+    nlohmann::json expected = nlohmann::json::object();
+    expected["action"] = "READ_ENCOUNTER";
+    expected["actor"] = "actor-a";
+    expected["encounterId"] = "enc-2";
+    expected["timestamp"] = "2023-11-14T22:13:40Z";
+    REQUIRE(out.substr(0, expected.dump().size()) == expected.dump());
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("MappedAuditSegment stores strings JSON-escaped") {
+    using namespace std::chrono;
+    const auto dir = MakeTempDir("encounter_service_audseg_escape");
+    const auto path = (dir / "a.audseg").string();
+    const std::string actor = "quote\"back\\slash\nline\x01";
+    REQUIRE(encounter_service::storage::WriteAuditSegmentFile(
+        path, {MakeAudit(system_clock::time_point{seconds{1700000000}}, actor, "enc-1")}));
+
+    auto segment = encounter_service::storage::MappedAuditSegment::Open(path);
+    REQUIRE(segment.has_value());
+    std::string out;
+    bool first = true;
+    segment->AppendJsonRange({}, out, first);
+    REQUIRE(nlohmann::json::parse(out)["actor"] == actor);
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("MappedAuditSegment writes the same bytes as the audit entry writer, including non-ASCII text") {
+    using namespace std::chrono;
+    const auto dir = MakeTempDir("encounter_service_audseg_utf8");
+    const auto path = (dir / "a.audseg").string();
+    const auto entry = MakeAudit(system_clock::time_point{seconds{1700000000}}, "Jos\xc3\xa9 \"A\"", "enc-\xe2\x82\xac");
+    REQUIRE(encounter_service::storage::WriteAuditSegmentFile(path, {entry}));
+
+    auto segment = encounter_service::storage::MappedAuditSegment::Open(path);
+    REQUIRE(segment.has_value());
+    std::string out;
+    bool first = true;
+    segment->AppendJsonRange({}, out, first);
+
+    std::string expected;
+    encounter_service::http::AppendAuditEntryJson(expected, entry);
+    REQUIRE(out == expected);
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("MappedAuditSegment rejects malformed files") {
+    const auto dir = MakeTempDir("encounter_service_audseg_malformed");
+    const auto path = (dir / "bad.audseg").string();
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "ENCAUDS1 but truncated";
+    }
+    REQUIRE(!encounter_service::storage::MappedAuditSegment::Open(path).has_value());
+    REQUIRE(!encounter_service::storage::MappedAuditSegment::Open((dir / "missing.audseg").string()).has_value());
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("MappedAuditSegment rejects wrapping string table offsets and unknown actions") {
+    using namespace std::chrono;
+    const auto dir = MakeTempDir("encounter_service_audseg_crafted");
+    const auto path = (dir / "a.audseg").string();
+    const auto valid = [&path]() {
+        REQUIRE(encounter_service::storage::WriteAuditSegmentFile(path, {
+            MakeAudit(system_clock::time_point{seconds{1700000000}}, "actor-a", "enc-1")
+        }));
+    };
+    // Overwrites `bytes` at `offset`; the header is 40 bytes and the first record follows it.
+    const auto patch = [&path](std::streamoff offset, const void* bytes, std::size_t size) {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(offset);
+        file.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(size));
+    };
+
+    valid();
+    REQUIRE(encounter_service::storage::MappedAuditSegment::Open(path).has_value());
+
+    // stringTableOffset sits at byte 32; this value wraps when the offsets table size is added.
+    const std::uint64_t wrappingOffset = ~std::uint64_t{0} - 3;
+    patch(32, &wrappingOffset, sizeof(wrappingOffset));
+    REQUIRE(!encounter_service::storage::MappedAuditSegment::Open(path).has_value());
+
+    valid();
+    // The first record's actorAction sits at byte 48; action bits start at bit 28.
+    const std::uint32_t unknownAction = std::uint32_t{7} << 28;
+    patch(48, &unknownAction, sizeof(unknownAction));
+    REQUIRE(!encounter_service::storage::MappedAuditSegment::Open(path).has_value());
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("MappedAuditHistory merges segment files in time order") {
+    using namespace std::chrono;
+    const auto dir = MakeTempDir("encounter_service_audseg_history");
+    const auto base = system_clock::time_point{seconds{1700000000}};
+    REQUIRE(encounter_service::storage::WriteAuditSegmentFile(
+        (dir / "later.audseg").string(), {MakeAudit(base + hours{2}, "actor-a", "enc-later")}));
+    REQUIRE(encounter_service::storage::WriteAuditSegmentFile(
+        (dir / "earlier.audseg").string(), {MakeAudit(base + hours{1}, "actor-a", "enc-earlier")}));
+    {
+        std::ofstream ignored(dir / "notes.txt");
+        ignored << "not a segment";
+    }
+
+    encounter_service::storage::MappedAuditHistory history;
+    REQUIRE(history.AddDirectory(dir.string()) == 2);
+    REQUIRE(history.segmentCount() == 2);
+
+    std::string out;
+    history.WriteJsonArray({}, out);
+    const auto parsed = nlohmann::json::parse(out);
+    REQUIRE(parsed.size() == 2);
+    REQUIRE(parsed[0]["encounterId"] == "enc-earlier");
+    REQUIRE(parsed[1]["encounterId"] == "enc-later");
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("SealAuditSegmentFile writes new files that a history maps as they appear") {
+    using namespace std::chrono;
+    const auto dir = MakeTempDir("encounter_service_audseg_seal");
+    const auto base = system_clock::time_point{seconds{1700000000}};
+
+    encounter_service::storage::MappedAuditHistory history;
+    REQUIRE(history.AddDirectory(dir.string()) == 0);
+
+    const auto later = encounter_service::storage::SealAuditSegmentFile(
+        dir.string(), {MakeAudit(base + hours{2}, "actor-a", "enc-later")});
+    REQUIRE(later.has_value());
+    REQUIRE(history.AddFile(*later));
+    // The same time range again gets its own file instead of replacing the first.
+    const auto repeat = encounter_service::storage::SealAuditSegmentFile(
+        dir.string(), {MakeAudit(base + hours{2}, "actor-b", "enc-repeat")});
+    REQUIRE(repeat.has_value());
+    REQUIRE(*repeat != *later);
+    const auto earlier = encounter_service::storage::SealAuditSegmentFile(
+        dir.string(), {MakeAudit(base + hours{1}, "actor-a", "enc-earlier")});
+    REQUIRE(earlier.has_value());
+    REQUIRE(history.AddFile(*earlier));
+    REQUIRE(!history.AddFile((dir / "missing.audseg").string()));
+
+    std::size_t files = 0;
+    for (const auto& item : std::filesystem::directory_iterator(dir)) {
+        REQUIRE(item.path().extension() == encounter_service::storage::kAuditSegmentFileExtension);
+        ++files;
+    }
+    REQUIRE(files == 3);
+
+    std::string out;
+    history.WriteJsonArray({}, out);
+    const auto parsed = nlohmann::json::parse(out);
+    REQUIRE(parsed.size() == 2);
+    REQUIRE(parsed[0]["encounterId"] == "enc-earlier");
+    REQUIRE(parsed[1]["encounterId"] == "enc-later");
+
+    std::filesystem::remove_all(dir);
+}
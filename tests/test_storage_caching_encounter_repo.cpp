@@ -0,0 +1,166 @@
+#include "tests/catch_compat.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "src/storage/caching_encounter_repo.h"
+#include "src/storage/in_memory_encounter_repo.h"
+
+namespace {
+
+class CountingEncounterRepository final : public encounter_service::storage::EncounterRepository {
+public:
+    encounter_service::domain::Encounter Create(encounter_service::domain::Encounter encounter) override {
+        return inner.Create(std::move(encounter));
+    }
+
+    std::optional<encounter_service::domain::Encounter> GetById(const std::string& encounterId) const override {
+        ++getByIdCalls;
+        return inner.GetById(encounterId);
+    }
+
+    std::vector<std::optional<encounter_service::domain::Encounter>> GetByIds(
+        const std::vector<std::string>& encounterIds) const override {
+        ++getByIdsCalls;
+        lastGetByIds = encounterIds;
+        return inner.GetByIds(encounterIds);
+    }
+
+    std::vector<encounter_service::domain::Encounter> Query(
+        const encounter_service::storage::EncounterQueryFilters& filters,
+        const encounter_service::util::RequestContext& context) const override {
+        return inner.Query(filters, context);
+    }
+
+    std::uint64_t WriteGeneration() const override {
+        return inner.WriteGeneration();
+    }
+
+    encounter_service::storage::InMemoryEncounterRepository inner;
+    mutable int getByIdCalls{0};
+    mutable int getByIdsCalls{0};
+    mutable std::vector<std::string> lastGetByIds;
+};
+
+encounter_service::domain::Encounter MakeEncounter(const std::string& id, std::size_t payloadBytes = 0) {
+    encounter_service::domain::Encounter e{};
+    e.encounterId = id;
+    e.patientId = "patient-1";
+    e.providerId = "provider-1";
+    e.encounterDate = std::chrono::system_clock::time_point{std::chrono::seconds{1700000000}};
+    e.encounterType = "visit";
+    e.clinicalData = nlohmann::json::object();
+    e.clinicalData["notes"] = std::string(payloadBytes, 'x');
+    return e;
+}
+
+}  // namespace
+
+TEST_CASE("CachingEncounterRepository serves repeat reads from cache") {
+    CountingEncounterRepository backing;
+    backing.inner.Create(MakeEncounter("enc-1"));
+    encounter_service::storage::CachingEncounterRepository cache(backing);
+
+    REQUIRE(cache.GetById("enc-1").has_value());
+    REQUIRE(cache.GetById("enc-1")->encounterId == "enc-1");
+    REQUIRE(!cache.GetById("missing").has_value());
+    REQUIRE(backing.getByIdCalls == 2);
+
+    const auto stats = cache.stats();
+    REQUIRE(stats.hits == 1);
+    REQUIRE(stats.misses == 2);
+    REQUIRE(stats.entries == 1);
+    REQUIRE(stats.bytes > 0);
+}
+
+TEST_CASE("CachingEncounterRepository hands out copies that do not alias the cached entry") {
+    CountingEncounterRepository backing;
+    backing.inner.Create(MakeEncounter("enc-1"));
+    encounter_service::storage::CachingEncounterRepository cache(backing);
+
+    auto first = cache.GetById("enc-1");
+    REQUIRE(first.has_value());
+    first->encounterType = "changed";
+    auto batch = cache.GetByIds({"enc-1"});
+    REQUIRE(batch[0].has_value());
+    batch[0]->clinicalData["notes"] = std::string("changed");
+
+    const auto again = cache.GetById("enc-1");
+    REQUIRE(again->encounterType == "visit");
+    REQUIRE(again->clinicalData == MakeEncounter("enc-1").clinicalData);
+    REQUIRE(backing.getByIdCalls == 1);
+}
+
+TEST_CASE("CachingEncounterRepository Create writes through and invalidates the cached copy") {
+    CountingEncounterRepository backing;
+    encounter_service::storage::CachingEncounterRepository cache(backing);
+
+    cache.Create(MakeEncounter("enc-1"));
+    REQUIRE(cache.GetById("enc-1")->encounterType == "visit");
+    REQUIRE(cache.stats().entries == 1);
+
+    auto updated = MakeEncounter("enc-1");
+    updated.encounterType = "follow-up";
+    cache.Create(updated);
+    REQUIRE(cache.stats().entries == 0);
+
+    REQUIRE(backing.inner.GetById("enc-1")->encounterType == "follow-up");
+    REQUIRE(cache.GetById("enc-1")->encounterType == "follow-up");
+    REQUIRE(backing.getByIdCalls == 2);
+}
+
+TEST_CASE("CachingEncounterRepository evicts least recently used entries by byte budget") {
+    CountingEncounterRepository backing;
+    encounter_service::storage::EncounterCacheOptions options{};
+    options.shardCount = 1;
+    options.maxBytes = 3 * 1024;
+    encounter_service::storage::CachingEncounterRepository cache(backing, options);
+
+    backing.inner.Create(MakeEncounter("enc-1", 900));
+    backing.inner.Create(MakeEncounter("enc-2", 900));
+    backing.inner.Create(MakeEncounter("enc-3", 900));
+    backing.inner.Create(MakeEncounter("enc-huge", 8 * 1024));
+
+    REQUIRE(cache.GetById("enc-1").has_value());
+    REQUIRE(cache.GetById("enc-2").has_value());
+    REQUIRE(cache.GetById("enc-1").has_value());  // enc-2 becomes least recently used
+    REQUIRE(cache.GetById("enc-3").has_value());
+    REQUIRE(backing.getByIdCalls == 3);
+
+    const auto stats = cache.stats();
+    REQUIRE(stats.evictions == 1);
+    REQUIRE(stats.entries == 2);
+    REQUIRE(stats.bytes <= options.maxBytes);
+
+    REQUIRE(cache.GetById("enc-1").has_value());
+    REQUIRE(backing.getByIdCalls == 3);
+    REQUIRE(cache.GetById("enc-2").has_value());
+    REQUIRE(backing.getByIdCalls == 4);
+
+    // Entries larger than the whole budget are served but never cached.
+    REQUIRE(cache.GetById("enc-huge").has_value());
+    REQUIRE(cache.GetById("enc-huge").has_value());
+    REQUIRE(backing.getByIdCalls == 6);
+}
+
+TEST_CASE("CachingEncounterRepository GetByIds fetches only misses in one backing call") {
+    CountingEncounterRepository backing;
+    backing.inner.Create(MakeEncounter("enc-1"));
+    backing.inner.Create(MakeEncounter("enc-2"));
+    encounter_service::storage::CachingEncounterRepository cache(backing);
+    REQUIRE(cache.GetById("enc-1").has_value());
+
+    const auto found = cache.GetByIds({"enc-2", "enc-1", "missing"});
+    REQUIRE(found.size() == 3);
+    REQUIRE(found[0]->encounterId == "enc-2");
+    REQUIRE(found[1]->encounterId == "enc-1");
+    REQUIRE(!found[2].has_value());
+    REQUIRE(backing.getByIdsCalls == 1);
+    REQUIRE(backing.lastGetByIds.size() == 2);
+    REQUIRE(backing.lastGetByIds[0] == "enc-2");
+    REQUIRE(backing.lastGetByIds[1] == "missing");
+    REQUIRE(cache.stats().entries == 2);
+}
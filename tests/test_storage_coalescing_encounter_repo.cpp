@@ -0,0 +1,259 @@
+#include "tests/catch_compat.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "src/storage/coalescing_encounter_repo.h"
+#include "src/storage/in_memory_encounter_repo.h"
+
+namespace {
+
+// Backing repository whose Query() blocks until released, so tests can pile callers onto one execution.
+class GatedEncounterRepository final : public encounter_service::storage::EncounterRepository {
+public:
+    encounter_service::domain::Encounter Create(encounter_service::domain::Encounter encounter) override {
+        return inner.Create(std::move(encounter));
+    }
+
+    std::optional<encounter_service::domain::Encounter> GetById(const std::string& encounterId) const override {
+        return inner.GetById(encounterId);
+    }
+
+    std::vector<std::optional<encounter_service::domain::Encounter>> GetByIds(
+        const std::vector<std::string>& encounterIds) const override {
+        return inner.GetByIds(encounterIds);
+    }
+
+    std::vector<encounter_service::domain::Encounter> Query(
+        const encounter_service::storage::EncounterQueryFilters& filters,
+        const encounter_service::util::RequestContext& context) const override {
+        std::unique_lock lock(mutex);
+        ++queryCalls;
+        entered.notify_all();
+        released.wait(lock, [&]() { return open; });
+        context.ThrowIfDone();
+        if (fail) {
+            throw std::runtime_error("backend unavailable");
+        }
+        return inner.Query(filters, context);
+    }
+
+    std::uint64_t WriteGeneration() const override {
+        return inner.WriteGeneration();
+    }
+
+    void WaitForQueryCalls(int calls) const {
+        std::unique_lock lock(mutex);
+        entered.wait(lock, [&]() { return queryCalls >= calls; });
+    }
+
+    void Release() {
+        std::lock_guard lock(mutex);
+        open = true;
+        released.notify_all();
+    }
+
+    encounter_service::storage::InMemoryEncounterRepository inner;
+    mutable std::mutex mutex;
+    mutable std::condition_variable entered;
+    mutable std::condition_variable released;
+    mutable int queryCalls{0};
+    bool open{false};
+    bool fail{false};
+};
+
+encounter_service::domain::Encounter MakeEncounter(const std::string& id, const std::string& providerId) {
+    encounter_service::domain::Encounter e{};
+    e.encounterId = id;
+    e.patientId = "patient-1";
+    e.providerId = providerId;
+    e.encounterDate = std::chrono::system_clock::time_point{std::chrono::seconds{1700000000}};
+    e.encounterType = "visit";
+    e.clinicalData = nlohmann::json::object();
+    return e;
+}
+
+void WaitForCoalesced(const encounter_service::storage::CoalescingEncounterRepository& repo, std::uint64_t count) {
+    while (repo.stats().coalesced < count) {
+        std::this_thread::yield();
+    }
+}
+
+}  // namespace
+
+TEST_CASE("NormalizeQueryFilters distinguishes absent, empty, and shifted values") {
+    using encounter_service::storage::EncounterQueryFilters;
+    using encounter_service::storage::NormalizeQueryFilters;
+
+    EncounterQueryFilters absent{};
+    EncounterQueryFilters empty{};
+    empty.patientId = "";
+    REQUIRE(NormalizeQueryFilters(absent) != NormalizeQueryFilters(empty));
+
+    EncounterQueryFilters patient{};
+    patient.patientId = "p1";
+    EncounterQueryFilters provider{};
+    provider.providerId = "p1";
+    REQUIRE(NormalizeQueryFilters(patient) != NormalizeQueryFilters(provider));
+
+    EncounterQueryFilters paged = patient;
+    paged.offset = 100;
+    REQUIRE(NormalizeQueryFilters(patient) != NormalizeQueryFilters(paged));
+
+    EncounterQueryFilters same = patient;
+    REQUIRE(NormalizeQueryFilters(patient) == NormalizeQueryFilters(same));
+}
+
+TEST_CASE("CoalescingEncounterRepository shares one execution across identical concurrent queries") {
+    GatedEncounterRepository backing;
+    backing.inner.Create(MakeEncounter("enc-1", "provider-1"));
+    backing.inner.Create(MakeEncounter("enc-2", "provider-2"));
+    encounter_service::storage::CoalescingEncounterRepository repo(backing);
+
+    encounter_service::storage::EncounterQueryFilters filters{};
+    filters.providerId = "provider-1";
+
+    constexpr int kCallers = 4;
+    std::vector<std::vector<encounter_service::domain::Encounter>> results(kCallers);
+    std::vector<std::thread> callers;
+    callers.emplace_back([&]() { results[0] = repo.Query(filters, {}); });
+    backing.WaitForQueryCalls(1);
+    for (int i = 1; i < kCallers; ++i) {
+        callers.emplace_back([&, i]() { results[i] = repo.Query(filters, {}); });
+    }
+    WaitForCoalesced(repo, kCallers - 1);
+    backing.Release();
+    for (auto& caller : callers) {
+        caller.join();
+    }
+
+    REQUIRE(backing.queryCalls == 1);
+    for (const auto& result : results) {
+        REQUIRE(result.size() == 1);
+        REQUIRE(result[0].encounterId == "enc-1");
+    }
+    const auto stats = repo.stats();
+    REQUIRE(stats.executions == 1);
+    REQUIRE(stats.coalesced == kCallers - 1);
+
+    // Nothing is retained once the flight lands: the next call executes again.
+    REQUIRE(repo.Query(filters, {}).size() == 1);
+    REQUIRE(backing.queryCalls == 2);
+    REQUIRE(repo.stats().executions == 2);
+}
+
+TEST_CASE("CoalescingEncounterRepository hands waiters the leader's rows without copying them") {
+    GatedEncounterRepository backing;
+    backing.inner.Create(MakeEncounter("enc-1", "provider-1"));
+    encounter_service::storage::CoalescingEncounterRepository repo(backing);
+
+    encounter_service::storage::EncounterQueryFilters filters{};
+    constexpr int kCallers = 3;
+    std::vector<encounter_service::storage::SharedEncounters> results(kCallers);
+    std::vector<std::thread> callers;
+    callers.emplace_back([&]() { results[0] = repo.QueryShared(filters, {}); });
+    backing.WaitForQueryCalls(1);
+    for (int i = 1; i < kCallers; ++i) {
+        callers.emplace_back([&, i]() { results[i] = repo.QueryShared(filters, {}); });
+    }
+    WaitForCoalesced(repo, kCallers - 1);
+    backing.Release();
+    for (auto& caller : callers) {
+        caller.join();
+    }
+
+    REQUIRE(backing.queryCalls == 1);
+    REQUIRE(results[0] != nullptr);
+    REQUIRE(results[0]->size() == 1);
+    for (const auto& result : results) {
+        REQUIRE(result.get() == results[0].get());
+    }
+}
+
+TEST_CASE("CoalescingEncounterRepository propagates a failed execution to every waiter") {
+    GatedEncounterRepository backing;
+    backing.fail = true;
+    encounter_service::storage::CoalescingEncounterRepository repo(backing);
+
+    encounter_service::storage::EncounterQueryFilters filters{};
+    std::atomic<int> failures{0};
+    auto run = [&]() {
+        try {
+            (void)repo.Query(filters, {});
+        } catch (const std::runtime_error&) {
+            failures.fetch_add(1);
+        }
+    };
+
+    std::thread leader(run);
+    backing.WaitForQueryCalls(1);
+    std::thread waiter(run);
+    WaitForCoalesced(repo, 1);
+    backing.Release();
+    leader.join();
+    waiter.join();
+
+    REQUIRE(failures.load() == 2);
+    REQUIRE(backing.queryCalls == 1);
+}
+
+TEST_CASE("CoalescingEncounterRepository re-runs for waiters when the leader is cancelled") {
+    GatedEncounterRepository backing;
+    backing.inner.Create(MakeEncounter("enc-1", "provider-1"));
+    encounter_service::storage::CoalescingEncounterRepository repo(backing);
+
+    encounter_service::storage::EncounterQueryFilters filters{};
+    const encounter_service::util::RequestContext leaderContext(std::nullopt);
+    bool leaderCancelled = false;
+    std::vector<encounter_service::domain::Encounter> waiterResult;
+
+    std::thread leader([&]() {
+        try {
+            (void)repo.Query(filters, leaderContext);
+        } catch (const encounter_service::util::RequestCancelled&) {
+            leaderCancelled = true;
+        }
+    });
+    backing.WaitForQueryCalls(1);
+    std::thread waiter([&]() { waiterResult = repo.Query(filters, {}); });
+    WaitForCoalesced(repo, 1);
+    leaderContext.Cancel();
+    backing.Release();
+    leader.join();
+    waiter.join();
+
+    REQUIRE(leaderCancelled);
+    REQUIRE(waiterResult.size() == 1);
+    REQUIRE(backing.queryCalls == 2);
+}
+
+TEST_CASE("CoalescingEncounterRepository waiters give up at their own deadline") {
+    GatedEncounterRepository backing;
+    encounter_service::storage::CoalescingEncounterRepository repo(backing);
+
+    encounter_service::storage::EncounterQueryFilters filters{};
+    std::thread leader([&]() { (void)repo.Query(filters, {}); });
+    backing.WaitForQueryCalls(1);
+
+    const encounter_service::util::RequestContext shortDeadline(std::chrono::steady_clock::now() +
+                                                                std::chrono::milliseconds{30});
+    bool timedOut = false;
+    try {
+        (void)repo.Query(filters, shortDeadline);
+    } catch (const encounter_service::util::RequestCancelled& cancelled) {
+        timedOut = cancelled.reason() == encounter_service::util::RequestCancelled::Reason::DeadlineExceeded;
+    }
+    backing.Release();
+    leader.join();
+
+    REQUIRE(timedOut);
+    REQUIRE(backing.queryCalls == 1);
+}
@@ -0,0 +1,370 @@
+#include "tests/catch_compat.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "src/storage/compact_audit_log.h"
+#include "src/storage/string_interner.h"
+
+namespace {
+
+encounter_service::domain::AuditEntry MakeAudit(std::chrono::system_clock::time_point ts,
+                                                std::string actor,
+                                                std::string encounterId,
+                                                encounter_service::domain::AuditAction action = encounter_service::domain::AuditAction::READ_ENCOUNTER) {
+    return encounter_service::domain::AuditEntry{
+        .timestamp = ts,
+        .actor = std::move(actor),
+        .action = action,
+        .encounterId = std::move(encounterId)
+    };
+}
+
+}  // namespace
+
+TEST_CASE("StringInterner assigns dense stable ids") {
+    encounter_service::storage::StringInterner interner;
+    const auto a = interner.Intern("actor-a");
+    const auto b = interner.Intern("actor-b");
+    REQUIRE(a == 0);
+    REQUIRE(b == 1);
+    REQUIRE(interner.Intern("actor-a") == a);
+    REQUIRE(interner.size() == 2);
+    REQUIRE(interner.Resolve(b) == "actor-b");
+    REQUIRE(interner.Find("actor-b") == b);
+    REQUIRE(!interner.Find("missing").has_value());
+}
+
+TEST_CASE("CompactAuditLog stores 16 bytes of column data per entry") {
+    REQUIRE(encounter_service::storage::CompactAuditLog::BytesPerEntry() == 16);
+}
+
+TEST_CASE("CompactAuditLog rehydrates actor, action and encounterId") {
+    using namespace std::chrono;
+    encounter_service::storage::CompactAuditLog log;
+    const auto t = system_clock::time_point{seconds{1700000000} + microseconds{42}};
+    log.Append(MakeAudit(t, "clinician-a", "enc-1", encounter_service::domain::AuditAction::CREATE_ENCOUNTER));
+    log.Append(MakeAudit(t + seconds{1}, "clinician-a", "enc-1"));
+
+    const auto results = log.Query({});
+    REQUIRE(log.size() == 2);
+    REQUIRE(results.size() == 2);
+    REQUIRE(results[0].timestamp == t);
+    REQUIRE(results[0].actor == "clinician-a");
+    REQUIRE(results[0].action == encounter_service::domain::AuditAction::CREATE_ENCOUNTER);
+    REQUIRE(results[0].encounterId == "enc-1");
+    REQUIRE(results[1].action == encounter_service::domain::AuditAction::READ_ENCOUNTER);
+}
+
+TEST_CASE("CompactAuditLog range scan handles out-of-order appends") {
+    using namespace std::chrono;
+    encounter_service::storage::CompactAuditLog log;
+    log.Append(MakeAudit(system_clock::time_point{seconds{30}}, "a", "enc-3"));
+    log.Append(MakeAudit(system_clock::time_point{seconds{10}}, "a", "enc-1"));
+    log.Append(MakeAudit(system_clock::time_point{seconds{20}}, "a", "enc-2"));
+
+    encounter_service::storage::AuditDateRange range{};
+    range.from = system_clock::time_point{seconds{10}};
+    range.to = system_clock::time_point{seconds{20}};
+    const auto results = log.Query(range);
+    REQUIRE(results.size() == 2);
+    REQUIRE(results[0].encounterId == "enc-1");
+    REQUIRE(results[1].encounterId == "enc-2");
+}
+
+TEST_CASE("CompactAuditLog returns nothing for an inverted range") {
+    using namespace std::chrono;
+    encounter_service::storage::CompactAuditLog log;
+    log.Append(MakeAudit(system_clock::time_point{seconds{10}}, "a", "enc-1"));
+
+    encounter_service::storage::AuditDateRange range{};
+    range.from = system_clock::time_point{seconds{20}};
+    range.to = system_clock::time_point{seconds{10}};
+    REQUIRE(log.Query(range).empty());
+}
+
+TEST_CASE("ArchivedAuditSegment round-trips records and decodes only the requested range") {
+    std::vector<encounter_service::storage::PackedAuditRecord> records;
+    for (std::uint32_t i = 0; i < 1000; ++i) {
+        records.push_back(encounter_service::storage::PackedAuditRecord{
+            .ticks = 1'700'000'000'000'000'000 + static_cast<std::int64_t>(i) * 1'000'000,
+            .actorAction = i % 3,
+            .encounterKey = i / 2
+        });
+    }
+
+    const auto archived = encounter_service::storage::ArchivedAuditSegment::Encode(records, 64);
+    REQUIRE(archived.size() == 1000);
+    REQUIRE(archived.minTicks() == records.front().ticks);
+    REQUIRE(archived.maxTicks() == records.back().ticks);
+    REQUIRE(archived.encodedBytes() * 2 < records.size() * sizeof(encounter_service::storage::PackedAuditRecord));
+
+    std::vector<encounter_service::storage::PackedAuditRecord> decoded;
+    archived.DecodeRange(records[100].ticks, records[199].ticks, decoded);
+    REQUIRE(decoded.size() == 100);
+    REQUIRE(decoded.front().ticks == records[100].ticks);
+    REQUIRE(decoded.front().encounterKey == records[100].encounterKey);
+    REQUIRE(decoded.back().actorAction == records[199].actorAction);
+}
+
+TEST_CASE("CompactAuditLog archives cold sealed segments without changing query results") {
+    using namespace std::chrono;
+    encounter_service::storage::CompactAuditLogOptions options{};
+    options.segmentCapacity = 4;
+    options.archiveAfter = hours{1};
+    options.archiveBlockRows = 2;
+    encounter_service::storage::CompactAuditLog log(options);
+
+    const auto base = system_clock::time_point{seconds{1700000000}};
+    for (int i = 0; i < 8; ++i) {
+        log.Append(MakeAudit(base + seconds{i}, "a", "enc-" + std::to_string(i)));
+    }
+    log.Append(MakeAudit(base + hours{72}, "a", "enc-late"));
+    log.Append(MakeAudit(base + hours{72}, "a", "enc-late"));
+    log.Append(MakeAudit(base + hours{72}, "a", "enc-late"));
+    log.Append(MakeAudit(base + hours{72}, "a", "enc-late"));
+
+    // The two sealed early segments are cold three days later; the late one is not.
+    REQUIRE(log.ArchiveColdSegments(base + hours{72}) == 2);
+    const auto stats = log.stats();
+    REQUIRE(stats.archivedSegments == 2);
+    REQUIRE(stats.archivedEntries == 8);
+    REQUIRE(stats.hotEntries == 4);
+    REQUIRE(log.size() == 12);
+
+    encounter_service::storage::AuditDateRange range{};
+    range.from = base + seconds{3};
+    range.to = base + seconds{5};
+    const auto results = log.Query(range);
+    REQUIRE(results.size() == 3);
+    REQUIRE(results[0].encounterId == "enc-3");
+    REQUIRE(results[2].encounterId == "enc-5");
+    REQUIRE(log.Query({}).size() == 12);
+}
+
+TEST_CASE("CompactAuditLog archives only segments that end at or before the given position") {
+    using namespace std::chrono;
+    encounter_service::storage::CompactAuditLogOptions options{};
+    options.segmentCapacity = 2;
+    encounter_service::storage::CompactAuditLog log(options);
+
+    const auto base = system_clock::time_point{seconds{1700000000}};
+    for (int i = 0; i < 4; ++i) {
+        log.Append(MakeAudit(base + seconds{i}, "a", "enc-" + std::to_string(i)));
+    }
+
+    // Both sealed segments are cold, but only the first ends by position 3.
+    REQUIRE(log.ArchiveSegmentsOlderThan(base + hours{1}, nullptr, 3) == 1);
+    REQUIRE(log.stats().archivedEntries == 2);
+    REQUIRE(log.ArchiveSegmentsOlderThan(base + hours{1}, nullptr, 4) == 1);
+    REQUIRE(log.Query({}).size() == 4);
+}
+
+TEST_CASE("CompactAuditLog supports concurrent appends while queries read the published prefix") {
+    using namespace std::chrono;
+    encounter_service::storage::CompactAuditLogOptions options{};
+    options.segmentCapacity = 64;
+    encounter_service::storage::CompactAuditLog log(options);
+
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 2000;
+    const auto base = system_clock::time_point{seconds{1700000000}};
+    std::atomic<bool> done{false};
+    std::atomic<bool> prefixShrank{false};
+
+    std::thread reader([&]() {
+        std::size_t previous = 0;
+        while (!done.load()) {
+            const auto seen = log.Query({}).size();
+            if (seen < previous) {
+                prefixShrank.store(true);
+            }
+            previous = seen;
+        }
+    });
+
+    std::vector<std::thread> writers;
+    for (int t = 0; t < kThreads; ++t) {
+        writers.emplace_back([&, t]() {
+            for (int i = 0; i < kPerThread; ++i) {
+                log.Append(MakeAudit(base + milliseconds{i}, "actor-" + std::to_string(t), "enc-" + std::to_string(i % 50)));
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    done.store(true);
+    reader.join();
+
+    REQUIRE(!prefixShrank.load());
+    REQUIRE(log.size() == kThreads * kPerThread);
+
+    std::map<std::string, int> perActor;
+    for (const auto& entry : log.Query({})) {
+        ++perActor[entry.actor];
+    }
+    REQUIRE(perActor.size() == kThreads);
+    for (const auto& [actor, count] : perActor) {
+        REQUIRE(count == kPerThread);
+    }
+
+    REQUIRE(log.ArchiveSegmentsOlderThan(base + hours{1}) == (kThreads * kPerThread) / 64);
+    REQUIRE(log.Query({}).size() == kThreads * kPerThread);
+}
+
+TEST_CASE("CompactAuditLog stores a bulk record in one row and survives archival") {
+    using namespace std::chrono;
+    encounter_service::storage::CompactAuditLogOptions options{};
+    options.segmentCapacity = 2;
+    encounter_service::storage::CompactAuditLog log(options);
+    const auto t = system_clock::time_point{seconds{100}};
+
+    log.AppendBulk(encounter_service::domain::BulkAuditEntry{
+        .timestamp = t,
+        .actor = "lister",
+        .action = encounter_service::domain::AuditAction::LIST_ENCOUNTERS,
+        .encounterIds = {"enc-9", "enc-1", "enc-5"}
+    });
+    log.Append(MakeAudit(t + seconds{1}, "reader", "enc-1"));
+    REQUIRE(log.size() == 2);
+    REQUIRE(log.ArchiveSegmentsOlderThan(t + hours{1}) == 1);
+
+    const auto results = log.Query({});
+    REQUIRE(results.size() == 4);
+    REQUIRE(results[0].encounterId == "enc-1");
+    REQUIRE(results[0].action == encounter_service::domain::AuditAction::LIST_ENCOUNTERS);
+    REQUIRE(results[1].encounterId == "enc-5");
+    REQUIRE(results[2].encounterId == "enc-9");
+    REQUIRE(results[3].action == encounter_service::domain::AuditAction::READ_ENCOUNTER);
+}
+
+TEST_CASE("CompactAuditLog expands bulk READ records without confusing them with single reads") {
+    using namespace std::chrono;
+    encounter_service::storage::CompactAuditLog log;
+    const auto t = system_clock::time_point{seconds{100}};
+
+    log.Append(MakeAudit(t, "reader", "enc-1"));
+    log.AppendBulk(encounter_service::domain::BulkAuditEntry{
+        .timestamp = t + seconds{1},
+        .actor = "reader",
+        .action = encounter_service::domain::AuditAction::READ_ENCOUNTER,
+        .encounterIds = {"enc-2", "enc-1"}
+    });
+    REQUIRE(log.size() == 2);
+
+    const auto results = log.Query({});
+    REQUIRE(results.size() == 3);
+    REQUIRE(results[0].encounterId == "enc-1");
+    REQUIRE(results[1].encounterId == "enc-1");
+    REQUIRE(results[2].encounterId == "enc-2");
+    for (const auto& result : results) {
+        REQUIRE(result.action == encounter_service::domain::AuditAction::READ_ENCOUNTER);
+        REQUIRE(result.actor == "reader");
+    }
+}
+
+TEST_CASE("CompactAuditLog keeps reading its published prefix after the segment directory fills") {
+    using namespace std::chrono;
+    encounter_service::storage::CompactAuditLogOptions options{};
+    options.segmentCapacity = 2;
+    options.maxSegments = 1;
+    encounter_service::storage::CompactAuditLog log(options);
+    const auto t = system_clock::time_point{seconds{100}};
+
+    log.Append(MakeAudit(t, "reader", "enc-1"));
+    log.Append(MakeAudit(t, "reader", "enc-2"));
+    bool threw = false;
+    try {
+        log.Append(MakeAudit(t, "reader", "enc-3"));
+    } catch (const std::length_error&) {
+        threw = true;
+    }
+    REQUIRE(threw);
+
+    // The rejected append reserved nothing, so the published prefix stays contiguous.
+    REQUIRE(log.size() == 2);
+    REQUIRE(log.Query({}).size() == 2);
+    std::size_t visited = 0;
+    REQUIRE(log.VisitPublished(0, [&visited](const encounter_service::storage::AuditRecordView&) { ++visited; }) == 2);
+    REQUIRE(visited == 2);
+}
+
+TEST_CASE("CompactAuditLog reuses directory slots once their segments are archived") {
+    using namespace std::chrono;
+    encounter_service::storage::CompactAuditLogOptions options{};
+    options.segmentCapacity = 2;
+    options.maxSegments = 2;
+    encounter_service::storage::CompactAuditLog log(options);
+    const auto t = system_clock::time_point{seconds{100}};
+
+    // Ten segments through a two-slot directory, archiving as the slots fill up.
+    for (int i = 0; i < 20; ++i) {
+        if (i > 0 && i % 4 == 0) {
+            REQUIRE(log.ArchiveSegmentsOlderThan(t + hours{1}) == 2);
+        }
+        log.Append(MakeAudit(t + seconds{i}, "reader", "enc-" + std::to_string(i)));
+    }
+
+    // Both slots hold unarchived segments again, so the next append is refused until archival.
+    bool threw = false;
+    try {
+        log.Append(MakeAudit(t + seconds{20}, "reader", "enc-20"));
+    } catch (const std::length_error&) {
+        threw = true;
+    }
+    REQUIRE(threw);
+    REQUIRE(log.size() == 20);
+    REQUIRE(log.ArchiveSegmentsOlderThan(t + hours{1}) == 2);
+    log.Append(MakeAudit(t + seconds{20}, "reader", "enc-20"));
+
+    const auto stats = log.stats();
+    REQUIRE(stats.archivedSegments == 10);
+    REQUIRE(stats.hotEntries == 1);
+    const auto results = log.Query({});
+    REQUIRE(results.size() == 21);
+    REQUIRE(results.front().encounterId == "enc-0");
+    REQUIRE(results.back().encounterId == "enc-20");
+}
+
+TEST_CASE("CompactAuditLog moves bulk payloads into the archive with their segment") {
+    using namespace std::chrono;
+    encounter_service::storage::CompactAuditLogOptions options{};
+    options.segmentCapacity = 2;
+    options.maxSegments = 1;
+    encounter_service::storage::CompactAuditLog log(options);
+    const auto t = system_clock::time_point{seconds{100}};
+    const auto bulk = [&](int second, std::vector<std::string> ids) {
+        log.AppendBulk(encounter_service::domain::BulkAuditEntry{
+            .timestamp = t + seconds{second},
+            .actor = "reader",
+            .action = encounter_service::domain::AuditAction::READ_ENCOUNTER,
+            .encounterIds = std::move(ids)
+        });
+    };
+
+    // Each segment's payloads go with it, so a one-slot directory keeps accepting bulk rows.
+    bulk(0, {"enc-1", "enc-2"});
+    bulk(1, {"enc-3"});
+    REQUIRE(log.ArchiveSegmentsOlderThan(t + hours{1}) == 1);
+    REQUIRE(log.stats().archivedBytes > 0);
+    bulk(2, {"enc-4", "enc-5", "enc-6"});
+
+    std::vector<std::size_t> counts;
+    REQUIRE(log.VisitPublished(2, [&counts](const encounter_service::storage::AuditRecordView& record) {
+        counts.push_back(record.encounterCount);
+    }) == 3);
+    REQUIRE(counts == std::vector<std::size_t>{3});
+
+    const auto results = log.Query({});
+    REQUIRE(results.size() == 6);
+    REQUIRE(results[0].encounterId == "enc-1");
+    REQUIRE(results[2].encounterId == "enc-3");
+    REQUIRE(results[5].encounterId == "enc-6");
+}
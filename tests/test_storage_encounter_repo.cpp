@@ -31,6 +31,19 @@ TEST_CASE("InMemoryEncounterRepository GetById returns missing for unknown id")
     REQUIRE(!repo.GetById("missing").has_value());
 }
 
+TEST_CASE("InMemoryEncounterRepository GetByIds returns slots in request order") {
+    using namespace std::chrono;
+    encounter_service::storage::InMemoryEncounterRepository repo;
+    repo.Create(MakeEncounter("enc-1", "patient-1", "provider-1", system_clock::time_point{seconds{1700000000}}));
+    repo.Create(MakeEncounter("enc-2", "patient-1", "provider-1", system_clock::time_point{seconds{1700000100}}));
+
+    const auto found = repo.GetByIds({"enc-2", "missing", "enc-1"});
+    REQUIRE(found.size() == 3);
+    REQUIRE(found[0]->encounterId == "enc-2");
+    REQUIRE(!found[1].has_value());
+    REQUIRE(found[2]->encounterId == "enc-1");
+}
+
 TEST_CASE("InMemoryEncounterRepository Query filters by encounterType") {
     using namespace std::chrono;
     encounter_service::storage::InMemoryEncounterRepository repo;
@@ -39,7 +52,7 @@ TEST_CASE("InMemoryEncounterRepository Query filters by encounterType") {
 
     encounter_service::storage::EncounterQueryFilters filters{};
     filters.encounterType = "lab";
-    const auto results = repo.Query(filters);
+    const auto results = repo.Query(filters, {});
     REQUIRE(results.size() == 1);
     REQUIRE(results[0].encounterId == "enc-2");
 }
@@ -56,7 +69,7 @@ TEST_CASE("InMemoryEncounterRepository Query applies limit and offset after sort
     filters.offset = 1;
     filters.limit = 2;
 
-    const auto results = repo.Query(filters);
+    const auto results = repo.Query(filters, {});
     REQUIRE(results.size() == 2);
     REQUIRE(results[0].encounterId == "enc-a");
     REQUIRE(results[1].encounterId == "enc-b");
@@ -0,0 +1,173 @@
+#include "tests/catch_compat.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "src/storage/in_memory_encounter_repo.h"
+#include "src/storage/query_caching_encounter_repo.h"
+
+namespace {
+
+class CountingEncounterRepository final : public encounter_service::storage::EncounterRepository {
+public:
+    encounter_service::domain::Encounter Create(encounter_service::domain::Encounter encounter) override {
+        return inner.Create(std::move(encounter));
+    }
+
+    std::optional<encounter_service::domain::Encounter> GetById(const std::string& encounterId) const override {
+        return inner.GetById(encounterId);
+    }
+
+    std::vector<std::optional<encounter_service::domain::Encounter>> GetByIds(
+        const std::vector<std::string>& encounterIds) const override {
+        return inner.GetByIds(encounterIds);
+    }
+
+    std::vector<encounter_service::domain::Encounter> Query(
+        const encounter_service::storage::EncounterQueryFilters& filters,
+        const encounter_service::util::RequestContext& context) const override {
+        ++queryCalls;
+        return inner.Query(filters, context);
+    }
+
+    std::uint64_t WriteGeneration() const override {
+        return inner.WriteGeneration();
+    }
+
+    encounter_service::storage::InMemoryEncounterRepository inner;
+    mutable int queryCalls{0};
+};
+
+constexpr std::int64_t kDay0 = 1700006400;  // 2023-11-15T00:00:00Z
+constexpr std::int64_t kSecondsPerDay = 86400;
+
+std::chrono::system_clock::time_point Day(int day, int hour = 12) {
+    return std::chrono::system_clock::time_point{std::chrono::seconds{kDay0 + day * kSecondsPerDay + hour * 3600}};
+}
+
+encounter_service::domain::Encounter MakeEncounter(const std::string& id, int day, std::size_t payloadBytes = 0) {
+    encounter_service::domain::Encounter e{};
+    e.encounterId = id;
+    e.patientId = "patient-1";
+    e.providerId = "provider-1";
+    e.encounterDate = Day(day);
+    e.encounterType = "visit";
+    e.clinicalData = nlohmann::json::object();
+    e.clinicalData["notes"] = std::string(payloadBytes, 'x');
+    return e;
+}
+
+encounter_service::storage::EncounterQueryFilters RangeFilters(int fromDay, int toDay) {
+    encounter_service::storage::EncounterQueryFilters filters{};
+    filters.encounterDateFrom = Day(fromDay, 0);
+    filters.encounterDateTo = Day(toDay, 23);
+    return filters;
+}
+
+}  // namespace
+
+TEST_CASE("QueryCachingEncounterRepository serves repeated queries from cache") {
+    CountingEncounterRepository backing;
+    encounter_service::storage::QueryCachingEncounterRepository repo(backing);
+    repo.Create(MakeEncounter("enc-1", 0));
+    repo.Create(MakeEncounter("enc-2", 1));
+
+    const auto filters = RangeFilters(0, 1);
+    REQUIRE(repo.Query(filters, {}).size() == 2);
+    const auto again = repo.Query(filters, {});
+    REQUIRE(again.size() == 2);
+    REQUIRE(again[0].encounterId == "enc-1");
+    REQUIRE(backing.queryCalls == 1);
+
+    // Pagination is part of the key.
+    auto paged = filters;
+    paged.offset = 1;
+    REQUIRE(repo.Query(paged, {}).size() == 1);
+    REQUIRE(backing.queryCalls == 2);
+
+    const auto stats = repo.stats();
+    REQUIRE(stats.hits == 1);
+    REQUIRE(stats.misses == 2);
+    REQUIRE(stats.entries == 2);
+    REQUIRE(stats.bytes > 0);
+}
+
+TEST_CASE("QueryCachingEncounterRepository shares cached result sets instead of copying them") {
+    CountingEncounterRepository backing;
+    encounter_service::storage::QueryCachingEncounterRepository repo(backing);
+    repo.Create(MakeEncounter("enc-1", 0, 1024));
+
+    const auto filters = RangeFilters(0, 0);
+    const auto first = repo.QueryShared(filters, {});
+    const auto second = repo.QueryShared(filters, {});
+    REQUIRE(first->size() == 1);
+    REQUIRE(second.get() == first.get());
+    REQUIRE(backing.queryCalls == 1);
+
+    // A write to the covered day replaces the entry; holders of the old rows keep them.
+    repo.Create(MakeEncounter("enc-2", 0));
+    const auto third = repo.QueryShared(filters, {});
+    REQUIRE(third.get() != first.get());
+    REQUIRE(third->size() == 2);
+    REQUIRE(first->size() == 1);
+}
+
+TEST_CASE("QueryCachingEncounterRepository only invalidates entries covering the written day") {
+    CountingEncounterRepository backing;
+    encounter_service::storage::QueryCachingEncounterRepository repo(backing);
+    repo.Create(MakeEncounter("enc-old", 0));
+
+    const auto historical = RangeFilters(0, 1);
+    const auto recent = RangeFilters(10, 11);
+    encounter_service::storage::EncounterQueryFilters unbounded{};
+    REQUIRE(repo.Query(historical, {}).size() == 1);
+    REQUIRE(repo.Query(recent, {}).empty());
+    REQUIRE(repo.Query(unbounded, {}).size() == 1);
+    REQUIRE(backing.queryCalls == 3);
+
+    repo.Create(MakeEncounter("enc-new", 10));
+
+    // The historical range does not cover day 10 and is still served from cache.
+    REQUIRE(repo.Query(historical, {}).size() == 1);
+    REQUIRE(backing.queryCalls == 3);
+    // Ranges covering day 10 observe the new encounter.
+    REQUIRE(repo.Query(recent, {}).size() == 1);
+    REQUIRE(repo.Query(unbounded, {}).size() == 2);
+    REQUIRE(backing.queryCalls == 5);
+
+    const auto stats = repo.stats();
+    REQUIRE(stats.invalidations == 2);
+    REQUIRE(stats.hits == 1);
+}
+
+TEST_CASE("QueryCachingEncounterRepository evicts least recently used results past the byte budget") {
+    CountingEncounterRepository backing;
+    encounter_service::storage::QueryCacheOptions options{};
+    options.maxBytes = 12 * 1024;
+    encounter_service::storage::QueryCachingEncounterRepository repo(backing, options);
+    repo.Create(MakeEncounter("enc-0", 0, 4096));
+    repo.Create(MakeEncounter("enc-1", 1, 4096));
+    repo.Create(MakeEncounter("enc-2", 2, 4096));
+    repo.Create(MakeEncounter("enc-big", 5, 64 * 1024));
+
+    REQUIRE(repo.Query(RangeFilters(0, 0), {}).size() == 1);
+    REQUIRE(repo.Query(RangeFilters(1, 1), {}).size() == 1);
+    REQUIRE(repo.Query(RangeFilters(2, 2), {}).size() == 1);
+    REQUIRE(repo.stats().evictions == 1);
+    REQUIRE(repo.stats().bytes <= options.maxBytes);
+
+    // Day 0 was evicted; day 2 is still cached.
+    const auto calls = backing.queryCalls;
+    REQUIRE(repo.Query(RangeFilters(2, 2), {}).size() == 1);
+    REQUIRE(backing.queryCalls == calls);
+    REQUIRE(repo.Query(RangeFilters(0, 0), {}).size() == 1);
+    REQUIRE(backing.queryCalls == calls + 1);
+
+    // A result larger than the whole budget is returned but never cached.
+    const auto entries = repo.stats().entries;
+    REQUIRE(repo.Query(RangeFilters(5, 5), {}).size() == 1);
+    REQUIRE(repo.stats().entries == entries);
+}
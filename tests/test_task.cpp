@@ -0,0 +1,89 @@
+#include "tests/catch_compat.h"
+
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "src/util/executor.h"
+#include "src/util/task.h"
+
+namespace {
+
+encounter_service::util::Task<int> Add(int a, int b) {
+    co_return a + b;
+}
+
+encounter_service::util::Task<int> AddTwice(int a, int b) {
+    const auto first = co_await Add(a, b);
+    co_return first + co_await Add(a, b);
+}
+
+encounter_service::util::Task<> Fail() {
+    throw std::runtime_error("boom");
+    co_return;
+}
+
+encounter_service::util::Task<int> AwaitMovedFrom() {
+    auto task = Add(1, 2);
+    auto owner = std::move(task);
+    co_return co_await std::move(task);
+}
+
+encounter_service::util::Task<std::thread::id> ThreadAfterSchedule(encounter_service::util::Executor& executor) {
+    co_await encounter_service::util::Schedule(executor);
+    co_return std::this_thread::get_id();
+}
+
+// Runs each posted item on its own thread; joined on destruction.
+class ThreadPerTaskExecutor final : public encounter_service::util::Executor {
+public:
+    ~ThreadPerTaskExecutor() override {
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    void Post(std::function<void()> work) override {
+        threads_.emplace_back(std::move(work));
+    }
+
+private:
+    std::vector<std::thread> threads_;
+};
+
+}  // namespace
+
+TEST_CASE("Task composes nested awaits and SyncWait returns the result") {
+    REQUIRE(encounter_service::util::SyncWait(AddTwice(2, 3)) == 10);
+}
+
+TEST_CASE("Task propagates exceptions to the awaiting caller") {
+    bool caught = false;
+    try {
+        encounter_service::util::SyncWait(Fail());
+    } catch (const std::runtime_error& error) {
+        caught = std::string(error.what()) == "boom";
+    }
+    REQUIRE(caught);
+}
+
+TEST_CASE("Awaiting an empty Task throws instead of reading a null frame") {
+    bool caught = false;
+    try {
+        encounter_service::util::SyncWait(AwaitMovedFrom());
+    } catch (const std::logic_error&) {
+        caught = true;
+    }
+    REQUIRE(caught);
+}
+
+TEST_CASE("Schedule resumes the coroutine on the given executor") {
+    encounter_service::util::InlineExecutor inlineExecutor;
+    REQUIRE(encounter_service::util::SyncWait(ThreadAfterSchedule(inlineExecutor)) == std::this_thread::get_id());
+
+    ThreadPerTaskExecutor threadExecutor;
+    REQUIRE(encounter_service::util::SyncWait(ThreadAfterSchedule(threadExecutor)) != std::this_thread::get_id());
+}
@@ -1,6 +1,7 @@
 #include "tests/catch_compat.h"
 
 #include <chrono>
+#include <string>
 
 #include "src/util/time.h"
 
@@ -36,3 +37,15 @@ TEST_CASE("FormatIso8601Utc round-trips parsed value") {
     REQUIRE(parsed.has_value());
     REQUIRE(encounter_service::util::FormatIso8601Utc(*parsed) == formatted);
 }
+
+TEST_CASE("FormatIso8601UtcTo matches FormatIso8601Utc") {
+    using namespace std::chrono;
+    for (const auto value : {system_clock::time_point{},
+                             system_clock::time_point{seconds{951782400}},  // 2000-02-29
+                             system_clock::time_point{seconds{1700000000} + milliseconds{999}},
+                             system_clock::time_point{seconds{4102444799}}}) {
+        char buffer[encounter_service::util::kIso8601UtcLength];
+        encounter_service::util::FormatIso8601UtcTo(value, buffer);
+        REQUIRE(std::string(buffer, sizeof(buffer)) == encounter_service::util::FormatIso8601Utc(value));
+    }
+}
@@ -1,6 +1,8 @@
 #include "tests/catch_compat.h"
 
 #include <chrono>
+#include <string>
+#include <vector>
 
 #include "src/http/validation.h"
 #include "src/util/time.h"
@@ -13,7 +15,8 @@ void SetParam(httplib::Request& request, const std::string& key, const std::stri
 
 }  // namespace
 
-TEST_CASE("ValidateCreateEncounterRequest parses valid payload") {
+TEST_CASE("ParseCreateEncounterRequest parses valid payload") {
+#if __has_include("vendor/json.hpp")
     nlohmann::json body = nlohmann::json::object();
     body["patientId"] = "patient-1";
     body["providerId"] = "provider-1";
@@ -21,18 +24,20 @@ TEST_CASE("ValidateCreateEncounterRequest parses valid payload") {
     body["encounterDate"] = "2026-02-25T00:00:00Z";
     body["clinicalData"] = nlohmann::json::object();
 
-    const auto result = encounter_service::http::ValidateCreateEncounterRequest(body);
+    const auto result = encounter_service::http::ParseCreateEncounterRequest(body.dump());
     REQUIRE(result.index() == 0);
 
     const auto parsed = encounter_service::util::ParseIso8601Utc("2026-02-25T00:00:00Z");
     REQUIRE(parsed.has_value());
     REQUIRE(std::get<encounter_service::domain::CreateEncounterInput>(result).encounterDate == *parsed);
+#endif
 }
 
-TEST_CASE("ValidateCreateEncounterRequest requires body object") {
+TEST_CASE("ParseCreateEncounterRequest requires body object") {
+#if __has_include("vendor/json.hpp")
     nlohmann::json body;
 
-    const auto result = encounter_service::http::ValidateCreateEncounterRequest(body);
+    const auto result = encounter_service::http::ParseCreateEncounterRequest(body.dump());
     REQUIRE(result.index() == 1);
 
     const auto error = std::get<encounter_service::domain::DomainError>(result);
@@ -40,61 +45,71 @@ TEST_CASE("ValidateCreateEncounterRequest requires body object") {
     REQUIRE(error.details.has_value());
     REQUIRE(error.details->size() == 1);
     REQUIRE((*error.details)[0].path == "body");
+#endif
 }
 
-TEST_CASE("ValidateCreateEncounterRequest requires patientId") {
+TEST_CASE("ParseCreateEncounterRequest requires patientId") {
+#if __has_include("vendor/json.hpp")
     nlohmann::json body = nlohmann::json::object();
     body["providerId"] = "provider-1";
     body["encounterType"] = "visit";
     body["encounterDate"] = "2026-02-25";
     body["clinicalData"] = nlohmann::json::object();
 
-    const auto result = encounter_service::http::ValidateCreateEncounterRequest(body);
+    const auto result = encounter_service::http::ParseCreateEncounterRequest(body.dump());
     REQUIRE(result.index() == 1);
 
     const auto error = std::get<encounter_service::domain::DomainError>(result);
     REQUIRE(error.code == encounter_service::domain::DomainErrorCode::Validation);
     REQUIRE(error.details.has_value());
     REQUIRE((*error.details)[0].path == "patientId");
+#endif
 }
 
-TEST_CASE("ValidateCreateEncounterRequest requires providerId") {
+TEST_CASE("ParseCreateEncounterRequest requires providerId") {
+#if __has_include("vendor/json.hpp")
     nlohmann::json body = nlohmann::json::object();
     body["patientId"] = "patient-1";
     body["encounterType"] = "visit";
     body["encounterDate"] = "2026-02-25";
     body["clinicalData"] = nlohmann::json::object();
 
-    const auto result = encounter_service::http::ValidateCreateEncounterRequest(body);
+    const auto result = encounter_service::http::ParseCreateEncounterRequest(body.dump());
     REQUIRE(result.index() == 1);
     REQUIRE(std::get<encounter_service::domain::DomainError>(result).details->at(0).path == "providerId");
+#endif
 }
 
-TEST_CASE("ValidateCreateEncounterRequest requires encounterType") {
+TEST_CASE("ParseCreateEncounterRequest requires encounterType") {
+#if __has_include("vendor/json.hpp")
     nlohmann::json body = nlohmann::json::object();
     body["patientId"] = "patient-1";
     body["providerId"] = "provider-1";
     body["encounterDate"] = "2026-02-25";
     body["clinicalData"] = nlohmann::json::object();
 
-    const auto result = encounter_service::http::ValidateCreateEncounterRequest(body);
+    const auto result = encounter_service::http::ParseCreateEncounterRequest(body.dump());
     REQUIRE(result.index() == 1);
     REQUIRE(std::get<encounter_service::domain::DomainError>(result).details->at(0).path == "encounterType");
+#endif
 }
 
-TEST_CASE("ValidateCreateEncounterRequest requires clinicalData") {
+TEST_CASE("ParseCreateEncounterRequest requires clinicalData") {
+#if __has_include("vendor/json.hpp")
     nlohmann::json body = nlohmann::json::object();
     body["patientId"] = "patient-1";
     body["providerId"] = "provider-1";
     body["encounterType"] = "visit";
     body["encounterDate"] = "2026-02-25";
 
-    const auto result = encounter_service::http::ValidateCreateEncounterRequest(body);
+    const auto result = encounter_service::http::ParseCreateEncounterRequest(body.dump());
     REQUIRE(result.index() == 1);
     REQUIRE(std::get<encounter_service::domain::DomainError>(result).details->at(0).path == "clinicalData");
+#endif
 }
 
-TEST_CASE("ValidateCreateEncounterRequest validates patientId type") {
+TEST_CASE("ParseCreateEncounterRequest validates patientId type") {
+#if __has_include("vendor/json.hpp")
     nlohmann::json body = nlohmann::json::object();
     body["patientId"] = nlohmann::json::object();
     body["providerId"] = "provider-1";
@@ -102,15 +117,17 @@ TEST_CASE("ValidateCreateEncounterRequest validates patientId type") {
     body["encounterDate"] = "2026-02-25";
     body["clinicalData"] = nlohmann::json::object();
 
-    const auto result = encounter_service::http::ValidateCreateEncounterRequest(body);
+    const auto result = encounter_service::http::ParseCreateEncounterRequest(body.dump());
     REQUIRE(result.index() == 1);
 
     const auto error = std::get<encounter_service::domain::DomainError>(result);
     REQUIRE(error.details->at(0).path == "patientId");
     REQUIRE(error.details->at(0).message == "must be a string");
+#endif
 }
 
-TEST_CASE("ValidateCreateEncounterRequest validates providerId type") {
+TEST_CASE("ParseCreateEncounterRequest validates providerId type") {
+#if __has_include("vendor/json.hpp")
     nlohmann::json body = nlohmann::json::object();
     body["patientId"] = "patient-1";
     body["providerId"] = nlohmann::json::object();
@@ -118,14 +135,16 @@ TEST_CASE("ValidateCreateEncounterRequest validates providerId type") {
     body["encounterDate"] = "2026-02-25";
     body["clinicalData"] = nlohmann::json::object();
 
-    const auto result = encounter_service::http::ValidateCreateEncounterRequest(body);
+    const auto result = encounter_service::http::ParseCreateEncounterRequest(body.dump());
     REQUIRE(result.index() == 1);
     const auto error = std::get<encounter_service::domain::DomainError>(result);
     REQUIRE(error.details->at(0).path == "providerId");
     REQUIRE(error.details->at(0).message == "must be a string");
+#endif
 }
 
-TEST_CASE("ValidateCreateEncounterRequest validates encounterType type") {
+TEST_CASE("ParseCreateEncounterRequest validates encounterType type") {
+#if __has_include("vendor/json.hpp")
     nlohmann::json body = nlohmann::json::object();
     body["patientId"] = "patient-1";
     body["providerId"] = "provider-1";
@@ -133,14 +152,16 @@ TEST_CASE("ValidateCreateEncounterRequest validates encounterType type") {
     body["encounterDate"] = "2026-02-25";
     body["clinicalData"] = nlohmann::json::object();
 
-    const auto result = encounter_service::http::ValidateCreateEncounterRequest(body);
+    const auto result = encounter_service::http::ParseCreateEncounterRequest(body.dump());
     REQUIRE(result.index() == 1);
     const auto error = std::get<encounter_service::domain::DomainError>(result);
     REQUIRE(error.details->at(0).path == "encounterType");
     REQUIRE(error.details->at(0).message == "must be a string");
+#endif
 }
 
-TEST_CASE("ValidateCreateEncounterRequest validates encounterDate type") {
+TEST_CASE("ParseCreateEncounterRequest validates encounterDate type") {
+#if __has_include("vendor/json.hpp")
     nlohmann::json body = nlohmann::json::object();
     body["patientId"] = "patient-1";
     body["providerId"] = "provider-1";
@@ -148,14 +169,16 @@ TEST_CASE("ValidateCreateEncounterRequest validates encounterDate type") {
     body["encounterDate"] = nlohmann::json::object();
     body["clinicalData"] = nlohmann::json::object();
 
-    const auto result = encounter_service::http::ValidateCreateEncounterRequest(body);
+    const auto result = encounter_service::http::ParseCreateEncounterRequest(body.dump());
     REQUIRE(result.index() == 1);
     const auto error = std::get<encounter_service::domain::DomainError>(result);
     REQUIRE(error.details->at(0).path == "encounterDate");
     REQUIRE(error.details->at(0).message == "must be a string");
+#endif
 }
 
-TEST_CASE("ValidateCreateEncounterRequest validates encounterDate parse") {
+TEST_CASE("ParseCreateEncounterRequest validates encounterDate parse") {
+#if __has_include("vendor/json.hpp")
     nlohmann::json body = nlohmann::json::object();
     body["patientId"] = "patient-1";
     body["providerId"] = "provider-1";
@@ -163,16 +186,18 @@ TEST_CASE("ValidateCreateEncounterRequest validates encounterDate parse") {
     body["encounterDate"] = "not-a-date";
     body["clinicalData"] = nlohmann::json::object();
 
-    const auto result = encounter_service::http::ValidateCreateEncounterRequest(body);
+    const auto result = encounter_service::http::ParseCreateEncounterRequest(body.dump());
     REQUIRE(result.index() == 1);
 
     const auto error = std::get<encounter_service::domain::DomainError>(result);
     REQUIRE(error.code == encounter_service::domain::DomainErrorCode::Validation);
     REQUIRE(error.details.has_value());
     REQUIRE(error.details->at(0).path == "encounterDate");
+#endif
 }
 
-TEST_CASE("ValidateCreateEncounterRequest accepts date only encounterDate") {
+TEST_CASE("ParseCreateEncounterRequest accepts date only encounterDate") {
+#if __has_include("vendor/json.hpp")
     nlohmann::json body = nlohmann::json::object();
     body["patientId"] = "patient-1";
     body["providerId"] = "provider-1";
@@ -180,11 +205,13 @@ TEST_CASE("ValidateCreateEncounterRequest accepts date only encounterDate") {
     body["encounterDate"] = "2026-02-25";
     body["clinicalData"] = nlohmann::json::object();
 
-    const auto result = encounter_service::http::ValidateCreateEncounterRequest(body);
+    const auto result = encounter_service::http::ParseCreateEncounterRequest(body.dump());
     REQUIRE(result.index() == 0);
+#endif
 }
 
-TEST_CASE("ValidateCreateEncounterRequest validates clinicalData type") {
+TEST_CASE("ParseCreateEncounterRequest validates clinicalData type") {
+#if __has_include("vendor/json.hpp")
     nlohmann::json body = nlohmann::json::object();
     body["patientId"] = "patient-1";
     body["providerId"] = "provider-1";
@@ -192,12 +219,56 @@ TEST_CASE("ValidateCreateEncounterRequest validates clinicalData type") {
     body["encounterDate"] = "2026-02-25";
     body["clinicalData"] = "not-an-object";
 
-    const auto result = encounter_service::http::ValidateCreateEncounterRequest(body);
+    const auto result = encounter_service::http::ParseCreateEncounterRequest(body.dump());
     REQUIRE(result.index() == 1);
     const auto error = std::get<encounter_service::domain::DomainError>(result);
     REQUIRE(error.details.has_value());
     REQUIRE(error.details->at(0).path == "clinicalData");
     REQUIRE(error.details->at(0).message == "must be an object");
+#endif
+}
+
+TEST_CASE("ValidateBatchGetRequest parses ids in order") {
+    nlohmann::json body = nlohmann::json::object();
+    nlohmann::json ids = nlohmann::json::array();
+    ids.push_back("enc-2");
+    ids.push_back("enc-1");
+    body["ids"] = ids;
+
+    const auto result = encounter_service::http::ValidateBatchGetRequest(body);
+    REQUIRE(result.index() == 0);
+    const auto& parsed = std::get<std::vector<std::string>>(result);
+    REQUIRE(parsed.size() == 2);
+    REQUIRE(parsed[0] == "enc-2");
+    REQUIRE(parsed[1] == "enc-1");
+}
+
+TEST_CASE("ValidateBatchGetRequest rejects missing, empty, oversized and non-string ids") {
+    nlohmann::json missing = nlohmann::json::object();
+    const auto missingResult = encounter_service::http::ValidateBatchGetRequest(missing);
+    REQUIRE(missingResult.index() == 1);
+    REQUIRE((*std::get<encounter_service::domain::DomainError>(missingResult).details)[0].path == "ids");
+
+    nlohmann::json empty = nlohmann::json::object();
+    empty["ids"] = nlohmann::json::array();
+    REQUIRE(encounter_service::http::ValidateBatchGetRequest(empty).index() == 1);
+
+    nlohmann::json oversized = nlohmann::json::object();
+    nlohmann::json many = nlohmann::json::array();
+    for (std::size_t i = 0; i <= encounter_service::http::kMaxBatchGetIds; ++i) {
+        many.push_back("enc-" + std::to_string(i));
+    }
+    oversized["ids"] = many;
+    REQUIRE(encounter_service::http::ValidateBatchGetRequest(oversized).index() == 1);
+
+    nlohmann::json wrongType = nlohmann::json::object();
+    nlohmann::json mixed = nlohmann::json::array();
+    mixed.push_back("enc-1");
+    mixed.push_back(nlohmann::json::object());
+    wrongType["ids"] = mixed;
+    const auto wrongTypeResult = encounter_service::http::ValidateBatchGetRequest(wrongType);
+    REQUIRE(wrongTypeResult.index() == 1);
+    REQUIRE((*std::get<encounter_service::domain::DomainError>(wrongTypeResult).details)[0].path == "ids[1]");
 }
 
 TEST_CASE("ValidateEncounterQuery parses from and to timestamps") {
@@ -340,3 +411,89 @@ TEST_CASE("ValidateAuditQuery returns validation error for empty to") {
     REQUIRE(result.index() == 1);
     REQUIRE(std::get<encounter_service::domain::DomainError>(result).details->at(0).path == "to");
 }
+
+TEST_CASE("ParseCreateEncounterRequest builds input in one pass and skips unknown members") {
+#if __has_include("vendor/json.hpp")
+    const std::string body =
+        "{\"extra\":{\"nested\":[1,{\"x\":null}]},\"patientId\":\"patient-\\\"1\\\"\",\"providerId\":\"provider-1\","
+        "\"clinicalData\":{\"notes\":\"stable\",\"vitals\":{\"bp\":[120,80],\"temp\":36.6,\"ok\":true}},"
+        "\"encounterType\":\"visit\",\"encounterDate\":\"2026-02-25T00:00:00Z\",\"tags\":[\"a\"]}";
+
+    auto result = encounter_service::http::ParseCreateEncounterRequest(body);
+    REQUIRE(result.index() == 0);
+    const auto& input = std::get<encounter_service::domain::CreateEncounterInput>(result);
+    REQUIRE(input.patientId == "patient-\"1\"");
+    REQUIRE(input.providerId == "provider-1");
+    REQUIRE(input.encounterType == "visit");
+    REQUIRE(input.encounterDate == *encounter_service::util::ParseIso8601Utc("2026-02-25T00:00:00Z"));
+    REQUIRE(input.clinicalData == nlohmann::json::parse(body)["clinicalData"]);
+#endif
+}
+
+TEST_CASE("ParseCreateEncounterRequest stops at the first offending member") {
+#if __has_include("vendor/json.hpp")
+    using encounter_service::http::ParseCreateEncounterRequest;
+    // The trailing bytes are never reached: the type or date error is reported instead of bad JSON.
+    const auto wrongType = ParseCreateEncounterRequest("{\"patientId\":5, this is not JSON");
+    REQUIRE(wrongType.index() == 1);
+    const auto wrongTypeError = std::get<encounter_service::domain::DomainError>(wrongType).details->at(0);
+    REQUIRE(wrongTypeError.path == "patientId");
+    REQUIRE(wrongTypeError.message == "must be a string");
+
+    const auto badDate = ParseCreateEncounterRequest("{\"encounterDate\":\"yesterday\"");
+    REQUIRE(badDate.index() == 1);
+    REQUIRE(std::get<encounter_service::domain::DomainError>(badDate).details->at(0).path == "encounterDate");
+
+    const auto listData = ParseCreateEncounterRequest("{\"clinicalData\":[]}");
+    REQUIRE(listData.index() == 1);
+    const auto listDataError = std::get<encounter_service::domain::DomainError>(listData).details->at(0);
+    REQUIRE(listDataError.path == "clinicalData");
+    REQUIRE(listDataError.message == "must be an object");
+
+    const auto notObject = ParseCreateEncounterRequest("[{\"patientId\":\"p\"}]");
+    REQUIRE(notObject.index() == 1);
+    REQUIRE(std::get<encounter_service::domain::DomainError>(notObject).details->at(0).message ==
+            "must be a JSON object");
+
+    const auto malformed = ParseCreateEncounterRequest("{\"patientId\":\"p\",}");
+    REQUIRE(malformed.index() == 1);
+    REQUIRE(std::get<encounter_service::domain::DomainError>(malformed).details->at(0).message ==
+            "must be valid JSON");
+#endif
+}
+
+TEST_CASE("ParseCreateEncounterRequest reports missing members in validation order") {
+#if __has_include("vendor/json.hpp")
+    const auto result = encounter_service::http::ParseCreateEncounterRequest(
+        "{\"encounterDate\":\"2026-02-25\",\"providerId\":\"provider-1\",\"clinicalData\":{}}");
+    REQUIRE(result.index() == 1);
+    const auto error = std::get<encounter_service::domain::DomainError>(result);
+    REQUIRE(error.code == encounter_service::domain::DomainErrorCode::Validation);
+    REQUIRE(error.details->at(0).path == "patientId");
+    REQUIRE(error.details->at(0).message == "is required");
+#endif
+}
+
+TEST_CASE("ParseCreateEncounterRequest enforces body size and nesting limits") {
+    encounter_service::http::CreateRequestLimits limits{};
+    limits.maxBodyBytes = 64;
+    limits.maxDepth = 3;
+
+    const auto tooLarge = encounter_service::http::ParseCreateEncounterRequest(std::string(65, ' '), limits);
+    REQUIRE(tooLarge.index() == 1);
+    REQUIRE(std::get<encounter_service::domain::DomainError>(tooLarge).code ==
+            encounter_service::domain::DomainErrorCode::PayloadTooLarge);
+
+#if __has_include("vendor/json.hpp")
+    const auto withinDepth =
+        encounter_service::http::ParseCreateEncounterRequest("{\"clinicalData\":{\"a\":{}}}", limits);
+    REQUIRE(std::get<encounter_service::domain::DomainError>(withinDepth).details->at(0).path == "patientId");
+
+    // Unknown members count toward the depth too, and the check fires before the closing brackets.
+    const auto tooDeep = encounter_service::http::ParseCreateEncounterRequest("{\"x\":[[[[", limits);
+    REQUIRE(tooDeep.index() == 1);
+    const auto tooDeepError = std::get<encounter_service::domain::DomainError>(tooDeep).details->at(0);
+    REQUIRE(tooDeepError.path == "body");
+    REQUIRE(tooDeepError.message == "must not nest deeper than 3 levels");
+#endif
+}
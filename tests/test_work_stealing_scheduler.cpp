@@ -0,0 +1,85 @@
+#include "tests/catch_compat.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "src/http/scheduler_task_queue.h"
+#include "src/util/work_stealing_scheduler.h"
+
+TEST_CASE("WorkStealingScheduler runs every submitted task before shutdown returns") {
+    std::atomic<int> ran{0};
+    encounter_service::util::WorkStealingScheduler scheduler({.threadCount = 4, .pinThreads = false});
+    for (int i = 0; i < 1000; ++i) {
+        REQUIRE(scheduler.TrySubmit([&ran]() { ran.fetch_add(1); }));
+    }
+    scheduler.Shutdown();
+
+    REQUIRE(ran.load() == 1000);
+    const auto stats = scheduler.stats();
+    REQUIRE(stats.threads == 4);
+    REQUIRE(stats.executed == 1000);
+    REQUIRE(stats.queueDepth == 0);
+    REQUIRE(stats.maxWait >= std::chrono::nanoseconds{0});
+    REQUIRE(stats.totalWait >= stats.maxWait);
+
+    // After shutdown, TrySubmit refuses work and Post runs it inline.
+    REQUIRE(!scheduler.TrySubmit([&ran]() { ran.fetch_add(1); }));
+    scheduler.Post([&ran]() { ran.fetch_add(1); });
+    REQUIRE(ran.load() == 1001);
+}
+
+TEST_CASE("WorkStealingScheduler lets idle workers steal work queued on a busy worker") {
+    encounter_service::util::WorkStealingScheduler scheduler({.threadCount = 2, .pinThreads = false});
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool release = false;
+    std::atomic<int> ran{0};
+
+    // The outer task occupies one worker; the tasks it submits land on that worker's own deque,
+    // so the only way they can finish before it is released is by being stolen.
+    REQUIRE(scheduler.TrySubmit([&]() {
+        for (int i = 0; i < 8; ++i) {
+            REQUIRE(scheduler.TrySubmit([&ran]() { ran.fetch_add(1); }));
+        }
+        std::unique_lock lock(mutex);
+        cv.wait(lock, [&]() { return release; });
+    }));
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+    while (ran.load() < 8 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    {
+        std::lock_guard lock(mutex);
+        release = true;
+    }
+    cv.notify_all();
+    scheduler.Shutdown();
+
+    REQUIRE(ran.load() == 8);
+    REQUIRE(scheduler.stats().stolen >= 8);
+}
+
+TEST_CASE("SchedulerTaskQueue shutdown waits for its own tasks and leaves the scheduler running") {
+    encounter_service::util::WorkStealingScheduler scheduler({.threadCount = 2, .pinThreads = false});
+    std::atomic<int> ran{0};
+    {
+        encounter_service::http::SchedulerTaskQueue queue(scheduler);
+        for (int i = 0; i < 20; ++i) {
+            REQUIRE(queue.enqueue([&ran]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                ran.fetch_add(1);
+            }));
+        }
+        queue.shutdown();
+        REQUIRE(ran.load() == 20);
+        REQUIRE(!queue.enqueue([]() {}));
+    }
+
+    REQUIRE(scheduler.TrySubmit([&ran]() { ran.fetch_add(1); }));
+    scheduler.Shutdown();
+    REQUIRE(ran.load() == 21);
+}